@@ -18,7 +18,10 @@
 //==============================================================================
 
 #include <backend/BackendInterface.h>
+#include <backend/CachePage.h>
 #include <log/Logger.h>
+#include <util/Coroutine.h>
+#include <util/WorkCost.h>
 
 #include <ripple/protocol/Indexes.h>
 #include <ripple/protocol/STLedgerEntry.h>
@@ -90,6 +93,7 @@ BackendInterface::fetchLedgerObject(
     else
     {
         gLog.trace() << "Cache miss - " << ripple::strHex(key);
+        util::WorkCost::recordCacheMisses(1);
         auto dbObj = doFetchLedgerObject(key, sequence, yield);
         if (!dbObj)
             gLog.trace() << "Missed cache and missed in db";
@@ -120,6 +124,7 @@ BackendInterface::fetchLedgerObjects(
 
     if (misses.size())
     {
+        util::WorkCost::recordCacheMisses(misses.size());
         auto objs = doFetchLedgerObjects(misses, sequence, yield);
         for (size_t i = 0, j = 0; i < results.size(); ++i)
         {
@@ -133,6 +138,101 @@ BackendInterface::fetchLedgerObjects(
 
     return results;
 }
+
+boost::asio::awaitable<std::optional<Blob>>
+BackendInterface::fetchLedgerObject(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::use_awaitable_t<> token) const
+{
+    if (auto obj = cache_.get(key, sequence); obj)
+    {
+        gLog.trace() << "Cache hit - " << ripple::strHex(key);
+        co_return *obj;
+    }
+
+    gLog.trace() << "Cache miss - " << ripple::strHex(key);
+    util::WorkCost::recordCacheMisses(1);
+    co_return co_await doFetchLedgerObject(key, sequence, token);
+}
+
+boost::asio::awaitable<std::vector<Blob>>
+BackendInterface::fetchLedgerObjects(
+    std::vector<ripple::uint256> const& keys,
+    std::uint32_t const sequence,
+    boost::asio::use_awaitable_t<> token) const
+{
+    std::vector<Blob> results;
+    results.resize(keys.size());
+    std::vector<ripple::uint256> misses;
+    for (size_t i = 0; i < keys.size(); ++i)
+    {
+        auto obj = cache_.get(keys[i], sequence);
+        if (obj)
+            results[i] = *obj;
+        else
+            misses.push_back(keys[i]);
+    }
+    gLog.trace() << "Cache hits = " << keys.size() - misses.size() << " - cache misses = " << misses.size();
+
+    if (misses.size())
+    {
+        util::WorkCost::recordCacheMisses(misses.size());
+        auto objs = co_await doFetchLedgerObjects(misses, sequence, token);
+        for (size_t i = 0, j = 0; i < results.size(); ++i)
+        {
+            if (results[i].size() == 0)
+            {
+                results[i] = objs[j];
+                ++j;
+            }
+        }
+    }
+
+    co_return results;
+}
+
+boost::asio::awaitable<std::optional<Blob>>
+BackendInterface::doFetchLedgerObject(
+    ripple::uint256 const& key,
+    std::uint32_t const sequence,
+    boost::asio::use_awaitable_t<>) const
+{
+    co_return co_await util::awaitStackful(
+        [&](boost::asio::yield_context& yield) { return doFetchLedgerObject(key, sequence, yield); });
+}
+
+boost::asio::awaitable<std::vector<Blob>>
+BackendInterface::doFetchLedgerObjects(
+    std::vector<ripple::uint256> const& keys,
+    std::uint32_t const sequence,
+    boost::asio::use_awaitable_t<>) const
+{
+    co_return co_await util::awaitStackful(
+        [&](boost::asio::yield_context& yield) { return doFetchLedgerObjects(keys, sequence, yield); });
+}
+
+boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+BackendInterface::fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::use_awaitable_t<>) const
+{
+    co_return co_await util::awaitStackful(
+        [&](boost::asio::yield_context& yield) { return fetchLedgerBySequence(sequence, yield); });
+}
+
+boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+BackendInterface::fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::use_awaitable_t<>) const
+{
+    co_return co_await util::awaitStackful(
+        [&](boost::asio::yield_context& yield) { return fetchLedgerByHash(hash, yield); });
+}
+
+boost::asio::awaitable<std::optional<TransactionAndMetadata>>
+BackendInterface::fetchTransaction(ripple::uint256 const& hash, boost::asio::use_awaitable_t<>) const
+{
+    co_return co_await util::awaitStackful(
+        [&](boost::asio::yield_context& yield) { return fetchTransaction(hash, yield); });
+}
+
 // Fetches the successor to key/index
 std::optional<ripple::uint256>
 BackendInterface::fetchSuccessorKey(
@@ -142,9 +242,14 @@ BackendInterface::fetchSuccessorKey(
 {
     auto succ = cache_.getSuccessor(key, ledgerSequence);
     if (succ)
+    {
         gLog.trace() << "Cache hit - " << ripple::strHex(key);
+    }
     else
+    {
         gLog.trace() << "Cache miss - " << ripple::strHex(key);
+        util::WorkCost::recordCacheMisses(1);
+    }
     return succ ? succ->key : doFetchSuccessorKey(key, ledgerSequence, yield);
 }
 
@@ -288,21 +393,84 @@ BackendInterface::fetchLedgerPage(
     return page;
 }
 
-std::optional<ripple::Fees>
-BackendInterface::fetchFees(std::uint32_t const seq, boost::asio::yield_context& yield) const
+LedgerPage
+BackendInterface::fetchLedgerPage(
+    ripple::uint256 const& from,
+    std::optional<ripple::uint256> const& to,
+    std::size_t maxBytes,
+    std::uint32_t const ledgerSequence,
+    boost::asio::yield_context& yield) const
 {
-    ripple::Fees fees;
+    // keys looked up before their objects are fetched together
+    static constexpr std::size_t BATCH_SIZE = 256;
 
-    auto key = ripple::keylet::fees().key;
-    auto bytes = fetchLedgerObject(key, seq, yield);
+    LedgerPage page;
+    if (to && *to <= from)
+        return page;
 
-    if (!bytes)
+    // the successor of the key before from, so that from itself is included
+    auto cursor = from;
+    if (cursor != firstKey)
+        --cursor;
+
+    std::size_t bytes = 0;
+    auto reachedEnd = false;
+    while (!reachedEnd)
     {
-        gLog.error() << "Could not find fees";
-        return {};
+        std::vector<ripple::uint256> keys;
+        while (keys.size() < BATCH_SIZE)
+        {
+            auto const succ = fetchSuccessorKey(cursor, ledgerSequence, yield);
+            if (!succ || (to && *succ >= *to))
+            {
+                reachedEnd = true;
+                break;
+            }
+
+            cursor = *succ;
+            keys.push_back(*succ);
+        }
+
+        if (keys.empty())
+            break;
+
+        auto objects = fetchLedgerObjects(keys, ledgerSequence, yield);
+        for (std::size_t i = 0; i < keys.size(); ++i)
+        {
+            if (objects[i].empty())
+                continue;
+
+            auto const frameBytes = CachePage::frameSize(objects[i].size());
+            if (!page.objects.empty() && bytes + frameBytes > maxBytes)
+            {
+                page.cursor = keys[i];
+                return page;
+            }
+
+            bytes += frameBytes;
+            page.objects.push_back({keys[i], std::move(objects[i])});
+        }
+
+        // cut right after a batch: the next key, if any, is where to continue
+        if (!reachedEnd && bytes >= maxBytes)
+        {
+            if (auto const succ = fetchSuccessorKey(cursor, ledgerSequence, yield); succ && (!to || *succ < *to))
+                page.cursor = *succ;
+            return page;
+        }
     }
 
-    ripple::SerialIter it(bytes->data(), bytes->size());
+    return page;
+}
+
+namespace {
+
+ripple::Fees
+feesFromBlob(ripple::uint256 const& key, Blob const& bytes)
+{
+    ripple::Fees fees;
+
+    ripple::SerialIter it(bytes.data(), bytes.size());
     ripple::SLE sle{it, key};
 
     if (sle.getFieldIndex(ripple::sfBaseFee) != -1)
@@ -320,4 +488,32 @@ BackendInterface::fetchFees(std::uint32_t const seq, boost::asio::yield_context&
     return fees;
 }
 
+}  // namespace
+
+std::optional<ripple::Fees>
+BackendInterface::fetchFees(std::uint32_t const seq, boost::asio::yield_context& yield) const
+{
+    auto key = ripple::keylet::fees().key;
+    auto bytes = fetchLedgerObject(key, seq, yield);
+
+    if (!bytes)
+    {
+        gLog.error() << "Could not find fees";
+        return {};
+    }
+
+    return feesFromBlob(key, *bytes);
+}
+
+std::optional<ripple::Fees>
+BackendInterface::fetchFeesFromCache(std::uint32_t const seq) const
+{
+    auto const key = ripple::keylet::fees().key;
+    auto const bytes = cache_.get(key, seq);
+    if (!bytes)
+        return {};
+
+    return feesFromBlob(key, *bytes);
+}
+
 }  // namespace Backend
@@ -26,7 +26,9 @@
 #include <config/Config.h>
 #include <log/Logger.h>
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/json.hpp>
 
 #include <thread>
@@ -210,6 +212,19 @@ public:
     virtual std::optional<ripple::LedgerInfo>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context& yield) const = 0;
 
+    /**
+     * @brief C++20 coroutine version of fetchLedgerBySequence
+     *
+     * The C++20 coroutine versions of the read methods below default to running the stackful version on a stackful
+     * coroutine; backends override them to await the database directly.
+     */
+    virtual boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+    fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::use_awaitable_t<> token) const;
+
+    /*! @brief C++20 coroutine version of fetchLedgerByHash */
+    virtual boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+    fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::use_awaitable_t<> token) const;
+
     /*! @brief Fetches the latest ledger sequence. */
     virtual std::optional<std::uint32_t>
     fetchLatestLedgerSequence(boost::asio::yield_context& yield) const = 0;
@@ -251,6 +266,15 @@ public:
     std::optional<ripple::Fees>
     fetchFees(std::uint32_t const seq, boost::asio::yield_context& yield) const;
 
+    /**
+     * @brief Fetches the fees for a specific ledger sequence from the cache only.
+     *
+     * @param seq The ledger sequence to fetch for.
+     * @return std::optional<ripple::Fees> The fees; empty if they are not in the cache.
+     */
+    std::optional<ripple::Fees>
+    fetchFeesFromCache(std::uint32_t const seq) const;
+
     /*! @brief TRANSACTION METHODS */
     /**
      * @brief Fetches a specific transaction.
@@ -262,6 +286,10 @@ public:
     virtual std::optional<TransactionAndMetadata>
     fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context& yield) const = 0;
 
+    /*! @brief C++20 coroutine version of fetchTransaction */
+    virtual boost::asio::awaitable<std::optional<TransactionAndMetadata>>
+    fetchTransaction(ripple::uint256 const& hash, boost::asio::use_awaitable_t<> token) const;
+
     /**
      * @brief Fetches multiple transactions.
      *
@@ -371,6 +399,18 @@ public:
         std::uint32_t const sequence,
         boost::asio::yield_context& yield) const;
 
+    /*! @brief C++20 coroutine version of fetchLedgerObject */
+    boost::asio::awaitable<std::optional<Blob>>
+    fetchLedgerObject(ripple::uint256 const& key, std::uint32_t const sequence, boost::asio::use_awaitable_t<> token)
+        const;
+
+    /*! @brief C++20 coroutine version of fetchLedgerObjects */
+    boost::asio::awaitable<std::vector<Blob>>
+    fetchLedgerObjects(
+        std::vector<ripple::uint256> const& keys,
+        std::uint32_t const sequence,
+        boost::asio::use_awaitable_t<> token) const;
+
     /*! @brief Virtual function version of fetchLedgerObject */
     virtual std::optional<Blob>
     doFetchLedgerObject(ripple::uint256 const& key, std::uint32_t const sequence, boost::asio::yield_context& yield)
@@ -383,6 +423,18 @@ public:
         std::uint32_t const sequence,
         boost::asio::yield_context& yield) const = 0;
 
+    /*! @brief Virtual function version of the C++20 coroutine fetchLedgerObject */
+    virtual boost::asio::awaitable<std::optional<Blob>>
+    doFetchLedgerObject(ripple::uint256 const& key, std::uint32_t const sequence, boost::asio::use_awaitable_t<> token)
+        const;
+
+    /*! @brief Virtual function version of the C++20 coroutine fetchLedgerObjects */
+    virtual boost::asio::awaitable<std::vector<Blob>>
+    doFetchLedgerObjects(
+        std::vector<ripple::uint256> const& keys,
+        std::uint32_t const sequence,
+        boost::asio::use_awaitable_t<> token) const;
+
     /**
      * @brief Returns the difference between ledgers: vector of objects
      *
@@ -414,6 +466,28 @@ public:
         bool outOfOrder,
         boost::asio::yield_context& yield) const;
 
+    /**
+     * @brief Fetches the objects of a ledger whose keys are in [from, to), like LedgerCache::getPage
+     *
+     * Unlike the cache, the database can read any ledger in its range, so the pages of one ledger stay consistent
+     * however long it takes to read all of them.
+     *
+     * @param from The first key to include
+     * @param to The key to stop before; the end of the ledger if not set
+     * @param maxBytes Size the frames of the page (see CachePage) may not go over, unless the page would be empty; the
+     * cursor of a page that is cut is the first key not included
+     * @param ledgerSequence The ledger to read
+     * @param yield Currently executing coroutine.
+     * @return LedgerPage
+     */
+    LedgerPage
+    fetchLedgerPage(
+        ripple::uint256 const& from,
+        std::optional<ripple::uint256> const& to,
+        std::size_t maxBytes,
+        std::uint32_t const ledgerSequence,
+        boost::asio::yield_context& yield) const;
+
     /*! @brief Fetches successor object from key/index. */
     std::optional<LedgerObject>
     fetchSuccessorObject(ripple::uint256 key, std::uint32_t const ledgerSequence, boost::asio::yield_context& yield)
@@ -0,0 +1,185 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <backend/CachePage.h>
+#include <util/BinaryUtils.h>
+
+#include <ripple/basics/strHex.h>
+
+#include <boost/algorithm/string.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <cstring>
+#include <vector>
+
+namespace Backend::CachePage {
+
+namespace {
+
+using util::checksum;
+using util::getUInt32;
+using util::putUInt32;
+
+constexpr std::size_t KEY_SIZE = ripple::uint256::size();
+
+void
+putKey(std::string& out, ripple::uint256 const& key)
+{
+    out.append(reinterpret_cast<char const*>(key.data()), KEY_SIZE);
+}
+
+ripple::uint256
+getKey(std::string_view data, std::size_t offset)
+{
+    ripple::uint256 key;
+    std::memcpy(key.data(), data.data() + offset, KEY_SIZE);
+    return key;
+}
+
+}  // namespace
+
+std::string
+Request::target() const
+{
+    auto target = std::string{TARGET} + "?ledger=" + std::to_string(ledgerSequence) + "&from=" + ripple::strHex(from);
+    if (to)
+        target += "&to=" + ripple::strHex(*to);
+    return target;
+}
+
+std::optional<Request>
+Request::parse(std::string_view target)
+{
+    if (not target.starts_with(TARGET))
+        return {};
+
+    auto query = target.substr(TARGET.size());
+    if (query.empty() or query.front() != '?')
+        return {};
+    query.remove_prefix(1);
+
+    std::vector<std::string> params;
+    boost::split(params, query, boost::is_any_of("&"));
+
+    Request request;
+    bool hasLedger = false;
+    bool hasFrom = false;
+    for (auto const& param : params)
+    {
+        auto const pos = param.find('=');
+        if (pos == std::string::npos)
+            return {};
+
+        auto const name = std::string_view{param}.substr(0, pos);
+        auto const value = std::string_view{param}.substr(pos + 1);
+        if (name == "ledger")
+        {
+            auto const [end, ec] = std::from_chars(value.data(), value.data() + value.size(), request.ledgerSequence);
+            if (ec != std::errc{} or end != value.data() + value.size())
+                return {};
+            hasLedger = true;
+        }
+        else if (name == "from")
+        {
+            if (not request.from.parseHex(value))
+                return {};
+            hasFrom = true;
+        }
+        else if (name == "to")
+        {
+            request.to.emplace();
+            if (not request.to->parseHex(value))
+                return {};
+        }
+    }
+
+    if (not hasLedger or not hasFrom)
+        return {};
+    return request;
+}
+
+std::string
+serialize(LedgerPage const& page, std::uint32_t ledgerSequence)
+{
+    std::size_t size = TRAILER_SIZE;
+    for (auto const& obj : page.objects)
+        size += frameSize(obj.blob.size());
+
+    std::string out;
+    out.reserve(size);
+    for (auto const& obj : page.objects)
+    {
+        putKey(out, obj.key);
+        putUInt32(out, obj.blob.size());
+        out.append(reinterpret_cast<char const*>(obj.blob.data()), obj.blob.size());
+    }
+
+    putUInt32(out, ledgerSequence);
+    putUInt32(out, page.objects.size());
+    out.push_back(page.cursor ? 1 : 0);
+    putKey(out, page.cursor.value_or(ripple::uint256{}));
+    putUInt32(out, checksum(out));
+    return out;
+}
+
+std::optional<LedgerPage>
+deserialize(std::string_view data, std::uint32_t ledgerSequence)
+{
+    if (data.size() < TRAILER_SIZE)
+        return {};
+
+    auto const trailer = data.size() - TRAILER_SIZE;
+    if (checksum(data.substr(0, data.size() - 4)) != getUInt32(data, data.size() - 4))
+        return {};
+    if (getUInt32(data, trailer) != ledgerSequence)
+        return {};
+
+    auto const count = getUInt32(data, trailer + 4);
+
+    LedgerPage page;
+    page.objects.reserve(std::min<std::size_t>(count, trailer / (KEY_SIZE + 4)));
+
+    std::size_t offset = 0;
+    while (offset < trailer)
+    {
+        if (trailer - offset < KEY_SIZE + 4)
+            return {};
+
+        auto key = getKey(data, offset);
+        auto const blobSize = getUInt32(data, offset + KEY_SIZE);
+        offset += KEY_SIZE + 4;
+        if (trailer - offset < blobSize)
+            return {};
+
+        auto const* blob = reinterpret_cast<unsigned char const*>(data.data() + offset);
+        page.objects.push_back({std::move(key), Blob(blob, blob + blobSize)});
+        offset += blobSize;
+    }
+
+    if (page.objects.size() != count)
+        return {};
+
+    if (data[trailer + 8] != 0)
+        page.cursor = getKey(data, trailer + 9);
+
+    return page;
+}
+
+}  // namespace Backend::CachePage
@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <backend/Types.h>
+
+#include <ripple/basics/base_uint.h>
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace Backend {
+
+/**
+ * @brief Binary format used to transfer the ledger cache between Clio nodes
+ *
+ * A page is a sequence of frames followed by a fixed size trailer. Each frame is the 32 byte key of a ledger object,
+ * the size of its blob as a 4 byte big endian integer and the blob itself. The trailer holds the ledger sequence, the
+ * number of frames, the cursor to request the next page from (if any) and a CRC32 of everything that precedes it.
+ */
+namespace CachePage {
+
+/**
+ * @brief HTTP target under which a Clio node serves its cache
+ */
+static constexpr std::string_view TARGET = "/cache";
+
+/**
+ * @brief Max size of the frames of a single page
+ *
+ * Pages are cut before their frames would go over it, unless that leaves the page empty.
+ */
+static constexpr std::size_t MAX_PAGE_BYTES = 4 * 1024 * 1024;
+
+/**
+ * @brief Size of a frame besides its blob: the key and the size of the blob
+ */
+static constexpr std::size_t FRAME_OVERHEAD = ripple::uint256::size() + 4;
+
+/**
+ * @brief Size of the trailer: ledger sequence, number of frames, cursor flag, cursor and checksum
+ */
+static constexpr std::size_t TRAILER_SIZE = 4 + 4 + 1 + ripple::uint256::size() + 4;
+
+/**
+ * @brief Max size of a serialized page, for the receiver to bound what it reads
+ *
+ * Only a page made of a single object bigger than MAX_PAGE_BYTES could be larger, and ledger objects are far smaller.
+ */
+static constexpr std::size_t MAX_SERIALIZED_BYTES = MAX_PAGE_BYTES + TRAILER_SIZE;
+
+/**
+ * @return The size of the frame of an object with a blob of the given size
+ */
+constexpr std::size_t
+frameSize(std::size_t blobSize)
+{
+    return FRAME_OVERHEAD + blobSize;
+}
+
+/**
+ * @brief Request for the objects of a ledger whose keys are in [from, to)
+ */
+struct Request
+{
+    std::uint32_t ledgerSequence = 0;
+    ripple::uint256 from;
+    std::optional<ripple::uint256> to;
+
+    /**
+     * @return The HTTP target for this request
+     */
+    std::string
+    target() const;
+
+    /**
+     * @brief Parse a request from a HTTP target
+     *
+     * @param target The target, starting with TARGET
+     * @return The request or an empty optional if the target is malformed
+     */
+    static std::optional<Request>
+    parse(std::string_view target);
+};
+
+/**
+ * @brief Serialize a page of ledger objects
+ *
+ * @param page The objects and the cursor to continue from
+ * @param ledgerSequence The ledger the objects belong to
+ * @return The binary representation of the page
+ */
+std::string
+serialize(LedgerPage const& page, std::uint32_t ledgerSequence);
+
+/**
+ * @brief Deserialize and verify a page of ledger objects
+ *
+ * @param data The binary representation of the page
+ * @param ledgerSequence The ledger the page is expected to belong to
+ * @return The page or an empty optional if the data is truncated, corrupted or belongs to another ledger
+ */
+std::optional<LedgerPage>
+deserialize(std::string_view data, std::uint32_t ledgerSequence);
+
+}  // namespace CachePage
+}  // namespace Backend
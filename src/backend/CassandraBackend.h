@@ -261,6 +261,35 @@ public:
         return std::nullopt;
     }
 
+    boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+    fetchLedgerBySequence(std::uint32_t const sequence, boost::asio::use_awaitable_t<> token) const override
+    {
+        log_.trace() << __func__ << " call for seq " << sequence;
+
+        auto const res = co_await executor_.read(token, schema_->selectLedgerBySeq, sequence);
+        if (res)
+        {
+            if (auto const& result = res.value(); result)
+            {
+                if (auto const maybeValue = result.template get<std::vector<unsigned char>>(); maybeValue)
+                {
+                    co_return util::deserializeHeader(ripple::makeSlice(*maybeValue));
+                }
+
+                log_.error() << "Could not fetch ledger by sequence - no rows";
+                co_return std::nullopt;
+            }
+
+            log_.error() << "Could not fetch ledger by sequence - no result";
+        }
+        else
+        {
+            log_.error() << "Could not fetch ledger by sequence: " << res.error();
+        }
+
+        co_return std::nullopt;
+    }
+
     std::optional<ripple::LedgerInfo>
     fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::yield_context& yield) const override
     {
@@ -287,6 +316,32 @@ public:
         return std::nullopt;
     }
 
+    boost::asio::awaitable<std::optional<ripple::LedgerInfo>>
+    fetchLedgerByHash(ripple::uint256 const& hash, boost::asio::use_awaitable_t<> token) const override
+    {
+        log_.trace() << __func__ << " call";
+
+        if (auto const res = co_await executor_.read(token, schema_->selectLedgerByHash, hash); res)
+        {
+            if (auto const& result = res.value(); result)
+            {
+                if (auto const maybeValue = result.template get<uint32_t>(); maybeValue)
+                    co_return co_await fetchLedgerBySequence(*maybeValue, token);
+
+                log_.error() << "Could not fetch ledger by hash - no rows";
+                co_return std::nullopt;
+            }
+
+            log_.error() << "Could not fetch ledger by hash - no result";
+        }
+        else
+        {
+            log_.error() << "Could not fetch ledger by hash: " << res.error();
+        }
+
+        co_return std::nullopt;
+    }
+
     std::optional<LedgerRange>
     hardFetchLedgerRange(boost::asio::yield_context& yield) const override
     {
@@ -514,6 +569,31 @@ public:
         return std::nullopt;
     }
 
+    boost::asio::awaitable<std::optional<Blob>>
+    doFetchLedgerObject(ripple::uint256 const& key, std::uint32_t const sequence, boost::asio::use_awaitable_t<> token)
+        const override
+    {
+        log_.debug() << "Fetching ledger object for seq " << sequence << ", key = " << ripple::to_string(key);
+        if (auto const res = co_await executor_.read(token, schema_->selectObject, key, sequence); res)
+        {
+            if (auto const result = res->template get<Blob>(); result)
+            {
+                if (result->size())
+                    co_return *result;
+            }
+            else
+            {
+                log_.debug() << "Could not fetch ledger object - no rows";
+            }
+        }
+        else
+        {
+            log_.error() << "Could not fetch ledger object: " << res.error();
+        }
+
+        co_return std::nullopt;
+    }
+
     std::optional<TransactionAndMetadata>
     fetchTransaction(ripple::uint256 const& hash, boost::asio::yield_context& yield) const override
     {
@@ -539,6 +619,31 @@ public:
         return std::nullopt;
     }
 
+    boost::asio::awaitable<std::optional<TransactionAndMetadata>>
+    fetchTransaction(ripple::uint256 const& hash, boost::asio::use_awaitable_t<> token) const override
+    {
+        log_.trace() << __func__ << " call";
+
+        if (auto const res = co_await executor_.read(token, schema_->selectTransaction, hash); res)
+        {
+            if (auto const maybeValue = res->template get<Blob, Blob, uint32_t, uint32_t>(); maybeValue)
+            {
+                auto [transaction, meta, seq, date] = *maybeValue;
+                co_return std::make_optional<TransactionAndMetadata>(transaction, meta, seq, date);
+            }
+            else
+            {
+                log_.debug() << "Could not fetch transaction - no rows";
+            }
+        }
+        else
+        {
+            log_.error() << "Could not fetch transaction: " << res.error();
+        }
+
+        co_return std::nullopt;
+    }
+
     std::optional<ripple::uint256>
     doFetchSuccessorKey(ripple::uint256 key, std::uint32_t const ledgerSequence, boost::asio::yield_context& yield)
         const override
@@ -645,6 +750,44 @@ public:
         return results;
     }
 
+    boost::asio::awaitable<std::vector<Blob>>
+    doFetchLedgerObjects(
+        std::vector<ripple::uint256> const& keys,
+        std::uint32_t const sequence,
+        boost::asio::use_awaitable_t<> token) const override
+    {
+        log_.trace() << __func__ << " call";
+
+        if (keys.size() == 0)
+            co_return std::vector<Blob>{};
+
+        auto const numKeys = keys.size();
+        log_.trace() << "Fetching " << numKeys << " objects";
+
+        std::vector<Blob> results;
+        results.reserve(numKeys);
+
+        std::vector<Statement> statements;
+        statements.reserve(numKeys);
+
+        std::transform(
+            std::cbegin(keys), std::cend(keys), std::back_inserter(statements), [this, &sequence](auto const& key) {
+                return schema_->selectObject.bind(key, sequence);
+            });
+
+        auto const entries = co_await executor_.readEach(token, statements);
+        std::transform(
+            std::cbegin(entries), std::cend(entries), std::back_inserter(results), [](auto const& res) -> Blob {
+                if (auto const maybeValue = res.template get<Blob>(); maybeValue)
+                    return *maybeValue;
+                else
+                    return {};
+            });
+
+        log_.trace() << "Fetched " << numKeys << " objects";
+        co_return results;
+    }
+
     std::vector<LedgerObject>
     fetchLedgerDiff(std::uint32_t const ledgerSequence, boost::asio::yield_context& yield) const override
     {
@@ -17,8 +17,12 @@
 */
 //==============================================================================
 
+#include <backend/CachePage.h>
 #include <backend/LedgerCache.h>
 
+#include <iterator>
+#include <type_traits>
+
 namespace Backend {
 
 uint32_t
@@ -28,8 +32,9 @@ LedgerCache::latestLedgerSequence() const
     return latestSeq_;
 }
 
+template <typename Objects>
 void
-LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground)
+LedgerCache::doUpdate(Objects&& objs, uint32_t seq, bool isBackground)
 {
     if (disabled_)
         return;
@@ -41,7 +46,7 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
             assert(seq == latestSeq_ + 1 || latestSeq_ == 0);
             latestSeq_ = seq;
         }
-        for (auto const& obj : objs)
+        for (auto&& obj : objs)
         {
             if (obj.blob.size())
             {
@@ -51,7 +56,10 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
                 auto& e = map_[obj.key];
                 if (seq > e.seq)
                 {
-                    e = {seq, obj.blob};
+                    if constexpr (std::is_rvalue_reference_v<Objects&&>)
+                        e = {seq, std::move(obj.blob)};
+                    else
+                        e = {seq, obj.blob};
                 }
             }
             else
@@ -64,6 +72,18 @@ LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool is
     }
 }
 
+void
+LedgerCache::update(std::vector<LedgerObject> const& objs, uint32_t seq, bool isBackground)
+{
+    doUpdate(objs, seq, isBackground);
+}
+
+void
+LedgerCache::update(std::vector<LedgerObject>&& objs, uint32_t seq, bool isBackground)
+{
+    doUpdate(std::move(objs), seq, isBackground);
+}
+
 std::optional<LedgerObject>
 LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
 {
@@ -80,6 +100,35 @@ LedgerCache::getSuccessor(ripple::uint256 const& key, uint32_t seq) const
     return {{e->first, e->second.blob}};
 }
 
+std::vector<LedgerCache::Neighbors>
+LedgerCache::getNeighbors(std::vector<ripple::uint256> const& keys, uint32_t seq) const
+{
+    std::vector<Neighbors> neighbors;
+    if (!full_)
+        return neighbors;
+    std::shared_lock lck{mtx_};
+    successorReqCounter_ += keys.size();
+    if (seq != latestSeq_)
+        return neighbors;
+
+    neighbors.reserve(keys.size());
+    for (auto const& key : keys)
+    {
+        auto& n = neighbors.emplace_back();
+        auto e = map_.lower_bound(key);
+        if (e != map_.begin())
+            n.predecessor = std::prev(e)->first;
+        if (e != map_.end() && e->first == key)
+            ++e;
+        if (e != map_.end())
+        {
+            successorHitCounter_++;
+            n.successor = e->first;
+        }
+    }
+    return neighbors;
+}
+
 std::optional<LedgerObject>
 LedgerCache::getPredecessor(ripple::uint256 const& key, uint32_t seq) const
 {
@@ -111,6 +160,39 @@ LedgerCache::get(ripple::uint256 const& key, uint32_t seq) const
     return {e->second.blob};
 }
 
+std::optional<LedgerPage>
+LedgerCache::getPage(
+    ripple::uint256 const& from,
+    std::optional<ripple::uint256> const& to,
+    std::size_t maxBytes,
+    uint32_t seq) const
+{
+    if (!full_)
+        return {};
+    std::shared_lock lck{mtx_};
+    if (seq != latestSeq_)
+        return {};
+
+    LedgerPage page;
+    if (to && *to <= from)
+        return page;
+
+    auto const last = to ? map_.lower_bound(*to) : map_.end();
+    std::size_t bytes = 0;
+    for (auto e = map_.lower_bound(from); e != last; ++e)
+    {
+        auto const frameBytes = CachePage::frameSize(e->second.blob.size());
+        if (!page.objects.empty() && bytes + frameBytes > maxBytes)
+        {
+            page.cursor = e->first;
+            break;
+        }
+        bytes += frameBytes;
+        page.objects.push_back({e->first, e->second.blob});
+    }
+    return page;
+}
+
 void
 LedgerCache::setDisabled()
 {
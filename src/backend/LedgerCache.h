@@ -56,11 +56,25 @@ class LedgerCache
     // temporary set to prevent background thread from writing already deleted data. not used when cache is full
     std::unordered_set<ripple::uint256, ripple::hardened_hash<>> deletes_;
 
+    template <typename Objects>
+    void
+    doUpdate(Objects&& objs, uint32_t seq, bool isBackground);
+
 public:
+    struct Neighbors
+    {
+        std::optional<ripple::uint256> predecessor;
+        std::optional<ripple::uint256> successor;
+    };
+
     // Update the cache with new ledger objects set isBackground to true when writing old data from a background thread
     void
     update(std::vector<LedgerObject> const& blobs, uint32_t seq, bool isBackground = false);
 
+    // same as above, but takes ownership of the blobs instead of copying them
+    void
+    update(std::vector<LedgerObject>&& blobs, uint32_t seq, bool isBackground = false);
+
     std::optional<Blob>
     get(ripple::uint256 const& key, uint32_t seq) const;
 
@@ -72,6 +86,22 @@ public:
     std::optional<LedgerObject>
     getPredecessor(ripple::uint256 const& key, uint32_t seq) const;
 
+    // keys of the objects before and after each of the given keys, looked up under a single read lock.
+    // always returns an empty vector if isFull() is false or seq is not the latest sequence
+    std::vector<Neighbors>
+    getNeighbors(std::vector<ripple::uint256> const& keys, uint32_t seq) const;
+
+    // copies the objects with keys in [from, to) under a single read lock, stopping before their frames (see CachePage)
+    // would take more than maxBytes, unless the page would be empty. the cursor of the returned page is set if there
+    // are more objects in the range. always returns an empty optional if isFull() is false or seq is not the latest
+    // sequence, so that the page never mixes objects of several ledgers
+    std::optional<LedgerPage>
+    getPage(
+        ripple::uint256 const& from,
+        std::optional<ripple::uint256> const& to,
+        std::size_t maxBytes,
+        uint32_t seq) const;
+
     void
     setDisabled();
 
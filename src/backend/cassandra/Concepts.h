@@ -21,7 +21,9 @@
 
 #include <backend/cassandra/Types.h>
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
 
 #include <chrono>
 #include <concepts>
@@ -50,7 +52,8 @@ concept SomeExecutionStrategy = requires(
     Statement statement, 
     std::vector<Statement> statements,
     PreparedStatement prepared,
-    boost::asio::yield_context token
+    boost::asio::yield_context token,
+    boost::asio::use_awaitable_t<> awaitable
 ) {
     { T(settings, handle) };
     { a.sync() } -> std::same_as<void>;
@@ -63,6 +66,10 @@ concept SomeExecutionStrategy = requires(
     { a.read(token, statement) } -> std::same_as<ResultOrError>;
     { a.read(token, statements) } -> std::same_as<ResultOrError>;
     { a.readEach(token, statements) } -> std::same_as<std::vector<Result>>;
+    { a.read(awaitable, prepared) } -> std::same_as<boost::asio::awaitable<ResultOrError>>;
+    { a.read(awaitable, statement) } -> std::same_as<boost::asio::awaitable<ResultOrError>>;
+    { a.read(awaitable, statements) } -> std::same_as<boost::asio::awaitable<ResultOrError>>;
+    { a.readEach(awaitable, statements) } -> std::same_as<boost::asio::awaitable<std::vector<Result>>>;
 };
 // clang-format on
 
@@ -24,9 +24,12 @@
 #include <backend/cassandra/impl/AsyncExecutor.h>
 #include <log/Logger.h>
 #include <util/Expected.h>
+#include <util/WorkCost.h>
 
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/use_awaitable.hpp>
 
 #include <atomic>
 #include <condition_variable>
@@ -81,6 +84,11 @@ public:
     using AsyncResultType = boost::asio::async_result<CompletionTokenType, FunctionType>;
     using HandlerType = typename AsyncResultType::completion_handler_type;
 
+    using AwaitableTokenType = boost::asio::use_awaitable_t<>;
+    template <typename T>
+    using AwaitableType = boost::asio::awaitable<T>;
+    using CallbackType = std::function<void(ResultOrErrorType)>;
+
     DefaultExecutionStrategy(Settings settings, HandleType const& handle)
         : maxWriteRequestsOutstanding_{settings.maxWriteRequestsOutstanding}
         , maxReadRequestsOutstanding_{settings.maxReadRequestsOutstanding}
@@ -232,6 +240,7 @@ public:
         while (true)
         {
             numReadRequestsOutstanding_ += numStatements;
+            util::WorkCost::recordReads(numStatements);
 
             auto const future = handle_.get().asyncExecute(statements, [handler](auto&&) mutable {
                 boost::asio::post(boost::asio::get_associated_executor(handler), [handler]() mutable {
@@ -240,7 +249,10 @@ public:
             });
 
             // suspend coroutine until completion handler is called
-            result.get();
+            {
+                util::WorkCost::Suspension const suspension;
+                result.get();
+            }
 
             numReadRequestsOutstanding_ -= numStatements;
 
@@ -278,6 +290,7 @@ public:
         while (true)
         {
             ++numReadRequestsOutstanding_;
+            util::WorkCost::recordReads(1);
 
             auto const future = handle_.get().asyncExecute(statement, [handler](auto const&) mutable {
                 boost::asio::post(boost::asio::get_associated_executor(handler), [handler]() mutable {
@@ -286,7 +299,10 @@ public:
             });
 
             // suspend coroutine until completion handler is called
-            result.get();
+            {
+                util::WorkCost::Suspension const suspension;
+                result.get();
+            }
 
             --numReadRequestsOutstanding_;
 
@@ -324,6 +340,7 @@ public:
         std::atomic_bool hadError = false;
         std::atomic_int numOutstanding = statements.size();
         numReadRequestsOutstanding_ += statements.size();
+        util::WorkCost::recordReads(statements.size());
 
         auto futures = std::vector<FutureWithCallbackType>{};
         futures.reserve(numOutstanding);
@@ -349,7 +366,10 @@ public:
             });
 
         // suspend coroutine until completion handler is called
-        result.get();
+        {
+            util::WorkCost::Suspension const suspension;
+            result.get();
+        }
 
         numReadRequestsOutstanding_ -= statements.size();
 
@@ -376,7 +396,196 @@ public:
         return results;
     }
 
+    /**
+     * @brief C++20 coroutine version of read(CompletionTokenType, PreparedStatementType const&, Args&&...)
+     *
+     * @param token Completion token (boost::asio::use_awaitable)
+     * @param prepradeStatement Statement to prepare and execute
+     * @param args Args to bind to the prepared statement
+     * @throw DatabaseTimeout on timeout
+     * @return ResultType or error wrapped in Expected
+     */
+    template <typename... Args>
+    [[maybe_unused]] AwaitableType<ResultOrErrorType>
+    read(AwaitableTokenType token, PreparedStatementType const& preparedStatement, Args&&... args)
+    {
+        co_return co_await read(token, preparedStatement.bind(std::forward<Args>(args)...));
+    }
+
+    /**
+     * @brief C++20 coroutine version of read(CompletionTokenType, std::vector<StatementType> const&)
+     *
+     * @param token Completion token (boost::asio::use_awaitable)
+     * @param statements Statements to execute in a batch
+     * @throw DatabaseTimeout on timeout
+     * @return ResultType or error wrapped in Expected
+     */
+    [[maybe_unused]] AwaitableType<ResultOrErrorType>
+    read(AwaitableTokenType, std::vector<StatementType> const& statements)
+    {
+        auto const numStatements = statements.size();
+
+        // todo: perhaps use policy instead
+        while (true)
+        {
+            numReadRequestsOutstanding_ += numStatements;
+            util::WorkCost::recordReads(numStatements);
+
+            std::optional<FutureWithCallbackType> future;
+            co_await awaitCallbacks(1, [this, &statements, &future](CallbackType const& callback) {
+                future.emplace(handle_.get().asyncExecute(statements, CallbackType{callback}));
+            });
+
+            numReadRequestsOutstanding_ -= numStatements;
+
+            // the callback was called, the result is ready
+            if (auto res = future->get(); res)
+            {
+                co_return res;
+            }
+            else
+            {
+                log_.error() << "Failed batch read in coroutine: " << res.error();
+                throwErrorIfNeeded(res.error());
+            }
+        }
+    }
+
+    /**
+     * @brief C++20 coroutine version of read(CompletionTokenType, StatementType const&)
+     *
+     * @param token Completion token (boost::asio::use_awaitable)
+     * @param statement Statement to execute
+     * @throw DatabaseTimeout on timeout
+     * @return ResultType or error wrapped in Expected
+     */
+    [[maybe_unused]] AwaitableType<ResultOrErrorType>
+    read(AwaitableTokenType, StatementType const& statement)
+    {
+        // todo: perhaps use policy instead
+        while (true)
+        {
+            ++numReadRequestsOutstanding_;
+            util::WorkCost::recordReads(1);
+
+            std::optional<FutureWithCallbackType> future;
+            co_await awaitCallbacks(1, [this, &statement, &future](CallbackType const& callback) {
+                future.emplace(handle_.get().asyncExecute(statement, CallbackType{callback}));
+            });
+
+            --numReadRequestsOutstanding_;
+
+            // the callback was called, the result is ready
+            if (auto res = future->get(); res)
+            {
+                co_return res;
+            }
+            else
+            {
+                log_.error() << "Failed read in coroutine: " << res.error();
+                throwErrorIfNeeded(res.error());
+            }
+        }
+    }
+
+    /**
+     * @brief C++20 coroutine version of readEach(CompletionTokenType, std::vector<StatementType> const&)
+     *
+     * @param token Completion token (boost::asio::use_awaitable)
+     * @param statements Statements to execute
+     * @throw DatabaseTimeout on db error
+     * @return Vector of results
+     */
+    AwaitableType<std::vector<ResultType>>
+    readEach(AwaitableTokenType, std::vector<StatementType> const& statements)
+    {
+        numReadRequestsOutstanding_ += statements.size();
+        util::WorkCost::recordReads(statements.size());
+
+        auto futures = std::vector<FutureWithCallbackType>{};
+        futures.reserve(statements.size());
+
+        auto const hadError =
+            co_await awaitCallbacks(statements.size(), [this, &statements, &futures](CallbackType const& callback) {
+                for (auto const& statement : statements)
+                    futures.push_back(handle_.get().asyncExecute(statement, CallbackType{callback}));
+            });
+
+        numReadRequestsOutstanding_ -= statements.size();
+
+        if (hadError)
+            throw DatabaseTimeout{};
+
+        std::vector<ResultType> results;
+        results.reserve(futures.size());
+
+        // all callbacks were called, the results are ready
+        std::transform(
+            std::make_move_iterator(std::begin(futures)),
+            std::make_move_iterator(std::end(futures)),
+            std::back_inserter(results),
+            [](auto&& future) {
+                auto entry = future.get();
+                auto&& res = entry.value();
+                return std::move(res);
+            });
+
+        assert(results.size() == statements.size());
+        co_return results;
+    }
+
 private:
+    /**
+     * @brief Suspend the calling coroutine until count callbacks of asyncExecute were called
+     *
+     * The driver may call a callback before asyncExecute even returned, so the coroutine is only resumed once start
+     * returned as well; until then the futures it stores are not safe to use.
+     *
+     * @param count The number of callbacks to wait for
+     * @param start Called with the callback to give a copy of to each asyncExecute
+     * @return Whether any of the statements failed
+     */
+    template <typename StartFn>
+    AwaitableType<bool>
+    awaitCallbacks(std::size_t count, StartFn start)
+    {
+        using SignatureType = void(boost::system::error_code, bool);
+
+        util::WorkCost::Suspension const suspension;
+        co_return co_await boost::asio::async_initiate<AwaitableTokenType const, SignatureType>(
+            [count, &start](auto handler) {
+                using AwaitHandlerType = decltype(handler);
+
+                struct State
+                {
+                    AwaitHandlerType handler;
+                    std::atomic_size_t remaining;
+                    std::atomic_bool hadError = false;
+
+                    void
+                    arrive(std::shared_ptr<State> const& self)
+                    {
+                        if (--remaining != 0)
+                            return;
+
+                        auto const executor = boost::asio::get_associated_executor(handler);
+                        boost::asio::post(executor, [self]() mutable {
+                            std::move(self->handler)(boost::system::error_code{}, self->hadError.load());
+                        });
+                    }
+                };
+
+                auto state = std::make_shared<State>(std::move(handler), count + 1);
+                start(CallbackType{[state](auto const& res) {
+                    if (not res)
+                        state->hadError = true;
+                    state->arrive(state);
+                }});
+                state->arrive(state);
+            },
+            AwaitableTokenType{});
+    }
+
     void
     incrementOutstandingRequestCount()
     {
@@ -196,26 +196,3 @@ public:
         return ret;
     }
 };
-
-/**
- * @brief Parititions the uint256 keyspace into numMarkers partitions, each of equal size.
- *
- * @param numMarkers total markers to partition for
- */
-inline std::vector<ripple::uint256>
-getMarkers(size_t numMarkers)
-{
-    assert(numMarkers <= 256);
-
-    unsigned char incr = 256 / numMarkers;
-
-    std::vector<ripple::uint256> markers;
-    markers.reserve(numMarkers);
-    ripple::uint256 base{0};
-    for (size_t i = 0; i < numMarkers; ++i)
-    {
-        markers.push_back(base);
-        base.data()[0] += incr;
-    }
-    return markers;
-}
@@ -44,9 +44,16 @@ ETLService::runETLPipeline(uint32_t startSequence, int numExtractors)
 
     for (auto i = 0u; i < numExtractors; ++i)
         extractors.push_back(std::make_unique<ExtractorType>(
-            pipe, networkValidatedLedgers_, ledgerFetcher_, startSequence + i, finishSequence_, state_));
-
-    auto transformer = TransformerType{pipe, backend_, ledgerLoader_, ledgerPublisher_, startSequence, state_};
+            pipe,
+            networkValidatedLedgers_,
+            ledgerFetcher_,
+            startSequence + i,
+            finishSequence_,
+            state_,
+            extractorMaxInFlight_));
+
+    auto transformer = TransformerType{
+        pipe, backend_, ledgerLoader_, ledgerPublisher_, startSequence, state_, ledgerPublisher_.feed().isEnabled()};
     transformer.waitTillFinished();  // suspend current thread until exit condition is met
     pipe.cleanup();                  // TODO: this should probably happen automatically using destructor
 
@@ -208,7 +215,12 @@ ETLService::monitorReadOnly()
 
     while (true)
     {
-        if (auto rng = backend_->hardFetchLedgerRangeNoThrow(); rng && rng->maxSequence >= latestSequence)
+        if (auto bundle = ledgerFeedClient_.fetch(latestSequence); bundle)
+        {
+            ledgerPublisher_.publish(bundle);
+            latestSequence = latestSequence + 1;
+        }
+        else if (auto rng = backend_->hardFetchLedgerRangeNoThrow(); rng && rng->maxSequence >= latestSequence)
         {
             ledgerPublisher_.publish(latestSequence, {});
             latestSequence = latestSequence + 1;
@@ -257,11 +269,18 @@ ETLService::ETLService(
     , cacheLoader_(config, ioc, backend, backend->cache())
     , ledgerFetcher_(backend, balancer)
     , ledgerLoader_(backend, balancer, ledgerFetcher_, state_)
-    , ledgerPublisher_(ioc, backend, subscriptions, state_)
+    , ledgerPublisher_(
+          ioc,
+          backend,
+          subscriptions,
+          state_,
+          config.contains("ledger_feed") ? config.section("ledger_feed").valueOr<std::size_t>("num_ledgers", 0) : 0)
+    , ledgerFeedClient_(config)
 {
     startSequence_ = config.maybeValue<uint32_t>("start_sequence");
     finishSequence_ = config.maybeValue<uint32_t>("finish_sequence");
     state_.isReadOnly = config.valueOr("read_only", state_.isReadOnly);
     extractorThreads_ = config.valueOr<uint32_t>("extractor_threads", extractorThreads_);
+    extractorMaxInFlight_ = config.valueOr<uint32_t>("extractor_max_in_flight", extractorMaxInFlight_);
     txnThreshold_ = config.valueOr<size_t>("txn_threshold", txnThreshold_);
 }
@@ -27,6 +27,7 @@
 #include <etl/impl/CacheLoader.h>
 #include <etl/impl/ExtractionDataPipe.h>
 #include <etl/impl/Extractor.h>
+#include <etl/impl/LedgerFeedClient.h>
 #include <etl/impl/LedgerFetcher.h>
 #include <etl/impl/LedgerLoader.h>
 #include <etl/impl/LedgerPublisher.h>
@@ -78,12 +79,14 @@ class ETLService
     std::shared_ptr<NetworkValidatedLedgersType> networkValidatedLedgers_;
 
     std::uint32_t extractorThreads_ = 1;
+    std::uint32_t extractorMaxInFlight_ = 1;
     std::thread worker_;
 
     CacheLoaderType cacheLoader_;
     LedgerFetcherType ledgerFetcher_;
     LedgerLoaderType ledgerLoader_;
     LedgerPublisherType ledgerPublisher_;
+    clio::detail::LedgerFeedClient ledgerFeedClient_;
 
     SystemState state_;
 
@@ -152,6 +155,43 @@ public:
         return ledgerPublisher_.lastCloseAgeSeconds();
     }
 
+    /**
+     * @brief Get a ledger committed by this node, as served to read-only nodes by the ledger feed
+     *
+     * @param sequence The ledger to get
+     * @return The serialized ledger, or nullptr if it is not (or no longer) in the ledger feed
+     */
+    std::shared_ptr<std::string const>
+    getCommittedLedger(uint32_t sequence) const
+    {
+        return ledgerPublisher_.feed().get(sequence);
+    }
+
+    /**
+     * @return The sequence of the latest ledger in the ledger feed, if any
+     */
+    std::optional<uint32_t>
+    getLatestCommittedLedger() const
+    {
+        return ledgerPublisher_.feed().latestSequence();
+    }
+
+    /**
+     * @brief Suspend a coroutine until a ledger is committed to the ledger feed or the deadline passes
+     *
+     * @param sequence The ledger waited for; returns right away if it or a later one is in the feed
+     * @param deadline When to stop waiting
+     * @param yield The coroutine to suspend
+     */
+    void
+    waitForCommittedLedger(
+        uint32_t sequence,
+        std::chrono::steady_clock::time_point deadline,
+        boost::asio::yield_context yield) const
+    {
+        ledgerPublisher_.feed().wait(sequence, deadline, yield);
+    }
+
     /**
      * @brief Check for the amendment blocked state.
      *
@@ -209,7 +249,8 @@ private:
      * @brief Monitor the database for newly written ledgers.
      *
      * Similar to the monitor(), except this function will never call runETLPipeline() or loadInitialLedger().
-     * This function only publishes ledgers as they are written to the database.
+     * This function only publishes ledgers as they are written to the database. If the ledger feed of the writer is
+     * configured, ledgers are received from it as soon as they are committed instead of polling the database.
      */
     void
     monitorReadOnly();
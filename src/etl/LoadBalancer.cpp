@@ -34,6 +34,9 @@
 #include <boost/json.hpp>
 #include <boost/json/src.hpp>
 
+#include <algorithm>
+#include <numeric>
+#include <random>
 #include <thread>
 
 using namespace clio;
@@ -78,6 +81,9 @@ LoadBalancer::LoadBalancer(
     else if (backend->fetchLedgerRange())
         downloadRanges_ = 4;
 
+    if (auto value = config.maybeValue<uint32_t>("hedge_fetch_delay_ms"); value)
+        hedgeMinDelay_ = std::chrono::milliseconds{*value};
+
     for (auto const& entry : config.array("etl_sources"))
     {
         std::unique_ptr<Source> source = make_Source(entry, ioContext, backend, subscriptions, nwvl, *this);
@@ -90,21 +96,42 @@ LoadBalancer::LoadBalancer(
 std::pair<std::vector<std::string>, bool>
 LoadBalancer::loadInitialLedger(uint32_t sequence, bool cacheOnly)
 {
-    std::vector<std::string> response;
-    auto const success = execute(
-        [this, &response, &sequence, cacheOnly](auto& source) {
-            auto [data, res] = source->loadInitialLedger(sequence, downloadRanges_, cacheOnly);
-
-            if (!res)
-                log_.error() << "Failed to download initial ledger."
-                             << " Sequence = " << sequence << " source = " << source->toString();
-            else
-                response = std::move(data);
+    // split the key space finer than any single source downloads at once, so that sources share the work
+    auto const numRanges = std::min<std::uint32_t>(
+        downloadRanges_ * std::max<std::size_t>(sources_.size(), 1), clio::detail::MarkerRange::KEY_SPACE_END);
+    clio::detail::MarkerRangeQueue queue{numRanges};
 
-            return res;
-        },
-        sequence);
-    return {std::move(response), success};
+    while (!queue.isDone())
+    {
+        std::vector<std::thread> workers;
+        for (auto const& source : sources_)
+        {
+            if (!source->hasLedger(sequence))
+            {
+                log_.warn() << "Ledger not present at source = " << source->toString()
+                            << " - ledger sequence = " << sequence;
+                continue;
+            }
+
+            workers.emplace_back([this, &source, &queue, sequence, cacheOnly]() {
+                if (!source->loadInitialLedger(sequence, queue, downloadRanges_, cacheOnly))
+                    log_.error() << "Failed to download part of initial ledger."
+                                 << " Sequence = " << sequence << " source = " << source->toString();
+            });
+        }
+
+        for (auto& worker : workers)
+            worker.join();
+
+        if (!queue.isDone())
+        {
+            log_.info() << "Initial ledger " << sequence << " is not yet fully downloaded. "
+                        << "Sleeping and retrying remaining ranges";
+            std::this_thread::sleep_for(std::chrono::seconds(2));
+        }
+    }
+
+    return {queue.edgeKeys(), true};
 }
 
 LoadBalancer::OptionalGetLedgerResponseType
@@ -112,20 +139,20 @@ LoadBalancer::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObje
 {
     GetLedgerResponseType response;
     bool success = execute(
-        [&response, ledgerSequence, getObjects, getObjectNeighbors, log = log_](auto& source) {
-            auto [status, data] = source->fetchLedger(ledgerSequence, getObjects, getObjectNeighbors);
+        [this, &response, ledgerSequence, getObjects, getObjectNeighbors](auto& source) {
+            auto [status, data] = fetchLedgerFrom(*source, ledgerSequence, getObjects, getObjectNeighbors);
             response = std::move(data);
             if (status.ok() && response.validated())
             {
-                log.info() << "Successfully fetched ledger = " << ledgerSequence
-                           << " from source = " << source->toString();
+                log_.info() << "Successfully fetched ledger = " << ledgerSequence
+                            << " from source = " << source->toString();
                 return true;
             }
             else
             {
-                log.warn() << "Could not fetch ledger " << ledgerSequence << ", Reply: " << response.DebugString()
-                           << ", error_code: " << status.error_code() << ", error_msg: " << status.error_message()
-                           << ", source = " << source->toString();
+                log_.warn() << "Could not fetch ledger " << ledgerSequence << ", Reply: " << response.DebugString()
+                            << ", error_code: " << status.error_code() << ", error_msg: " << status.error_message()
+                            << ", source = " << source->toString();
                 return false;
             }
         },
@@ -136,23 +163,70 @@ LoadBalancer::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObje
         return {};
 }
 
+std::size_t
+LoadBalancer::fetchLedgers(
+    std::vector<uint32_t> const& sequences,
+    std::uint32_t maxInFlight,
+    bool getObjects,
+    bool getObjectNeighbors,
+    OnLedgerFetchedType onFetched)
+{
+    if (sequences.empty() || sources_.empty())
+        return 0;
+
+    for (auto const idx : orderSources(RequestKind::GRPC))
+    {
+        auto& source = sources_[idx];
+        if (source->hasLedger(sequences.front()) && source->hasLedger(sequences.back()))
+        {
+            auto stoppedByCaller = false;
+            auto& stats = source->stats().grpc;
+            stats.started();
+            auto const start = std::chrono::steady_clock::now();
+
+            auto const numFetched = source->fetchLedgers(
+                sequences,
+                maxInFlight,
+                getObjects,
+                getObjectNeighbors,
+                [&onFetched, &stoppedByCaller](uint32_t seq, GetLedgerResponseType&& response) {
+                    stoppedByCaller = !onFetched(seq, std::move(response));
+                    return !stoppedByCaller;
+                });
+
+            // one sample per batch, with the latency amortized over the ledgers delivered
+            auto const elapsed = std::chrono::steady_clock::now() - start;
+            stats.finished(
+                numFetched > 0 ? elapsed / numFetched : elapsed, stoppedByCaller || numFetched == sequences.size());
+
+            log_.info() << "Fetched " << numFetched << " of " << sequences.size() << " ledgers starting at "
+                        << sequences.front() << " from source = " << source->toString();
+            return numFetched;
+        }
+    }
+
+    log_.debug() << "No source has ledgers " << sequences.front() << " to " << sequences.back();
+    return 0;
+}
+
 std::optional<boost::json::object>
 LoadBalancer::forwardToRippled(
     boost::json::object const& request,
     std::string const& clientIp,
     boost::asio::yield_context& yield) const
 {
-    srand((unsigned)time(0));
-    auto sourceIdx = rand() % sources_.size();
-    auto numAttempts = 0;
-
-    while (numAttempts < sources_.size())
+    for (auto const idx : orderSources(RequestKind::FORWARD))
     {
-        if (auto res = sources_[sourceIdx]->forwardToRippled(request, clientIp, yield))
-            return res;
+        auto& source = sources_[idx];
+        auto& stats = source->stats().forward;
+        stats.started();
+        auto const start = std::chrono::steady_clock::now();
 
-        sourceIdx = (sourceIdx + 1) % sources_.size();
-        ++numAttempts;
+        auto res = source->forwardToRippled(request, clientIp, yield);
+        stats.finished(std::chrono::steady_clock::now() - start, res.has_value());
+
+        if (res)
+            return res;
     }
 
     return {};
@@ -179,7 +253,11 @@ LoadBalancer::toJson() const
 {
     boost::json::array ret;
     for (auto& src : sources_)
-        ret.push_back(src->toJson());
+    {
+        auto json = src->toJson();
+        json["stats"] = src->stats().toJson();
+        ret.push_back(std::move(json));
+    }
 
     return ret;
 }
@@ -188,13 +266,12 @@ template <class Func>
 bool
 LoadBalancer::execute(Func f, uint32_t ledgerSequence)
 {
-    srand((unsigned)time(0));
-    auto sourceIdx = rand() % sources_.size();
+    auto order = orderSources(RequestKind::GRPC);
     auto numAttempts = 0;
 
     while (true)
     {
-        auto& source = sources_[sourceIdx];
+        auto& source = sources_[order[numAttempts % order.size()]];
 
         log_.debug() << "Attempting to execute func. ledger sequence = " << ledgerSequence
                      << " - source = " << source->toString();
@@ -222,14 +299,171 @@ LoadBalancer::execute(Func f, uint32_t ledgerSequence)
             log_.warn() << "Ledger not present at source = " << source->toString()
                         << " - ledger sequence = " << ledgerSequence;
         }
-        sourceIdx = (sourceIdx + 1) % sources_.size();
         numAttempts++;
         if (numAttempts % sources_.size() == 0)
         {
             log_.info() << "Ledger sequence " << ledgerSequence << " is not yet available from any configured sources. "
                         << "Sleeping and trying again";
             std::this_thread::sleep_for(std::chrono::seconds(2));
+            order = orderSources(RequestKind::GRPC);
         }
     }
     return true;
 }
+
+std::vector<std::size_t>
+LoadBalancer::orderSources(RequestKind kind) const
+{
+    std::vector<std::size_t> order(sources_.size());
+    std::iota(order.begin(), order.end(), 0);
+    if (order.size() < 2)
+        return order;
+
+    auto const statsOf = [kind](auto const& source) -> clio::detail::RequestStats const& {
+        return kind == RequestKind::GRPC ? source->stats().grpc : source->stats().forward;
+    };
+
+    // sources that were not measured yet are assumed to be as fast as the average of the measured ones
+    double latencySum = 0.0;
+    std::size_t numMeasured = 0;
+    for (auto const& source : sources_)
+    {
+        if (auto const& stats = statsOf(source); stats.isMeasured())
+        {
+            latencySum += stats.latencyMs();
+            ++numMeasured;
+        }
+    }
+    auto const priorLatencyMs = numMeasured > 0 ? latencySum / numMeasured : 0.0;
+
+    // snapshot the costs; they may change concurrently while we sort
+    std::vector<double> costs;
+    costs.reserve(sources_.size());
+    for (auto const& source : sources_)
+        costs.push_back(statsOf(source).cost(priorLatencyMs));
+
+    thread_local std::mt19937 generator{std::random_device{}()};
+    std::shuffle(order.begin(), order.end(), generator);
+
+    if (costs[order[1]] < costs[order[0]])
+        std::swap(order[0], order[1]);
+
+    std::stable_sort(
+        std::next(order.begin()), order.end(), [&costs](auto lhs, auto rhs) { return costs[lhs] < costs[rhs]; });
+    return order;
+}
+
+std::pair<grpc::Status, LoadBalancer::GetLedgerResponseType>
+LoadBalancer::fetchLedgerFrom(Source& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors)
+{
+    if (hedgeMinDelay_)
+    {
+        for (auto const idx : orderSources(RequestKind::GRPC))
+        {
+            auto& other = *sources_[idx];
+            if (&other == &source || !other.isConnected() || !other.hasLedger(ledgerSequence))
+                continue;
+
+            return fetchLedgerHedged(source, other, ledgerSequence, getObjects, getObjectNeighbors);
+        }
+    }
+
+    auto& stats = source.stats().grpc;
+    stats.started();
+    auto const start = std::chrono::steady_clock::now();
+
+    auto result = source.fetchLedger(ledgerSequence, getObjects, getObjectNeighbors);
+    stats.finished(std::chrono::steady_clock::now() - start, result.first.ok() && result.second.validated());
+
+    return result;
+}
+
+std::pair<grpc::Status, LoadBalancer::GetLedgerResponseType>
+LoadBalancer::fetchLedgerHedged(
+    Source& primary,
+    Source& secondary,
+    uint32_t ledgerSequence,
+    bool getObjects,
+    bool getObjectNeighbors)
+{
+    grpc::CompletionQueue cq;
+    clio::detail::AsyncLedgerCallData first{ledgerSequence, getObjects, getObjectNeighbors};
+    clio::detail::AsyncLedgerCallData second{ledgerSequence, getObjects, getObjectNeighbors};
+
+    if (!primary.startFetchLedger(first, cq))
+        return {{grpc::StatusCode::INTERNAL, "No Stub"}, {}};
+
+    primary.stats().grpc.started();
+    std::size_t numOutstanding = 1;
+
+    // hedge once the primary takes clearly longer than it usually does
+    auto const typicalLatency = std::chrono::milliseconds{static_cast<int64_t>(2 * primary.stats().grpc.latencyMs())};
+    auto const hedgeDeadline = std::chrono::system_clock::now() + std::max(*hedgeMinDelay_, typicalLatency);
+
+    clio::detail::AsyncLedgerCallData* winner = nullptr;
+    bool hedged = false;
+    void* tag;
+    bool ok = false;
+
+    while (numOutstanding > 0)
+    {
+        if (!hedged)
+        {
+            auto const status = cq.AsyncNext(&tag, &ok, hedgeDeadline);
+            if (status == grpc::CompletionQueue::SHUTDOWN)
+                break;
+
+            if (status == grpc::CompletionQueue::TIMEOUT)
+            {
+                hedged = true;
+                log_.info() << "Fetching ledger " << ledgerSequence << " is slow at source = " << primary.toString()
+                            << ". Hedging with source = " << secondary.toString();
+
+                if (secondary.startFetchLedger(second, cq))
+                {
+                    secondary.stats().grpc.started();
+                    ++numOutstanding;
+                }
+                continue;
+            }
+        }
+        else if (!cq.Next(&tag, &ok))
+        {
+            break;
+        }
+
+        auto call = static_cast<clio::detail::AsyncLedgerCallData*>(tag);
+        auto& source = call == &first ? primary : secondary;
+        call->done = true;
+        --numOutstanding;
+
+        if (winner && call->status.error_code() == grpc::StatusCode::CANCELLED)
+            source.stats().grpc.abandoned();
+        else
+            source.stats().grpc.finished(std::chrono::steady_clock::now() - call->startTime, ok && call->succeeded());
+
+        if (!winner && ok && call->succeeded())
+        {
+            winner = call;
+            for (auto other : {&first, &second})
+            {
+                if (other != call && other->rpc && !other->done)
+                    other->context.TryCancel();
+            }
+        }
+    }
+
+    cq.Shutdown();
+    while (cq.Next(&tag, &ok))
+        ;
+
+    auto& result = winner ? *winner : first;
+    if (result.status.ok() && !result.response.is_unlimited())
+    {
+        log_.warn() << "LoadBalancer::fetchLedgerHedged - is_unlimited is "
+                       "false. Make sure secure_gateway is set "
+                       "correctly on the ETL source.";
+    }
+
+    return {result.status, std::move(result.response)};
+}
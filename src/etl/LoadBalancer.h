@@ -29,6 +29,8 @@
 #include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <chrono>
+
 class Source;
 class ProbingSource;
 class SubscriptionManager;
@@ -46,11 +48,18 @@ public:
     using RawLedgerObjectType = org::xrpl::rpc::v1::RawLedgerObject;
     using GetLedgerResponseType = org::xrpl::rpc::v1::GetLedgerResponse;
     using OptionalGetLedgerResponseType = std::optional<GetLedgerResponseType>;
+    using OnLedgerFetchedType = std::function<bool(uint32_t, GetLedgerResponseType&&)>;
 
 private:
+    /**
+     * @brief Kind of request sent to a source; each kind has its own statistics
+     */
+    enum class RequestKind { GRPC, FORWARD };
+
     clio::Logger log_{"ETL"};
     std::vector<std::unique_ptr<Source>> sources_;
     std::uint32_t downloadRanges_ = 16;
+    std::optional<std::chrono::milliseconds> hedgeMinDelay_;
 
 public:
     /**
@@ -94,7 +103,12 @@ public:
     /**
      * @brief Load the initial ledger, writing data to the queue
      *
+     * The key space is split into ranges that all sources having the ledger download concurrently. Sources that finish
+     * early take over part of the work of slower ones and ranges that failed are resumed by another source.
+     *
      * @param sequence sequence of ledger to download
+     * @param cacheOnly whether to only populate the cache without writing to the database
+     * @return edge keys of the downloaded ranges and whether the download succeeded
      */
     std::pair<std::vector<std::string>, bool>
     loadInitialLedger(uint32_t sequence, bool cacheOnly = false);
@@ -113,6 +127,28 @@ public:
     OptionalGetLedgerResponseType
     fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors);
 
+    /**
+     * @brief Fetch data for a batch of ledgers, keeping several requests in flight to one source
+     *
+     * Unlike fetchLedger, this function does not retry. A randomly chosen source that has the whole batch is used and
+     * the batch ends at the first ledger that could not be fetched; the caller is expected to fall back to fetchLedger
+     * for the remaining sequences.
+     *
+     * @param sequences sequences of ledgers to fetch, in the order they should be delivered
+     * @param maxInFlight max number of requests outstanding at any time
+     * @param getObjects if true, fetch diff between each ledger and the previous one
+     * @param getObjectNeighbors if true, fetch the neighbors of the changed objects
+     * @param onFetched called in order for each fetched ledger; returning false stops the batch
+     * @return the number of ledgers delivered to onFetched
+     */
+    std::size_t
+    fetchLedgers(
+        std::vector<uint32_t> const& sequences,
+        std::uint32_t maxInFlight,
+        bool getObjects,
+        bool getObjectNeighbors,
+        OnLedgerFetchedType onFetched);
+
     /**
      * @brief Determine whether messages received on the transactions_proposed stream should be forwarded to subscribing
      * clients.
@@ -133,7 +169,7 @@ public:
     toJson() const;
 
     /**
-     * @brief Forward a JSON RPC request to a randomly selected rippled node
+     * @brief Forward a JSON RPC request to a rippled node, preferring fast and healthy ones
      *
      * @param request JSON-RPC request
      * @return response received from rippled node
@@ -144,11 +180,11 @@ public:
 
 private:
     /**
-     * @brief Execute a function on a randomly selected source
+     * @brief Execute a function on a source picked by orderSources
      *
      * @note f is a function that takes an Source as an argument and returns a bool.
-     * Attempt to execute f for one randomly chosen Source that has the specified ledger. If f returns false, another
-     * randomly chosen Source is used. The process repeats until f returns true.
+     * Attempt to execute f for the preferred Source that has the specified ledger. If f returns false, the next Source
+     * in order is used. The process repeats until f returns true.
      *
      * @param f function to execute. This function takes the ETL source as an argument, and returns a bool.
      * @param ledgerSequence f is executed for each Source that has this ledger
@@ -158,4 +194,33 @@ private:
     template <class Func>
     bool
     execute(Func f, uint32_t ledgerSequence);
+
+    /**
+     * @brief Order in which sources should be tried for the given kind of request
+     *
+     * Uses the power of two choices: the cheaper of two randomly picked sources comes first, the remaining sources
+     * follow from cheapest to most expensive.
+     *
+     * @param kind Whose statistics to use for the cost of a source
+     * @return indexes into sources_
+     */
+    std::vector<std::size_t>
+    orderSources(RequestKind kind) const;
+
+    /**
+     * @brief Fetch a ledger from the given source, recording statistics and hedging if configured
+     */
+    std::pair<grpc::Status, GetLedgerResponseType>
+    fetchLedgerFrom(Source& source, uint32_t ledgerSequence, bool getObjects, bool getObjectNeighbors);
+
+    /**
+     * @brief Fetch a ledger from primary; if it is slow also ask secondary and take whichever answers first
+     */
+    std::pair<grpc::Status, GetLedgerResponseType>
+    fetchLedgerHedged(
+        Source& primary,
+        Source& secondary,
+        uint32_t ledgerSequence,
+        bool getObjects,
+        bool getObjectNeighbors);
 };
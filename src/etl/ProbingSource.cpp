@@ -105,12 +105,16 @@ ProbingSource::token() const
     return currentSrc_->token();
 }
 
-std::pair<std::vector<std::string>, bool>
-ProbingSource::loadInitialLedger(std::uint32_t ledgerSequence, std::uint32_t numMarkers, bool cacheOnly)
+bool
+ProbingSource::loadInitialLedger(
+    std::uint32_t ledgerSequence,
+    clio::detail::MarkerRangeQueue& queue,
+    std::uint32_t maxInFlight,
+    bool cacheOnly)
 {
     if (!currentSrc_)
-        return {{}, false};
-    return currentSrc_->loadInitialLedger(ledgerSequence, numMarkers, cacheOnly);
+        return false;
+    return currentSrc_->loadInitialLedger(ledgerSequence, queue, maxInFlight, cacheOnly);
 }
 
 std::pair<grpc::Status, ProbingSource::GetLedgerResponseType>
@@ -121,6 +125,34 @@ ProbingSource::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool getObj
     return currentSrc_->fetchLedger(ledgerSequence, getObjects, getObjectNeighbors);
 }
 
+std::size_t
+ProbingSource::fetchLedgers(
+    std::vector<uint32_t> const& sequences,
+    std::uint32_t maxInFlight,
+    bool getObjects,
+    bool getObjectNeighbors,
+    OnLedgerFetchedType onFetched)
+{
+    if (!currentSrc_)
+        return 0;
+    return currentSrc_->fetchLedgers(sequences, maxInFlight, getObjects, getObjectNeighbors, std::move(onFetched));
+}
+
+bool
+ProbingSource::startFetchLedger(clio::detail::AsyncLedgerCallData& call, grpc::CompletionQueue& cq)
+{
+    if (!currentSrc_)
+        return false;
+    return currentSrc_->startFetchLedger(call, cq);
+}
+
+clio::detail::SourceStats&
+ProbingSource::stats()
+{
+    // statistics are kept for the probing source as a whole so they survive switching between ws and wss
+    return stats_;
+}
+
 std::optional<boost::json::object>
 ProbingSource::forwardToRippled(
     boost::json::object const& request,
@@ -51,6 +51,7 @@ private:
     std::shared_ptr<Source> sslSrc_;
     std::shared_ptr<Source> plainSrc_;
     std::shared_ptr<Source> currentSrc_;
+    clio::detail::SourceStats stats_;
 
 public:
     /**
@@ -96,12 +97,30 @@ public:
     std::string
     toString() const override;
 
-    std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(std::uint32_t ledgerSequence, std::uint32_t numMarkers, bool cacheOnly = false) override;
+    bool
+    loadInitialLedger(
+        std::uint32_t ledgerSequence,
+        clio::detail::MarkerRangeQueue& queue,
+        std::uint32_t maxInFlight,
+        bool cacheOnly = false) override;
 
     std::pair<grpc::Status, GetLedgerResponseType>
     fetchLedger(uint32_t ledgerSequence, bool getObjects = true, bool getObjectNeighbors = false) override;
 
+    std::size_t
+    fetchLedgers(
+        std::vector<uint32_t> const& sequences,
+        std::uint32_t maxInFlight,
+        bool getObjects,
+        bool getObjectNeighbors,
+        OnLedgerFetchedType onFetched) override;
+
+    bool
+    startFetchLedger(clio::detail::AsyncLedgerCallData& call, grpc::CompletionQueue& cq) override;
+
+    clio::detail::SourceStats&
+    stats() override;
+
     std::optional<boost::json::object>
     forwardToRippled(boost::json::object const& request, std::string const& clientIp, boost::asio::yield_context& yield)
         const override;
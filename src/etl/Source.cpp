@@ -463,30 +463,37 @@ class AsyncCallData
     std::unique_ptr<grpc::ClientContext> context_;
 
     grpc::Status status_;
-    unsigned char nextPrefix_;
+    std::shared_ptr<clio::detail::MarkerRange> range_;
+    std::reference_wrapper<clio::detail::MarkerRangeQueue> queue_;
 
     std::string lastKey_;
 
 public:
-    AsyncCallData(uint32_t seq, ripple::uint256 const& marker, std::optional<ripple::uint256> const& nextMarker)
+    AsyncCallData(
+        uint32_t seq,
+        std::shared_ptr<clio::detail::MarkerRange> range,
+        clio::detail::MarkerRangeQueue& queue)
+        : range_{std::move(range)}, queue_{std::ref(queue)}
     {
         request_.mutable_ledger()->set_sequence(seq);
-        if (marker.isNonZero())
+        if (!range_->marker.empty())
         {
-            request_.set_marker(marker.data(), marker.size());
+            // resume a range that failed at another source
+            request_.set_marker(range_->marker);
+        }
+        else
+        {
+            ripple::uint256 marker;
+            marker.data()[0] = static_cast<unsigned char>(range_->begin.load());
+            if (marker.isNonZero())
+                request_.set_marker(marker.data(), marker.size());
         }
         request_.set_user("ETL");
-        nextPrefix_ = 0x00;
-        if (nextMarker)
-            nextPrefix_ = nextMarker->data()[0];
 
-        unsigned char prefix = marker.data()[0];
+        log_.debug() << "Setting up AsyncCallData. marker = " << ripple::strHex(request_.marker())
+                     << " . prefix = " << range_->begin << " . end = " << range_->end;
 
-        log_.debug() << "Setting up AsyncCallData. marker = " << ripple::strHex(marker)
-                     << " . prefix = " << ripple::strHex(std::string(1, prefix))
-                     << " . nextPrefix_ = " << ripple::strHex(std::string(1, nextPrefix_));
-
-        assert(nextPrefix_ > prefix || nextPrefix_ == 0x00);
+        assert(range_->begin < range_->end);
 
         cur_ = std::make_unique<org::xrpl::rpc::v1::GetLedgerDataResponse>();
         next_ = std::make_unique<org::xrpl::rpc::v1::GetLedgerDataResponse>();
@@ -524,21 +531,15 @@ public:
 
         std::swap(cur_, next_);
 
-        bool more = true;
-
-        // if no marker returned, we are done
-        if (cur_->marker().size() == 0)
-            more = false;
-
-        // if returned marker is greater than our end, we are done
-        unsigned char prefix = cur_->marker()[0];
-        if (nextPrefix_ != 0x00 && prefix >= nextPrefix_)
-            more = false;
+        // we are done if no marker was returned or if it is past our end. the end may have moved if part of the range
+        // was stolen by another source
+        std::uint16_t const end = queue_.get().advance(range_, cur_->marker());
+        bool const more = range_->begin < end;
 
         // if we are not done, make the next async call
         if (more)
         {
-            request_.set_marker(std::move(cur_->marker()));
+            request_.set_marker(std::move(*cur_->mutable_marker()));
             call(stub, cq);
         }
 
@@ -551,9 +552,9 @@ public:
         for (int i = 0; i < numObjects; ++i)
         {
             auto& obj = *(cur_->mutable_ledger_objects()->mutable_objects(i));
-            if (!more && nextPrefix_ != 0x00)
+            if (!more && end != clio::detail::MarkerRange::KEY_SPACE_END)
             {
-                if (((unsigned char)obj.key()[0]) >= nextPrefix_)
+                if (((unsigned char)obj.key()[0]) >= end)
                     continue;
             }
             cacheUpdates.push_back(
@@ -602,43 +603,50 @@ public:
     {
         return lastKey_;
     }
+
+    std::shared_ptr<clio::detail::MarkerRange> const&
+    getRange() const
+    {
+        return range_;
+    }
 };
 
 template <class Derived>
-std::pair<std::vector<std::string>, bool>
-SourceImpl<Derived>::loadInitialLedger(uint32_t sequence, uint32_t numMarkers, bool cacheOnly)
+bool
+SourceImpl<Derived>::loadInitialLedger(
+    uint32_t sequence,
+    clio::detail::MarkerRangeQueue& queue,
+    std::uint32_t maxInFlight,
+    bool cacheOnly)
 {
     if (!stub_)
-        return {{}, false};
+        return false;
 
     grpc::CompletionQueue cq;
     void* tag;
     bool ok = false;
-    std::vector<AsyncCallData> calls;
-    auto markers = getMarkers(numMarkers);
+    std::vector<std::unique_ptr<AsyncCallData>> calls;
 
-    for (size_t i = 0; i < markers.size(); ++i)
-    {
-        std::optional<ripple::uint256> nextMarker;
+    auto const startNext = [&]() {
+        auto range = queue.tryPop();
+        if (!range)
+            return false;
 
-        if (i + 1 < markers.size())
-            nextMarker = markers[i + 1];
-
-        calls.emplace_back(sequence, markers[i], nextMarker);
-    }
+        calls.push_back(std::make_unique<AsyncCallData>(sequence, std::move(range), queue));
+        calls.back()->call(stub_, cq);
+        return true;
+    };
 
     log_.debug() << "Starting data download for ledger " << sequence << ". Using source = " << toString();
 
-    for (auto& c : calls)
-        c.call(stub_, cq);
+    while (calls.size() < maxInFlight && startNext())
+        ;
 
-    size_t numFinished = 0;
     bool abort = false;
     size_t incr = 500000;
     size_t progress = incr;
-    std::vector<std::string> edgeKeys;
 
-    while (numFinished < calls.size() && cq.Next(&tag, &ok))
+    while (!calls.empty() && cq.Next(&tag, &ok))
     {
         assert(tag);
         auto ptr = static_cast<AsyncCallData*>(tag);
@@ -646,38 +654,44 @@ SourceImpl<Derived>::loadInitialLedger(uint32_t sequence, uint32_t numMarkers, b
         if (!ok)
         {
             log_.error() << "loadInitialLedger - ok is false";
-            return {{}, false};  // handle cancelled
+            abort = true;  // handle cancelled
         }
-        else
-        {
-            log_.trace() << "Marker prefix = " << ptr->getMarkerPrefix();
-
-            auto result = ptr->process(stub_, cq, *backend_, abort, cacheOnly);
-            if (result != AsyncCallData::CallStatus::MORE)
-            {
-                numFinished++;
-                log_.debug() << "Finished a marker. "
-                             << "Current number of finished = " << numFinished;
 
-                std::string lastKey = ptr->getLastKey();
+        log_.trace() << "Marker prefix = " << ptr->getMarkerPrefix();
 
-                if (lastKey.size())
-                    edgeKeys.push_back(ptr->getLastKey());
+        auto result = ok ? ptr->process(stub_, cq, *backend_, abort, cacheOnly) : AsyncCallData::CallStatus::ERRORED;
+        if (result != AsyncCallData::CallStatus::MORE)
+        {
+            if (result == AsyncCallData::CallStatus::DONE)
+            {
+                queue.finish(ptr->getRange(), ptr->getLastKey());
+                log_.debug() << "Finished a marker range. Ranges in flight at this source = " << calls.size() - 1;
             }
-
-            if (result == AsyncCallData::CallStatus::ERRORED)
-                abort = true;
-
-            if (backend_->cache().size() > progress)
+            else
             {
-                log_.info() << "Downloaded " << backend_->cache().size() << " records from rippled";
-                progress += incr;
+                // another source picks this range up from where we stopped
+                queue.retry(ptr->getRange(), ptr->getLastKey());
+                abort = true;
             }
+
+            calls.erase(std::find_if(
+                calls.begin(), calls.end(), [ptr](auto const& call) { return call.get() == ptr; }));
+
+            // pull more work as long as this source is healthy
+            if (!abort)
+                startNext();
+        }
+
+        if (backend_->cache().size() > progress)
+        {
+            log_.info() << "Downloaded " << backend_->cache().size() << " records from rippled";
+            progress += incr;
         }
     }
 
-    log_.info() << "Finished loadInitialLedger. cache size = " << backend_->cache().size();
-    return {std::move(edgeKeys), !abort};
+    log_.info() << "Finished loadInitialLedger at source = " << toString()
+                << ". cache size = " << backend_->cache().size();
+    return !abort;
 }
 
 template <class Derived>
@@ -708,6 +722,123 @@ SourceImpl<Derived>::fetchLedger(uint32_t ledgerSequence, bool getObjects, bool
     return {status, std::move(response)};
 }
 
+template <class Derived>
+bool
+SourceImpl<Derived>::startFetchLedger(clio::detail::AsyncLedgerCallData& call, grpc::CompletionQueue& cq)
+{
+    if (!stub_)
+        return false;
+
+    call.call(*stub_, cq);
+    return true;
+}
+
+template <class Derived>
+std::size_t
+SourceImpl<Derived>::fetchLedgers(
+    std::vector<uint32_t> const& sequences,
+    std::uint32_t maxInFlight,
+    bool getObjects,
+    bool getObjectNeighbors,
+    OnLedgerFetchedType onFetched)
+{
+    if (!stub_ || sequences.empty())
+        return 0;
+
+    auto const window = std::max(maxInFlight, 1u);
+    grpc::CompletionQueue cq;
+    std::vector<std::unique_ptr<clio::detail::AsyncLedgerCallData>> calls(sequences.size());
+
+    std::size_t numStarted = 0;
+    std::size_t numDelivered = 0;
+    std::size_t numOutstanding = 0;
+    bool stopped = false;
+
+    auto const startNext = [&]() {
+        auto& call = calls[numStarted];
+        call = std::make_unique<clio::detail::AsyncLedgerCallData>(
+            sequences[numStarted], getObjects, getObjectNeighbors);
+        call->call(*stub_, cq);
+        ++numStarted;
+        ++numOutstanding;
+    };
+
+    // cancel whatever is still in flight; the completion queue is drained below
+    auto const stop = [&]() {
+        stopped = true;
+        for (auto i = numDelivered; i < numStarted; ++i)
+        {
+            if (calls[i] && !calls[i]->done)
+                calls[i]->context.TryCancel();
+        }
+    };
+
+    log_.debug() << "Fetching " << sequences.size() << " ledgers starting at " << sequences.front() << " with up to "
+                 << window << " requests in flight. source = " << toString();
+
+    while (numStarted < sequences.size() && numStarted - numDelivered < window)
+        startNext();
+
+    void* tag;
+    bool ok = false;
+
+    while (numOutstanding > 0 && cq.Next(&tag, &ok))
+    {
+        assert(tag);
+        auto ptr = static_cast<clio::detail::AsyncLedgerCallData*>(tag);
+        ptr->done = true;
+        --numOutstanding;
+
+        if (!ok && ptr->status.ok())
+            ptr->status = {grpc::StatusCode::INTERNAL, "Completion queue reported failure"};
+
+        if (stopped)
+            continue;
+
+        // responses may complete out of order but are handed over strictly in the requested order
+        while (numDelivered < numStarted && calls[numDelivered]->done)
+        {
+            auto& call = calls[numDelivered];
+            if (!call->succeeded())
+            {
+                log_.warn() << "Could not fetch ledger " << call->sequence
+                            << ", error_code: " << call->status.error_code()
+                            << ", error_msg: " << call->status.error_message() << ", source = " << toString();
+                stop();
+                break;
+            }
+
+            if (!call->response.is_unlimited())
+            {
+                log_.warn() << "SourceImpl::fetchLedgers - is_unlimited is "
+                               "false. Make sure secure_gateway is set "
+                               "correctly on the ETL source. source = "
+                            << toString();
+            }
+
+            auto const keepGoing = onFetched(call->sequence, std::move(call->response));
+            call.reset();
+            ++numDelivered;
+
+            if (!keepGoing)
+            {
+                stop();
+                break;
+            }
+
+            if (numStarted < sequences.size())
+                startNext();
+        }
+    }
+
+    cq.Shutdown();
+    while (cq.Next(&tag, &ok))
+        ;
+
+    log_.debug() << "Delivered " << numDelivered << " of " << sequences.size() << " ledgers. source = " << toString();
+    return numDelivered;
+}
+
 template <class Derived>
 std::optional<boost::json::object>
 SourceImpl<Derived>::forwardToRippled(
@@ -22,7 +22,10 @@
 #include <backend/BackendInterface.h>
 #include <config/Config.h>
 #include <etl/ETLHelpers.h>
+#include <etl/impl/AsyncLedgerCallData.h>
 #include <etl/impl/ForwardCache.h>
+#include <etl/impl/MarkerRangeQueue.h>
+#include <etl/impl/SourceStats.h>
 #include <log/Logger.h>
 #include <subscriptions/SubscriptionManager.h>
 
@@ -55,6 +58,9 @@ class SubscriptionManager;
 class Source
 {
 public:
+    using GetLedgerResponseType = org::xrpl::rpc::v1::GetLedgerResponse;
+    using OnLedgerFetchedType = std::function<bool(uint32_t, GetLedgerResponseType&&)>;
+
     virtual bool
     isConnected() const = 0;
 
@@ -79,8 +85,26 @@ public:
     virtual std::pair<grpc::Status, org::xrpl::rpc::v1::GetLedgerResponse>
     fetchLedger(uint32_t ledgerSequence, bool getObjects = true, bool getObjectNeighbors = false) = 0;
 
-    virtual std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(uint32_t sequence, std::uint32_t numMarkers, bool cacheOnly = false) = 0;
+    virtual std::size_t
+    fetchLedgers(
+        std::vector<uint32_t> const& sequences,
+        std::uint32_t maxInFlight,
+        bool getObjects,
+        bool getObjectNeighbors,
+        OnLedgerFetchedType onFetched) = 0;
+
+    virtual bool
+    startFetchLedger(clio::detail::AsyncLedgerCallData& call, grpc::CompletionQueue& cq) = 0;
+
+    virtual clio::detail::SourceStats&
+    stats() = 0;
+
+    virtual bool
+    loadInitialLedger(
+        uint32_t sequence,
+        clio::detail::MarkerRangeQueue& queue,
+        std::uint32_t maxInFlight,
+        bool cacheOnly = false) = 0;
 
     virtual std::optional<boost::json::object>
     forwardToRippled(boost::json::object const& request, std::string const& clientIp, boost::asio::yield_context& yield)
@@ -155,6 +179,7 @@ class SourceImpl : public Source
     LoadBalancer& balancer_;
 
     clio::detail::ForwardCache forwardCache_;
+    clio::detail::SourceStats stats_;
     boost::uuids::uuid uuid_;
 
 protected:
@@ -342,6 +367,46 @@ public:
     std::pair<grpc::Status, org::xrpl::rpc::v1::GetLedgerResponse>
     fetchLedger(uint32_t ledgerSequence, bool getObjects = true, bool getObjectNeighbors = false) override;
 
+    /**
+     * @brief Fetch several ledgers keeping up to maxInFlight GetLedger requests outstanding at any time
+     *
+     * Requests are issued asynchronously on a completion queue and the responses are handed to onFetched strictly in
+     * the order of sequences. The first failed or unvalidated response ends the batch.
+     *
+     * @param sequences sequences of the ledgers to fetch, in the order they should be delivered
+     * @param maxInFlight max number of requests that are issued but not yet delivered
+     * @param getObjects whether to get the account state diff between each ledger and the prior one
+     * @param getObjectNeighbors whether to request the neighbors of the changed objects
+     * @param onFetched called for each fetched ledger; returning false stops the batch
+     * @return the number of ledgers delivered to onFetched
+     */
+    std::size_t
+    fetchLedgers(
+        std::vector<uint32_t> const& sequences,
+        std::uint32_t maxInFlight,
+        bool getObjects,
+        bool getObjectNeighbors,
+        OnLedgerFetchedType onFetched) override;
+
+    /**
+     * @brief Start an asynchronous GetLedger request on the given completion queue
+     *
+     * @param call State of the request; used as the completion queue tag
+     * @param cq The completion queue to run the request on
+     * @return true if the request was started; false if this source has no gRPC endpoint
+     */
+    bool
+    startFetchLedger(clio::detail::AsyncLedgerCallData& call, grpc::CompletionQueue& cq) override;
+
+    /**
+     * @return Latency and error statistics of requests sent to this source
+     */
+    clio::detail::SourceStats&
+    stats() override
+    {
+        return stats_;
+    }
+
     /**
      * @brief Produces a human-readable string with info about the source
      */
@@ -377,14 +442,23 @@ public:
     }
 
     /**
-     * @brief Download a ledger in full
+     * @brief Download key ranges of a ledger, pulling them from a queue shared with other sources
+     *
+     * Ranges are pulled from the queue until it is exhausted. On error the affected ranges are put back on the queue
+     * so that another source can resume them, and this source stops pulling new ranges.
      *
      * @param ledgerSequence sequence of the ledger to download
-     * @param writeQueue queue to push downloaded ledger objects
-     * @return true if the download was successful
+     * @param queue ranges of the key space left to download
+     * @param maxInFlight max number of ranges downloaded concurrently by this source
+     * @param cacheOnly whether to only populate the cache without writing to the database
+     * @return true if every range this source took was downloaded successfully
      */
-    std::pair<std::vector<std::string>, bool>
-    loadInitialLedger(std::uint32_t ledgerSequence, std::uint32_t numMarkers, bool cacheOnly = false) override;
+    bool
+    loadInitialLedger(
+        std::uint32_t ledgerSequence,
+        clio::detail::MarkerRangeQueue& queue,
+        std::uint32_t maxInFlight,
+        bool cacheOnly = false) override;
 
     /**
      * @brief Attempt to reconnect to the ETL source
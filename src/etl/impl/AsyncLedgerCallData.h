@@ -0,0 +1,76 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
+#include <grpcpp/grpcpp.h>
+
+#include <chrono>
+#include <memory>
+
+namespace clio::detail {
+
+/**
+ * @brief State of a single GetLedger request issued on a completion queue
+ *
+ * The address of the instance is used as the completion queue tag, so it must stay in place until the request
+ * completes.
+ */
+struct AsyncLedgerCallData
+{
+    uint32_t sequence;
+    org::xrpl::rpc::v1::GetLedgerRequest request;
+    org::xrpl::rpc::v1::GetLedgerResponse response;
+    grpc::ClientContext context;
+    grpc::Status status;
+    std::unique_ptr<grpc::ClientAsyncResponseReader<org::xrpl::rpc::v1::GetLedgerResponse>> rpc;
+    std::chrono::steady_clock::time_point startTime;
+    bool done = false;
+
+    AsyncLedgerCallData(uint32_t seq, bool getObjects, bool getObjectNeighbors) : sequence{seq}
+    {
+        request.mutable_ledger()->set_sequence(sequence);
+        request.set_transactions(true);
+        request.set_expand(true);
+        request.set_get_objects(getObjects);
+        request.set_get_object_neighbors(getObjectNeighbors);
+        request.set_user("ETL");
+    }
+
+    void
+    call(org::xrpl::rpc::v1::XRPLedgerAPIService::Stub& stub, grpc::CompletionQueue& cq)
+    {
+        startTime = std::chrono::steady_clock::now();
+        rpc = stub.PrepareAsyncGetLedger(&context, request, &cq);
+        rpc->StartCall();
+        rpc->Finish(&response, &status, this);
+    }
+
+    /**
+     * @return true if the request completed with a validated ledger
+     */
+    bool
+    succeeded() const
+    {
+        return done && status.ok() && response.validated();
+    }
+};
+
+}  // namespace clio::detail
@@ -19,17 +19,22 @@
 
 #pragma once
 
+#include <backend/CachePage.h>
 #include <log/Logger.h>
 
 #include <ripple/ledger/ReadView.h>
 #include <boost/algorithm/string.hpp>
+#include <boost/asio/async_result.hpp>
 #include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include <boost/beast/core.hpp>
 #include <boost/beast/core/string.hpp>
+#include <boost/beast/http.hpp>
 #include <boost/beast/websocket.hpp>
 #include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <algorithm>
 #include <chrono>
 #include <mutex>
 #include <thread>
@@ -68,6 +73,9 @@ class CacheLoader
 
     std::vector<ClioPeer> clioPeers_;
 
+    // number of key ranges downloaded in parallel, each over its own connection, when loading the cache from a peer
+    size_t numPeerRanges_ = 16;
+
     std::thread thread_;
     std::atomic_bool stopping_ = false;
 
@@ -95,6 +103,7 @@ public:
             numCacheDiffs_ = cache.valueOr<size_t>("num_diffs", numCacheDiffs_);
             numCacheMarkers_ = cache.valueOr<size_t>("num_markers", numCacheMarkers_);
             cachePageFetchSize_ = cache.valueOr<size_t>("page_fetch_size", cachePageFetchSize_);
+            numPeerRanges_ = std::clamp<size_t>(cache.valueOr<size_t>("num_peer_ranges", numPeerRanges_), 1, 1 << 16);
 
             if (auto peers = cache.maybeArray("peers"); peers)
             {
@@ -147,8 +156,11 @@ public:
             boost::asio::spawn(ioContext_.get(), [this, seq](boost::asio::yield_context yield) {
                 for (auto const& peer : clioPeers_)
                 {
-                    // returns true on success
-                    if (loadCacheFromClioPeer(seq, peer.ip, std::to_string(peer.port), yield))
+                    auto const port = std::to_string(peer.port);
+
+                    // returns true on success. peers running an older version only support ledger_data
+                    if (loadCacheFromClioPeerBinary(seq, peer.ip, port, yield) or
+                        loadCacheFromClioPeer(seq, peer.ip, port, yield))
                         return;
                 }
 
@@ -179,6 +191,204 @@ public:
     }
 
 private:
+    /**
+     * @brief Download the cache from a peer in binary form, over several connections in parallel
+     *
+     * The key space is split into numPeerRanges_ ranges which are paged through concurrently. Every page is verified
+     * before it is written to the cache (see Backend::CachePage).
+     *
+     * @return true if the whole ledger was downloaded
+     */
+    bool
+    loadCacheFromClioPeerBinary(
+        uint32_t ledgerIndex,
+        std::string const& ip,
+        std::string const& port,
+        boost::asio::yield_context& yield)
+    {
+        log_.info() << "Loading cache from peer in binary form. ip = " << ip << " . port = " << port
+                    << " . ranges = " << numPeerRanges_;
+
+        // the ranges still downloading; the last one to finish wakes the coroutine waiting for all of them
+        struct Join
+        {
+            std::mutex mtx;
+            std::size_t remaining;
+            boost::asio::steady_timer timer;
+
+            Join(std::size_t count, boost::asio::any_io_executor const& executor)
+                : remaining{count}, timer{executor, std::chrono::steady_clock::time_point::max()}
+            {
+            }
+        };
+
+        auto const startTime = std::chrono::system_clock::now();
+        auto const join = std::make_shared<Join>(numPeerRanges_, yield.get_executor());
+        auto failed = std::make_shared<std::atomic_bool>(false);
+
+        for (size_t i = 0; i < numPeerRanges_; ++i)
+        {
+            auto const from = rangeStart(i);
+            auto const to = i + 1 < numPeerRanges_ ? std::optional{rangeStart(i + 1)} : std::nullopt;
+
+            boost::asio::spawn(
+                ioContext_.get(),
+                [this, ledgerIndex, ip, port, from, to, join, failed](boost::asio::yield_context yield) {
+                    if (!loadCacheRangeFromClioPeer(ledgerIndex, ip, port, from, to, *failed, yield))
+                        *failed = true;
+
+                    std::scoped_lock lck{join->mtx};
+                    if (--join->remaining == 0)
+                        join->timer.cancel();
+                });
+        }
+
+        boost::system::error_code ec;
+        auto token = yield[ec];
+        boost::asio::async_initiate<boost::asio::yield_context, void(boost::system::error_code)>(
+            [join](auto&& handler) {
+                // the wait starts under the lock the last range cancels the timer under, so that it can not be missed
+                std::scoped_lock lck{join->mtx};
+                if (join->remaining == 0)
+                    join->timer.expires_at(std::chrono::steady_clock::time_point::min());
+
+                join->timer.async_wait(std::move(handler));
+            },
+            token);
+
+        if (*failed || stopping_)
+            return false;
+
+        auto const duration =
+            std::chrono::duration_cast<std::chrono::seconds>(std::chrono::system_clock::now() - startTime);
+        log_.info() << "Finished downloading ledger from clio node in binary form. ip = " << ip
+                    << " . took = " << duration.count() << " seconds";
+
+        cache_.get().setFull();
+        return true;
+    }
+
+    /**
+     * @return The first key of the i-th of numPeerRanges_ equally sized ranges of the key space
+     */
+    ripple::uint256
+    rangeStart(size_t i) const
+    {
+        auto const prefix = i * (1 << 16) / numPeerRanges_;
+        auto key = Backend::firstKey;
+        key.data()[0] = static_cast<unsigned char>(prefix >> 8);
+        key.data()[1] = static_cast<unsigned char>(prefix);
+        return key;
+    }
+
+    bool
+    loadCacheRangeFromClioPeer(
+        uint32_t ledgerIndex,
+        std::string const& ip,
+        std::string const& port,
+        ripple::uint256 const& from,
+        std::optional<ripple::uint256> const& to,
+        std::atomic_bool const& failed,
+        boost::asio::yield_context& yield)
+    {
+        namespace beast = boost::beast;
+        namespace http = beast::http;
+        using tcp = boost::asio::ip::tcp;
+
+        try
+        {
+            beast::error_code ec;
+            tcp::resolver resolver{ioContext_.get()};
+            beast::tcp_stream stream{ioContext_.get()};
+
+            auto const results = resolver.async_resolve(ip, port, yield[ec]);
+            if (ec)
+                return false;
+
+            stream.async_connect(results, yield[ec]);
+            if (ec)
+                return false;
+
+            beast::flat_buffer buffer;
+            std::optional<ripple::uint256> cursor = from;
+            size_t numAttempts = 0;
+            while (cursor && not stopping_ && not failed)
+            {
+                Backend::CachePage::Request const request{ledgerIndex, *cursor, to};
+                http::request<http::empty_body> req{http::verb::get, request.target(), 11};
+                req.set(http::field::host, ip);
+                req.keep_alive(true);
+
+                stream.expires_after(std::chrono::seconds(30));
+                http::async_write(stream, req, yield[ec]);
+                if (ec)
+                {
+                    log_.error() << "error writing = " << ec.message();
+                    return false;
+                }
+
+                http::response_parser<http::string_body> parser;
+                parser.body_limit(Backend::CachePage::MAX_SERIALIZED_BYTES);
+                http::async_read(stream, buffer, parser, yield[ec]);
+                if (ec)
+                {
+                    log_.error() << "error reading = " << ec.message();
+                    return false;
+                }
+
+                auto const& response = parser.get();
+                if (response.result() == http::status::service_unavailable)
+                {
+                    if (++numAttempts >= 5)
+                    {
+                        log_.error() << "Ledger not in cache of peer after 5 attempts. peer = " << ip
+                                     << " ledger = " << ledgerIndex << ". Check your config and the health of the peer";
+                        return false;
+                    }
+
+                    log_.warn() << "Ledger not in cache of peer. ledger = " << ledgerIndex
+                                << ". Sleeping and trying again";
+                    boost::asio::steady_timer timer{ioContext_.get(), std::chrono::seconds(1)};
+                    timer.async_wait(yield[ec]);
+                    continue;
+                }
+
+                if (response.result() == http::status::conflict)
+                {
+                    log_.info() << "Peer no longer stores the ledger to load. ip = " << ip
+                                << " . ledger = " << ledgerIndex;
+                    return false;
+                }
+
+                if (response.result() != http::status::ok)
+                {
+                    log_.info() << "Peer does not serve the cache in binary form. ip = " << ip
+                                << " . status = " << response.result_int();
+                    return false;
+                }
+
+                auto const page = Backend::CachePage::deserialize(response.body(), ledgerIndex);
+                if (!page)
+                {
+                    log_.error() << "Received a corrupted cache page from peer. ip = " << ip
+                                 << " . cursor = " << ripple::strHex(*cursor);
+                    return false;
+                }
+
+                cache_.get().update(page->objects, ledgerIndex, true);
+                cursor = page->cursor;
+            }
+
+            stream.socket().shutdown(tcp::socket::shutdown_both, ec);
+            return not cursor.has_value();
+        }
+        catch (std::exception const& e)
+        {
+            log_.error() << "Encountered exception : " << e.what() << " - ip = " << ip;
+            return false;
+        }
+    }
+
     bool
     loadCacheFromClioPeer(
         uint32_t ledgerIndex,
@@ -25,9 +25,11 @@
 
 #include <ripple/beast/core/CurrentThreadName.h>
 
+#include <algorithm>
 #include <chrono>
 #include <mutex>
 #include <thread>
+#include <vector>
 
 namespace clio::detail {
 
@@ -45,23 +47,31 @@ class Extractor
     uint32_t startSequence_;
     std::optional<uint32_t> finishSequence_;
     std::reference_wrapper<SystemState const> state_;  // shared state for ETL
+    uint32_t maxInFlight_;
 
     std::thread thread_;
 
 public:
+    /**
+     * @brief Max number of ledgers fetched as one pipelined batch, expressed in multiples of maxInFlight
+     */
+    constexpr static auto BATCH_SIZE_FACTOR = 4u;
+
     Extractor(
         DataPipeType& pipe,
         std::shared_ptr<NetworkValidatedLedgersType> networkValidatedLedgers,
         LedgerFetcherType& ledgerFetcher,
         uint32_t startSequence,
         std::optional<uint32_t> finishSequence,
-        SystemState const& state)
+        SystemState const& state,
+        uint32_t maxInFlight = 1)
         : pipe_(std::ref(pipe))
         , networkValidatedLedgers_{networkValidatedLedgers}
         , ledgerFetcher_{std::ref(ledgerFetcher)}
         , startSequence_{startSequence}
         , finishSequence_{finishSequence}
         , state_{std::cref(state)}
+        , maxInFlight_{std::max(maxInFlight, 1u)}
     {
         thread_ = std::thread([this]() { process(); });
     }
@@ -90,6 +100,16 @@ private:
 
         while (!shouldFinish(currentSequence) && networkValidatedLedgers_->waitUntilValidatedByNetwork(currentSequence))
         {
+            // when catching up there are several validated ledgers ahead of us; keep multiple requests in flight
+            if (maxInFlight_ > 1)
+            {
+                if (auto const numFetched = fetchPipelined(currentSequence, totalTime); numFetched > 0)
+                {
+                    currentSequence += numFetched * pipe_.get().getStride();
+                    continue;
+                }
+            }
+
             auto [fetchResponse, time] = util::timed<std::chrono::duration<double>>(
                 [this, currentSequence]() { return ledgerFetcher_.get().fetchDataAndDiff(currentSequence); });
             totalTime += time;
@@ -114,6 +134,47 @@ private:
         pipe_.get().finish(startSequence_);
     }
 
+    /**
+     * @brief Fetch a batch of already validated ledgers starting at the given sequence and push them to the pipe
+     *
+     * @return the number of ledgers pushed; 0 if there is nothing to pipeline or the batch failed
+     */
+    std::size_t
+    fetchPipelined(uint32_t currentSequence, double& totalTime)
+    {
+        auto const stride = pipe_.get().getStride();
+        auto const mostRecent = networkValidatedLedgers_->getMostRecent();
+        if (!mostRecent)
+            return 0;
+
+        std::vector<uint32_t> sequences;
+        for (auto seq = currentSequence; seq <= *mostRecent && !(finishSequence_ && seq > *finishSequence_) &&
+             sequences.size() < maxInFlight_ * BATCH_SIZE_FACTOR;
+             seq += stride)
+            sequences.push_back(seq);
+
+        // a single ledger gains nothing from pipelining and is fetched with retries by the caller
+        if (sequences.size() < 2)
+            return 0;
+
+        auto lastDelivery = std::chrono::steady_clock::now();
+        return ledgerFetcher_.get().fetchDataAndDiffPipelined(
+            sequences, maxInFlight_, [this, &lastDelivery, &totalTime, stride](uint32_t seq, auto&& response) {
+                auto const now = std::chrono::steady_clock::now();
+                auto const time = std::chrono::duration<double>(now - lastDelivery).count();
+                lastDelivery = now;
+                totalTime += time;
+
+                log_.info() << "Extract phase time = " << time << "; Extract phase tps = "
+                            << response.transactions_list().transactions_size() / time
+                            << "; Avg extract time = " << totalTime / (seq - startSequence_ + 1) << "; seq = " << seq
+                            << " (pipelined)";
+
+                pipe_.get().push(seq, std::move(response));
+                return !shouldFinish(seq + stride);
+            });
+    }
+
     bool
     isStopping() const
     {
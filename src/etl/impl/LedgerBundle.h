@@ -0,0 +1,45 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <backend/Types.h>
+
+#include <ripple/ledger/ReadView.h>
+
+#include <optional>
+#include <vector>
+
+namespace clio::detail {
+
+/**
+ * @brief Everything needed to publish a ledger
+ *
+ * The writer fills this in from the data it just extracted so that publishing does not read the ledger back from the
+ * database. Parts that are not set are fetched from the database by the publisher.
+ */
+struct LedgerBundle
+{
+    ripple::LedgerInfo lgrInfo;
+    std::optional<ripple::Fees> fees;
+    std::optional<std::vector<Backend::TransactionAndMetadata>> transactions;
+    std::optional<std::vector<Backend::LedgerObject>> objects;  // objects changed by the ledger; empty blob if deleted
+};
+
+}  // namespace clio::detail
@@ -0,0 +1,400 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <etl/impl/LedgerBundle.h>
+#include <util/BinaryUtils.h>
+#include <util/LedgerUtils.h>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cstring>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace clio::detail {
+
+/**
+ * @brief Ledgers recently committed by the writer, kept for read-only nodes to pick up without polling the database
+ *
+ * Each ledger is kept in the binary form it is served in: the serialized header, the objects changed by the ledger as
+ * frames of 32 byte key, 4 byte big endian size and data (empty for deleted objects), the transactions as size
+ * prefixed transaction and metadata blobs, and finally a CRC32 of everything before it.
+ */
+class LedgerFeed
+{
+public:
+    /**
+     * @brief HTTP target under which a Clio node serves the ledgers it committed
+     */
+    static constexpr std::string_view TARGET = "/ledger_feed";
+
+    /**
+     * @brief How long a request for a ledger that is not committed yet is held before answering with no content
+     */
+    static constexpr std::chrono::milliseconds MAX_WAIT{1000};
+
+private:
+    std::size_t capacity_;
+    std::deque<std::pair<uint32_t, std::shared_ptr<std::string const>>> ledgers_;
+    // timers of the coroutines waiting for a ledger to be added; cancelled by add
+    mutable std::vector<std::weak_ptr<boost::asio::steady_timer>> waiters_;
+    mutable std::shared_mutex mtx_;
+
+public:
+    /**
+     * @brief Create an instance of the feed
+     *
+     * @param capacity Number of ledgers to keep; 0 disables the feed
+     */
+    explicit LedgerFeed(std::size_t capacity = 0) : capacity_{capacity}
+    {
+    }
+
+    /**
+     * @return true if ledgers are kept and served to read-only nodes
+     */
+    bool
+    isEnabled() const
+    {
+        return capacity_ > 0;
+    }
+
+    /**
+     * @brief Add a committed ledger to the feed, evicting the oldest ledger if the feed is full
+     *
+     * Ledgers that do not follow the latest ledger in the feed replace its content, so the feed never has gaps.
+     *
+     * @param bundle The ledger; must carry its objects and transactions
+     */
+    void
+    add(LedgerBundle const& bundle)
+    {
+        if (!isEnabled() || !bundle.objects || !bundle.transactions)
+            return;
+
+        auto data = std::make_shared<std::string const>(serialize(bundle));
+
+        std::scoped_lock lck{mtx_};
+        if (!ledgers_.empty() && ledgers_.back().first + 1 != bundle.lgrInfo.seq)
+            ledgers_.clear();
+
+        ledgers_.emplace_back(bundle.lgrInfo.seq, std::move(data));
+        if (ledgers_.size() > capacity_)
+            ledgers_.pop_front();
+
+        for (auto const& waiter : waiters_)
+        {
+            if (auto const timer = waiter.lock(); timer)
+                timer->cancel();
+        }
+        waiters_.clear();
+    }
+
+    /**
+     * @brief Suspend a coroutine until a ledger is added to the feed or the deadline passes
+     *
+     * Returns right away if the feed already has the given ledger or a later one.
+     *
+     * @param sequence The ledger waited for
+     * @param deadline When to stop waiting
+     * @param yield The coroutine to suspend
+     */
+    void
+    wait(uint32_t sequence, std::chrono::steady_clock::time_point deadline, boost::asio::yield_context yield) const
+    {
+        auto const timer = std::make_shared<boost::asio::steady_timer>(yield.get_executor(), deadline);
+        boost::system::error_code ec;
+        auto token = yield[ec];
+        boost::asio::async_initiate<boost::asio::yield_context, void(boost::system::error_code)>(
+            [this, sequence, timer](auto&& handler) {
+                // the wait starts under the lock add cancels the timers under, so that it can not miss a ledger
+                std::scoped_lock lck{mtx_};
+                if (!ledgers_.empty() && ledgers_.back().first >= sequence)
+                {
+                    timer->expires_at(std::chrono::steady_clock::time_point::min());
+                }
+                else
+                {
+                    std::erase_if(waiters_, [](auto const& waiter) { return waiter.expired(); });
+                    waiters_.push_back(timer);
+                }
+
+                timer->async_wait(std::move(handler));
+            },
+            token);
+    }
+
+    /**
+     * @param sequence The ledger to look for
+     * @return The ledger in binary form, or nullptr if it is not in the feed
+     */
+    std::shared_ptr<std::string const>
+    get(uint32_t sequence) const
+    {
+        std::shared_lock lck{mtx_};
+        if (ledgers_.empty() || sequence < ledgers_.front().first || sequence > ledgers_.back().first)
+            return nullptr;
+
+        return ledgers_[sequence - ledgers_.front().first].second;
+    }
+
+    /**
+     * @return The latest ledger in the feed, if any
+     */
+    std::optional<uint32_t>
+    latestSequence() const
+    {
+        std::shared_lock lck{mtx_};
+        if (ledgers_.empty())
+            return {};
+
+        return ledgers_.back().first;
+    }
+
+    /**
+     * @return The HTTP target to request the given ledger
+     */
+    static std::string
+    target(uint32_t sequence)
+    {
+        return std::string{TARGET} + "?ledger=" + std::to_string(sequence);
+    }
+
+    /**
+     * @brief Parse a HTTP target created by target()
+     *
+     * @return The requested ledger or an empty optional if the target is malformed
+     */
+    static std::optional<uint32_t>
+    parseTarget(std::string_view target)
+    {
+        static constexpr std::string_view prefix = "?ledger=";
+        if (!target.starts_with(TARGET) || !target.substr(TARGET.size()).starts_with(prefix))
+            return {};
+
+        auto const value = target.substr(TARGET.size() + prefix.size());
+        uint32_t sequence = 0;
+        auto const [end, ec] = std::from_chars(value.data(), value.data() + value.size(), sequence);
+        if (ec != std::errc{} || end != value.data() + value.size())
+            return {};
+
+        return sequence;
+    }
+
+    /**
+     * @brief Serialize a ledger in the form it is served in
+     *
+     * @param bundle The ledger; the objects and transactions that are not set are serialized as empty
+     */
+    static std::string
+    serialize(LedgerBundle const& bundle)
+    {
+        static std::vector<Backend::LedgerObject> const noObjects;
+        static std::vector<Backend::TransactionAndMetadata> const noTransactions;
+        auto const& objects = bundle.objects ? *bundle.objects : noObjects;
+        auto const& transactions = bundle.transactions ? *bundle.transactions : noTransactions;
+
+        auto const header = util::serializeHeader(bundle.lgrInfo);
+
+        std::size_t size = 4 + header.size() + 4 + 4 + 4;
+        for (auto const& obj : objects)
+            size += KEY_SIZE + 4 + obj.blob.size();
+        for (auto const& tx : transactions)
+            size += 4 + tx.transaction.size() + 4 + tx.metadata.size();
+
+        std::string out;
+        out.reserve(size);
+
+        util::putUInt32(out, header.size());
+        out.append(header);
+
+        util::putUInt32(out, objects.size());
+        for (auto const& obj : objects)
+        {
+            out.append(reinterpret_cast<char const*>(obj.key.data()), KEY_SIZE);
+            putBlob(out, obj.blob);
+        }
+
+        util::putUInt32(out, transactions.size());
+        for (auto const& tx : transactions)
+        {
+            putBlob(out, tx.transaction);
+            putBlob(out, tx.metadata);
+        }
+
+        util::putUInt32(out, util::checksum(out));
+        return out;
+    }
+
+    /**
+     * @brief Deserialize and verify a ledger received from the feed
+     *
+     * @return The ledger with its objects and transactions, or an empty optional if the data is truncated or corrupted
+     */
+    static std::optional<LedgerBundle>
+    deserialize(std::string_view data)
+    {
+        if (data.size() < 4)
+            return {};
+
+        auto const payload = data.substr(0, data.size() - 4);
+        if (util::checksum(payload) != util::getUInt32(data, payload.size()))
+            return {};
+
+        Reader reader{payload};
+
+        auto const header = reader.blob();
+        if (!header)
+            return {};
+
+        LedgerBundle bundle;
+        try
+        {
+            bundle.lgrInfo = util::deserializeHeader(ripple::Slice{header->data(), header->size()});
+        }
+        catch (std::exception const&)
+        {
+            return {};
+        }
+
+        auto const numObjects = reader.uint32();
+        if (!numObjects)
+            return {};
+
+        bundle.objects.emplace();
+        for (uint32_t i = 0; i < *numObjects; ++i)
+        {
+            auto const key = reader.bytes(KEY_SIZE);
+            if (!key)
+                return {};
+
+            auto const blob = reader.blob();
+            if (!blob)
+                return {};
+
+            auto& obj = bundle.objects->emplace_back();
+            std::memcpy(obj.key.data(), key->data(), KEY_SIZE);
+            obj.blob.assign(blob->begin(), blob->end());
+        }
+
+        auto const numTransactions = reader.uint32();
+        if (!numTransactions)
+            return {};
+
+        bundle.transactions.emplace();
+        for (uint32_t i = 0; i < *numTransactions; ++i)
+        {
+            auto const transaction = reader.blob();
+            if (!transaction)
+                return {};
+
+            auto const metadata = reader.blob();
+            if (!metadata)
+                return {};
+
+            auto& tx = bundle.transactions->emplace_back();
+            tx.transaction.assign(transaction->begin(), transaction->end());
+            tx.metadata.assign(metadata->begin(), metadata->end());
+            tx.ledgerSequence = bundle.lgrInfo.seq;
+            tx.date = bundle.lgrInfo.closeTime.time_since_epoch().count();
+        }
+
+        if (!reader.done())
+            return {};
+
+        return bundle;
+    }
+
+private:
+    static constexpr std::size_t KEY_SIZE = ripple::uint256::size();
+
+    /**
+     * @brief Bounds checked sequential reads from serialized data
+     */
+    class Reader
+    {
+        std::string_view data_;
+
+    public:
+        explicit Reader(std::string_view data) : data_{data}
+        {
+        }
+
+        std::optional<std::string_view>
+        bytes(std::size_t size)
+        {
+            if (data_.size() < size)
+                return {};
+
+            auto const result = data_.substr(0, size);
+            data_.remove_prefix(size);
+            return result;
+        }
+
+        std::optional<uint32_t>
+        uint32()
+        {
+            auto const raw = bytes(4);
+            if (!raw)
+                return {};
+
+            return util::getUInt32(*raw, 0);
+        }
+
+        std::optional<std::string_view>
+        blob()
+        {
+            auto const size = uint32();
+            if (!size)
+                return {};
+
+            return bytes(*size);
+        }
+
+        bool
+        done() const
+        {
+            return data_.empty();
+        }
+    };
+
+    template <typename Blob>
+    static void
+    putBlob(std::string& out, Blob const& blob)
+    {
+        util::putUInt32(out, blob.size());
+        out.append(reinterpret_cast<char const*>(blob.data()), blob.size());
+    }
+};
+
+}  // namespace clio::detail
@@ -0,0 +1,216 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <config/Config.h>
+#include <etl/impl/LedgerBundle.h>
+#include <etl/impl/LedgerFeed.h>
+#include <log/Logger.h>
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/http.hpp>
+
+#include <chrono>
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace clio::detail {
+
+/**
+ * @brief Receives committed ledgers from the ledger feed of the writer (see LedgerFeed)
+ *
+ * Used by read-only nodes to learn about new ledgers without polling the database. Requests for a ledger that is not
+ * committed yet are held by the writer until it is, so a ledger is received as soon as it is written. Peers that fail
+ * or do not have the ledger are skipped in turn; the caller is expected to fall back to the database.
+ *
+ * The connection to the current peer is kept open between ledgers. Fetches run on an io_context of the client, run by
+ * the thread calling fetch, so the connection lives on between them; fetch must not be called concurrently.
+ */
+class LedgerFeedClient
+{
+    struct Peer
+    {
+        std::string ip;
+        std::string port;
+    };
+
+    struct Connection
+    {
+        boost::beast::tcp_stream stream;
+        boost::beast::flat_buffer buffer;
+
+        explicit Connection(boost::asio::io_context& ioc) : stream{ioc}
+        {
+        }
+    };
+
+    clio::Logger log_{"ETL"};
+    std::vector<Peer> peers_;
+    std::size_t current_ = 0;
+    boost::asio::io_context ioc_;
+    // the connection to the current peer, if open; declared after ioc_ so that it is destroyed first
+    std::unique_ptr<Connection> connection_;
+
+public:
+    /**
+     * @brief Create an instance of the client
+     *
+     * @param config The configuration to read the "ledger_feed" section from
+     */
+    explicit LedgerFeedClient(clio::Config const& config)
+    {
+        if (config.contains("ledger_feed"))
+        {
+            if (auto peers = config.section("ledger_feed").maybeArray("peers"); peers)
+            {
+                for (auto const& peer : *peers)
+                    peers_.push_back({peer.value<std::string>("ip"), std::to_string(peer.value<uint32_t>("port"))});
+            }
+        }
+    }
+
+    /**
+     * @return true if peers to receive ledgers from are configured
+     */
+    bool
+    isEnabled() const
+    {
+        return !peers_.empty();
+    }
+
+    /**
+     * @brief Wait for the given ledger to be committed by the writer and receive it
+     *
+     * Blocks for at most about LedgerFeed::MAX_WAIT.
+     *
+     * @param sequence The ledger to receive
+     * @return The ledger with its objects and transactions, or nullptr if it was not received
+     */
+    std::shared_ptr<LedgerBundle const>
+    fetch(uint32_t sequence)
+    {
+        if (!isEnabled())
+            return nullptr;
+
+        auto const& peer = peers_[current_];
+        std::pair<std::shared_ptr<LedgerBundle const>, bool> result;
+        boost::asio::spawn(
+            ioc_, [&](boost::asio::yield_context yield) { result = fetchFrom(peer, sequence, yield); });
+
+        // run returns once the fetch is done; the context has to be restarted before it can run again
+        ioc_.restart();
+        ioc_.run();
+
+        auto const& [bundle, available] = result;
+        if (!available)
+        {
+            connection_.reset();
+            current_ = (current_ + 1) % peers_.size();
+        }
+
+        return bundle;
+    }
+
+private:
+    /**
+     * @return The ledger, if received, and whether the peer can be asked for the following ledgers
+     */
+    std::pair<std::shared_ptr<LedgerBundle const>, bool>
+    fetchFrom(Peer const& peer, uint32_t sequence, boost::asio::yield_context yield)
+    {
+        namespace beast = boost::beast;
+        namespace http = beast::http;
+        using tcp = boost::asio::ip::tcp;
+
+        beast::error_code ec;
+        auto const reused = connection_ != nullptr;
+        if (!reused)
+        {
+            tcp::resolver resolver{ioc_};
+            auto const results = resolver.async_resolve(peer.ip, peer.port, yield[ec]);
+            if (ec)
+                return {nullptr, false};
+
+            auto connection = std::make_unique<Connection>(ioc_);
+            connection->stream.expires_after(std::chrono::seconds(5));
+            connection->stream.async_connect(results, yield[ec]);
+            if (ec)
+                return {nullptr, false};
+
+            connection_ = std::move(connection);
+        }
+
+        http::request<http::empty_body> req{http::verb::get, LedgerFeed::target(sequence), 11};
+        req.set(http::field::host, peer.ip);
+        req.keep_alive(true);
+
+        auto& stream = connection_->stream;
+        stream.expires_after(LedgerFeed::MAX_WAIT + std::chrono::seconds(5));
+        http::async_write(stream, req, yield[ec]);
+
+        http::response_parser<http::string_body> parser;
+        parser.body_limit(std::numeric_limits<std::uint64_t>::max());
+        if (!ec)
+            http::async_read(stream, connection_->buffer, parser, yield[ec]);
+
+        if (ec)
+        {
+            connection_.reset();
+
+            // the peer may have closed the connection while it was idle; that is only a failure on a new connection
+            if (reused)
+                return fetchFrom(peer, sequence, yield);
+
+            log_.debug() << "Could not read from ledger feed. ip = " << peer.ip << " . error = " << ec.message();
+            return {nullptr, false};
+        }
+
+        auto const& response = parser.get();
+        if (!response.keep_alive())
+            connection_.reset();
+
+        if (response.result() == http::status::no_content)
+            return {nullptr, true};
+
+        if (response.result() != http::status::ok)
+        {
+            log_.debug() << "Ledger " << sequence << " not in ledger feed. ip = " << peer.ip
+                         << " . status = " << response.result_int();
+            return {nullptr, false};
+        }
+
+        auto bundle = LedgerFeed::deserialize(response.body());
+        if (!bundle || bundle->lgrInfo.seq != sequence)
+        {
+            log_.error() << "Received a corrupted ledger from ledger feed. ip = " << peer.ip
+                         << " . ledger = " << sequence;
+            return {nullptr, false};
+        }
+
+        log_.debug() << "Received ledger " << sequence << " from ledger feed. ip = " << peer.ip;
+        return {std::make_shared<LedgerBundle const>(std::move(*bundle)), true};
+    }
+};
+
+}  // namespace clio::detail
@@ -39,6 +39,7 @@ class LedgerFetcher
 {
 public:
     using OptionalGetLedgerResponseType = typename LoadBalancerType::OptionalGetLedgerResponseType;
+    using OnLedgerFetchedType = typename LoadBalancerType::OnLedgerFetchedType;
 
 private:
     clio::Logger log_{"ETL"};
@@ -97,6 +98,36 @@ public:
 
         return response;
     }
+
+    /**
+     * @brief Extract diff data for a batch of ledgers, keeping up to maxInFlight requests outstanding.
+     *
+     * Unlike fetchDataAndDiff, this function gives up at the first ledger that could not be fetched. The caller is
+     * expected to fall back to fetchDataAndDiff for the remaining sequences.
+     *
+     * @param sequences sequences of the ledgers to extract, in the order they should be delivered
+     * @param maxInFlight max number of outstanding requests
+     * @param onFetched called in order for each extracted ledger; returning false stops the batch
+     * @return the number of ledgers delivered to onFetched
+     */
+    std::size_t
+    fetchDataAndDiffPipelined(
+        std::vector<uint32_t> const& sequences,
+        std::uint32_t maxInFlight,
+        OnLedgerFetchedType onFetched)
+    {
+        if (sequences.empty())
+            return 0;
+
+        log_.debug() << "Attempting to fetch " << sequences.size() << " ledgers starting at " << sequences.front();
+
+        return loadBalancer_->fetchLedgers(
+            sequences,
+            maxInFlight,
+            true,
+            !backend_->cache().isFull() || backend_->cache().latestLedgerSequence() >= sequences.front(),
+            std::move(onFetched));
+    }
 };
 
 }  // namespace clio::detail
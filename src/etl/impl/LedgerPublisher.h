@@ -21,6 +21,8 @@
 
 #include <backend/BackendInterface.h>
 #include <etl/SystemState.h>
+#include <etl/impl/LedgerBundle.h>
+#include <etl/impl/LedgerFeed.h>
 #include <log/Logger.h>
 #include <util/LedgerUtils.h>
 #include <util/Profiler.h>
@@ -28,6 +30,7 @@
 #include <ripple/ledger/ReadView.h>
 
 #include <chrono>
+#include <memory>
 
 namespace clio::detail {
 
@@ -62,16 +65,25 @@ class LedgerPublisher
     std::optional<uint32_t> lastPublishedSequence_;
     mutable std::shared_mutex lastPublishedSeqMtx_;
 
+    LedgerFeed feed_;
+
 public:
     /**
      * @brief Create an instance of the publisher
+     *
+     * @param feedSize Number of published ledgers to keep for read-only nodes; 0 disables the ledger feed
      */
     LedgerPublisher(
         boost::asio::io_context& ioc,
         std::shared_ptr<BackendInterface> backend,
         std::shared_ptr<SubscriptionManager> subscriptions,
-        SystemState const& state)
-        : publishStrand_{ioc}, backend_{backend}, subscriptions_{subscriptions}, state_{std::cref(state)}
+        SystemState const& state,
+        std::size_t feedSize = 0)
+        : publishStrand_{ioc}
+        , backend_{backend}
+        , subscriptions_{subscriptions}
+        , state_{std::cref(state)}
+        , feed_{feedSize}
     {
     }
 
@@ -125,24 +137,51 @@ public:
     /**
      * @brief Publish the passed in ledger
      *
-     * All ledgers are published thru publishStrand_ which ensures that all publishes are performed in a serial fashion.
+     * The fees and transactions of the ledger are read from the database.
      *
      * @param lgrInfo the ledger to publish
      */
     void
     publish(ripple::LedgerInfo const& lgrInfo)
     {
-        boost::asio::post(publishStrand_, [this, lgrInfo = lgrInfo]() {
+        publish(std::make_shared<LedgerBundle const>(LedgerBundle{lgrInfo}));
+    }
+
+    /**
+     * @brief Publish the passed in ledger
+     *
+     * All ledgers are published thru publishStrand_ which ensures that all publishes are performed in a serial fashion.
+     * Fees, transactions and, on read-only nodes, the ledger diff are only read from the database if the bundle does
+     * not carry them. Bundles that carry everything are also added to the ledger feed.
+     *
+     * @param bundle the ledger to publish along with the data that is already known about it
+     */
+    void
+    publish(std::shared_ptr<LedgerBundle const> bundle)
+    {
+        auto const seq = bundle->lgrInfo.seq;
+        boost::asio::post(publishStrand_, [this, bundle = std::move(bundle)]() {
+            auto const& lgrInfo = bundle->lgrInfo;
             log_.info() << "Publishing ledger " << std::to_string(lgrInfo.seq);
 
+            feed_.add(*bundle);
+
             if (!state_.get().isWriting)
             {
                 log_.info() << "Updating cache";
 
-                std::vector<Backend::LedgerObject> diff = Backend::synchronousAndRetryOnTimeout(
-                    [&](auto yield) { return backend_->fetchLedgerDiff(lgrInfo.seq, yield); });
+                // todo: inject cache to update, don't use backend cache
+                if (bundle->objects)
+                {
+                    backend_->cache().update(*bundle->objects, lgrInfo.seq);
+                }
+                else
+                {
+                    std::vector<Backend::LedgerObject> diff = Backend::synchronousAndRetryOnTimeout(
+                        [&](auto yield) { return backend_->fetchLedgerDiff(lgrInfo.seq, yield); });
 
-                backend_->cache().update(diff, lgrInfo.seq);  // todo: inject cache to update, don't use backend cache
+                    backend_->cache().update(diff, lgrInfo.seq);
+                }
                 backend_->updateRange(lgrInfo.seq);
             }
 
@@ -153,11 +192,20 @@ public:
             // TODO: this probably should be a strategy
             if (age < 600)
             {
-                std::optional<ripple::Fees> fees = Backend::synchronousAndRetryOnTimeout(
-                    [&](auto yield) { return backend_->fetchFees(lgrInfo.seq, yield); });
+                std::optional<ripple::Fees> fees = bundle->fees;
+                if (!fees)
+                {
+                    fees = Backend::synchronousAndRetryOnTimeout(
+                        [&](auto yield) { return backend_->fetchFees(lgrInfo.seq, yield); });
+                }
 
-                std::vector<Backend::TransactionAndMetadata> transactions = Backend::synchronousAndRetryOnTimeout(
-                    [&](auto yield) { return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield); });
+                std::vector<Backend::TransactionAndMetadata> fetched;
+                if (!bundle->transactions)
+                {
+                    fetched = Backend::synchronousAndRetryOnTimeout(
+                        [&](auto yield) { return backend_->fetchAllTransactionsInLedger(lgrInfo.seq, yield); });
+                }
+                auto const& transactions = bundle->transactions ? *bundle->transactions : fetched;
 
                 auto ledgerRange = backend_->fetchLedgerRange();
                 assert(ledgerRange);
@@ -168,8 +216,7 @@ public:
 
                 subscriptions_->pubLedger(lgrInfo, *fees, range, transactions.size());
 
-                for (auto& txAndMeta : transactions)
-                    subscriptions_->pubTransaction(txAndMeta, lgrInfo);
+                subscriptions_->pubTransactions(transactions, lgrInfo);
 
                 subscriptions_->pubBookChanges(lgrInfo, transactions);
 
@@ -181,7 +228,7 @@ public:
         });
 
         // we track latest publish-requested seq, not necessarily already published
-        setLastPublishedSequence(lgrInfo.seq);
+        setLastPublishedSequence(seq);
     }
 
     /**
@@ -219,6 +266,15 @@ public:
         return now - (rippleEpochStart + closeTime);
     }
 
+    /**
+     * @brief Get the ledgers kept for read-only nodes
+     */
+    LedgerFeed const&
+    feed() const
+    {
+        return feed_;
+    }
+
     std::optional<uint32_t>
     getLastPublishedSequence() const
     {
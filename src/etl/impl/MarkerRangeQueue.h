@@ -0,0 +1,225 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace clio::detail {
+
+/**
+ * @brief A range of the ledger key space identified by the first byte (prefix) of the keys
+ *
+ * The range covers the prefixes [begin, end). The owner of the range advances begin as it downloads the range (see
+ * MarkerRangeQueue::advance); end may shrink when another source steals the upper part of the range.
+ */
+struct MarkerRange
+{
+    constexpr static std::uint16_t KEY_SPACE_END = 256;
+
+    std::atomic_uint16_t begin;
+    std::atomic_uint16_t end;
+
+    // full key the download continues from; empty to start at the first key with prefix begin
+    std::string marker;
+
+    MarkerRange(std::uint16_t first, std::uint16_t last) : begin{first}, end{last}
+    {
+    }
+};
+
+/**
+ * @brief Work queue of key ranges shared by all sources taking part in the initial ledger download
+ *
+ * Sources pull ranges until the queue is empty. When there is nothing left to pull, an idle source steals the upper
+ * half of the largest range still being downloaded. Ranges that failed are put back so that another source can retry
+ * them from where the download stopped.
+ */
+class MarkerRangeQueue
+{
+    mutable std::mutex mtx_;
+    std::deque<std::shared_ptr<MarkerRange>> pending_;
+    std::vector<std::shared_ptr<MarkerRange>> inFlight_;
+    std::vector<std::string> edgeKeys_;
+
+public:
+    /**
+     * @brief Create a queue splitting the key space into numRanges ranges
+     *
+     * @param numRanges Number of ranges; between 1 and 256
+     */
+    explicit MarkerRangeQueue(std::uint32_t numRanges)
+    {
+        assert(numRanges > 0 && numRanges <= MarkerRange::KEY_SPACE_END);
+
+        auto const incr = MarkerRange::KEY_SPACE_END / numRanges;
+        for (auto i = 0u; i < numRanges; ++i)
+        {
+            auto const last = i + 1 == numRanges ? MarkerRange::KEY_SPACE_END : (i + 1) * incr;
+            pending_.push_back(std::make_shared<MarkerRange>(i * incr, last));
+        }
+    }
+
+    /**
+     * @brief Take the next range to download
+     *
+     * @return the range; nullptr if there is nothing left to pull or steal
+     */
+    std::shared_ptr<MarkerRange>
+    tryPop()
+    {
+        std::lock_guard lck(mtx_);
+        if (!pending_.empty())
+        {
+            auto range = std::move(pending_.front());
+            pending_.pop_front();
+            inFlight_.push_back(range);
+            return range;
+        }
+
+        return steal();
+    }
+
+    /**
+     * @brief Record that the keys of a range before the given marker were downloaded
+     *
+     * Takes the lock of the queue so that a concurrent steal never hands out keys that were already downloaded.
+     *
+     * @param range The range returned by tryPop
+     * @param marker The key to continue the download from; empty if the source has no more keys
+     * @return The end of the range. The download of the range is complete if the marker is not before it; no part of
+     * the range can be stolen after that
+     */
+    std::uint16_t
+    advance(std::shared_ptr<MarkerRange> const& range, std::string const& marker)
+    {
+        std::lock_guard lck(mtx_);
+        std::uint16_t const end = range->end;
+        if (marker.empty() || static_cast<unsigned char>(marker.front()) >= end)
+        {
+            range->begin = end;
+            range->marker.clear();
+        }
+        else
+        {
+            range->begin = static_cast<unsigned char>(marker.front());
+            range->marker = marker;
+        }
+        return end;
+    }
+
+    /**
+     * @brief Mark a range as fully downloaded
+     *
+     * @param range The range returned by tryPop
+     * @param lastKey The last key written for this range; empty if none
+     */
+    void
+    finish(std::shared_ptr<MarkerRange> const& range, std::string lastKey)
+    {
+        std::lock_guard lck(mtx_);
+        release(range, std::move(lastKey));
+    }
+
+    /**
+     * @brief Put a range that failed back on the queue, to be resumed from the marker last passed to advance
+     *
+     * @param range The range returned by tryPop
+     * @param lastKey The last key written for this range before it failed; empty if none
+     */
+    void
+    retry(std::shared_ptr<MarkerRange> const& range, std::string lastKey)
+    {
+        std::lock_guard lck(mtx_);
+        release(range, std::move(lastKey));
+
+        if (range->begin < range->end)
+            pending_.push_front(range);
+    }
+
+    /**
+     * @return true if every range was downloaded
+     */
+    bool
+    isDone() const
+    {
+        std::lock_guard lck(mtx_);
+        return pending_.empty() && inFlight_.empty();
+    }
+
+    /**
+     * @return The last key written for every range (or part of a range) that was downloaded
+     */
+    std::vector<std::string>
+    edgeKeys() const
+    {
+        std::lock_guard lck(mtx_);
+        return edgeKeys_;
+    }
+
+private:
+    void
+    release(std::shared_ptr<MarkerRange> const& range, std::string lastKey)
+    {
+        inFlight_.erase(std::remove(inFlight_.begin(), inFlight_.end(), range), inFlight_.end());
+        if (!lastKey.empty())
+            edgeKeys_.push_back(std::move(lastKey));
+    }
+
+    std::shared_ptr<MarkerRange>
+    steal()
+    {
+        std::shared_ptr<MarkerRange> victim;
+        std::uint16_t victimBegin = 0;
+        std::uint16_t victimEnd = 0;
+
+        for (auto const& range : inFlight_)
+        {
+            std::uint16_t const begin = range->begin;
+            std::uint16_t const end = range->end;
+            if (end > begin && end - begin > victimEnd - victimBegin)
+            {
+                victim = range;
+                victimBegin = begin;
+                victimEnd = end;
+            }
+        }
+
+        // ranges are split on prefix boundaries; a range spanning a single prefix can't be split
+        if (!victim || victimEnd - victimBegin < 2)
+            return nullptr;
+
+        std::uint16_t const middle = victimBegin + (victimEnd - victimBegin) / 2;
+        victim->end = middle;
+
+        auto stolen = std::make_shared<MarkerRange>(middle, victimEnd);
+        inFlight_.push_back(stolen);
+        return stolen;
+    }
+};
+
+}  // namespace clio::detail
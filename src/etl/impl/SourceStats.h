@@ -0,0 +1,178 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+
+namespace clio::detail {
+
+/**
+ * @brief Rolling latency and error statistics for one kind of request sent to an ETL source
+ *
+ * Latency and error rate are tracked as exponentially weighted moving averages so that recent behaviour of the source
+ * dominates. The resulting cost is used by the LoadBalancer to prefer fast and healthy sources.
+ */
+class RequestStats
+{
+    mutable std::mutex mtx_;
+    double latencyMs_ = 0.0;
+    double errorRate_ = 0.0;
+    std::uint64_t numSuccesses_ = 0;
+    std::uint64_t numFailures_ = 0;
+    std::uint32_t numInFlight_ = 0;
+
+public:
+    /**
+     * @brief Weight of the latest sample in the moving averages
+     */
+    constexpr static double SMOOTHING_FACTOR = 0.2;
+
+    /**
+     * @brief Extra cost, in milliseconds of latency, of a source that fails every request
+     *
+     * The penalty is added rather than multiplied so that a source that fails fast never looks cheaper than a healthy
+     * one.
+     */
+    constexpr static double ERROR_PENALTY_MS = 1000.0;
+
+    /**
+     * @brief Mark the start of a request
+     */
+    void
+    started()
+    {
+        std::lock_guard lck(mtx_);
+        ++numInFlight_;
+    }
+
+    /**
+     * @brief Record the outcome of a request that was marked as started
+     *
+     * @param latency Time it took for the request to complete
+     * @param success Whether the request succeeded
+     */
+    void
+    finished(std::chrono::steady_clock::duration latency, bool success)
+    {
+        auto const ms = std::chrono::duration<double, std::milli>(latency).count();
+
+        std::lock_guard lck(mtx_);
+        if (numInFlight_ > 0)
+            --numInFlight_;
+
+        auto const isFirstSample = numSuccesses_ + numFailures_ == 0;
+        if (success)
+            ++numSuccesses_;
+        else
+            ++numFailures_;
+
+        if (isFirstSample)
+        {
+            latencyMs_ = ms;
+            errorRate_ = success ? 0.0 : 1.0;
+            return;
+        }
+
+        latencyMs_ += SMOOTHING_FACTOR * (ms - latencyMs_);
+        errorRate_ += SMOOTHING_FACTOR * ((success ? 0.0 : 1.0) - errorRate_);
+    }
+
+    /**
+     * @brief Forget a request that was marked as started but abandoned before it completed (e.g. a cancelled hedge)
+     */
+    void
+    abandoned()
+    {
+        std::lock_guard lck(mtx_);
+        if (numInFlight_ > 0)
+            --numInFlight_;
+    }
+
+    /**
+     * @return Smoothed latency in milliseconds
+     */
+    double
+    latencyMs() const
+    {
+        std::lock_guard lck(mtx_);
+        return latencyMs_;
+    }
+
+    /**
+     * @return Whether at least one request has completed
+     */
+    bool
+    isMeasured() const
+    {
+        std::lock_guard lck(mtx_);
+        return numSuccesses_ + numFailures_ > 0;
+    }
+
+    /**
+     * @brief Expected cost of sending another request; lower is better
+     *
+     * @param priorLatencyMs Latency assumed while the source has no samples. The LoadBalancer passes the average of the
+     * measured sources, so that a new source is neither always preferred nor never tried
+     */
+    double
+    cost(double priorLatencyMs = 0.0) const
+    {
+        std::lock_guard lck(mtx_);
+        auto const latency = numSuccesses_ + numFailures_ == 0 ? priorLatencyMs : latencyMs_;
+        return (latency + ERROR_PENALTY_MS * errorRate_) * (1 + numInFlight_);
+    }
+
+    boost::json::object
+    toJson() const
+    {
+        std::lock_guard lck(mtx_);
+        return {
+            {"latency_ms", latencyMs_},
+            {"error_rate", errorRate_},
+            {"successes", numSuccesses_},
+            {"failures", numFailures_},
+            {"in_flight", numInFlight_},
+        };
+    }
+};
+
+/**
+ * @brief Statistics of the requests the LoadBalancer sends to one ETL source
+ */
+struct SourceStats
+{
+    RequestStats grpc;
+    RequestStats forward;
+
+    boost::json::object
+    toJson() const
+    {
+        return {
+            {"grpc", grpc.toJson()},
+            {"forward", forward.toJson()},
+        };
+    }
+};
+
+}  // namespace clio::detail
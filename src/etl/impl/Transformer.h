@@ -21,6 +21,7 @@
 
 #include <backend/BackendInterface.h>
 #include <etl/SystemState.h>
+#include <etl/impl/LedgerBundle.h>
 #include <etl/impl/LedgerLoader.h>
 #include <log/Logger.h>
 #include <util/LedgerUtils.h>
@@ -30,6 +31,7 @@
 #include "org/xrpl/rpc/v1/xrp_ledger.grpc.pb.h"
 #include <grpcpp/grpcpp.h>
 
+#include <algorithm>
 #include <chrono>
 #include <memory>
 #include <thread>
@@ -61,6 +63,7 @@ class Transformer
     std::reference_wrapper<LedgerPublisherType> publisher_;
     uint32_t startSequence_;
     std::reference_wrapper<SystemState> state_;  // shared state for ETL
+    bool bundleObjects_;
 
     std::thread thread_;
 
@@ -70,6 +73,8 @@ public:
      *
      * This spawns a new thread that reads from the data pipe and writes ledgers to the DB using LedgerLoader and
      * LedgerPublisher.
+     *
+     * @param bundleObjects Whether to pass the objects changed by each ledger to the publisher, which costs a copy
      */
     Transformer(
         DataPipeType& pipe,
@@ -77,13 +82,15 @@ public:
         LedgerLoaderType& loader,
         LedgerPublisherType& publisher,
         uint32_t startSequence,
-        SystemState& state)
+        SystemState& state,
+        bool bundleObjects = false)
         : pipe_(std::ref(pipe))
         , backend_{backend}
         , loader_(std::ref(loader))
         , publisher_(std::ref(publisher))
         , startSequence_{startSequence}
         , state_{std::ref(state)}
+        , bundleObjects_{bundleObjects}
     {
         thread_ = std::thread([this]() { process(); });
     }
@@ -128,7 +135,8 @@ private:
                 continue;
 
             auto const start = std::chrono::system_clock::now();
-            auto [lgrInfo, success] = buildNextLedger(*fetchResponse);
+            auto [bundle, success] = buildNextLedger(*fetchResponse);
+            auto const& lgrInfo = bundle.lgrInfo;
 
             if (success)
             {
@@ -144,7 +152,7 @@ private:
                             << ". load objs per second = " << numObjects / duration;
 
                 // success is false if the ledger was already written
-                publisher_.get().publish(lgrInfo);
+                publisher_.get().publish(std::make_shared<LedgerBundle const>(std::move(bundle)));
             }
             else
             {
@@ -161,9 +169,9 @@ private:
      * @note rawData should be data that corresponds to the ledger immediately following the previous seq.
      *
      * @param rawData data extracted from an ETL source
-     * @return the newly built ledger and data to write to the database
+     * @return the newly built ledger along with its fees and transactions, and whether it was written to the database
      */
-    std::pair<ripple::LedgerInfo, bool>
+    std::pair<LedgerBundle, bool>
     buildNextLedger(GetLedgerResponseType& rawData)
     {
         log_.debug() << "Beginning ledger update";
@@ -175,13 +183,18 @@ private:
 
         writeSuccessors(lgrInfo, rawData);
         std::optional<FormattedTransactionsData> insertTxResultOp;
+        LedgerBundle bundle{lgrInfo};
         try
         {
-            updateCache(lgrInfo, rawData);
+            updateCache(lgrInfo, rawData, bundle);
 
             log_.debug() << "Inserted/modified/deleted all objects. Number of objects = "
                          << rawData.ledger_objects().objects_size();
 
+            // the blobs are moved to the database by insertTransactions so take a copy for publishing first
+            bundle.fees = backend_->fetchFeesFromCache(lgrInfo.seq);
+            bundle.transactions = copyTransactions(lgrInfo, rawData);
+
             insertTxResultOp.emplace(loader_.get().insertTransactions(lgrInfo, rawData));
         }
         catch (std::runtime_error const& e)
@@ -191,7 +204,7 @@ private:
             log_.fatal()
                 << "Failed to build next ledger: " << e.what()
                 << " Possible cause: The ETL node is not compatible with the version of the rippled lib Clio is using.";
-            return {ripple::LedgerInfo{}, false};
+            return {LedgerBundle{}, false};
         }
 
         log_.debug() << "Inserted all transactions. Number of transactions  = "
@@ -207,136 +220,192 @@ private:
         log_.debug() << "Finished writes. Total time: " << std::to_string(duration);
         log_.debug() << "Finished ledger update: " << util::toString(lgrInfo);
 
-        return {lgrInfo, success};
+        return {std::move(bundle), success};
+    }
+
+    /**
+     * @brief Copy the transactions of a ledger so they can be published without reading them from the database
+     *
+     * @param lgrInfo Ledger info
+     * @param rawData Ledger data from GRPC
+     * @return the transactions and their metadata
+     */
+    std::vector<Backend::TransactionAndMetadata>
+    copyTransactions(ripple::LedgerInfo const& lgrInfo, GetLedgerResponseType const& rawData) const
+    {
+        auto const& txList = rawData.transactions_list();
+
+        std::vector<Backend::TransactionAndMetadata> transactions;
+        transactions.reserve(txList.transactions_size());
+        for (auto const& txn : txList.transactions())
+        {
+            auto& txAndMeta = transactions.emplace_back();
+            txAndMeta.transaction.assign(txn.transaction_blob().begin(), txn.transaction_blob().end());
+            txAndMeta.metadata.assign(txn.metadata_blob().begin(), txn.metadata_blob().end());
+            txAndMeta.ledgerSequence = lgrInfo.seq;
+            txAndMeta.date = lgrInfo.closeTime.time_since_epoch().count();
+        }
+        return transactions;
     }
 
     /**
      * @brief Update cache from new ledger data.
      *
+     * Each object's data is copied once, into the cache; the protobuf strings are moved to the backend. If rippled did
+     * not send neighbors, they are looked up in batches under a single cache read lock before and after the update.
+     *
      * @param lgrInfo Ledger info
      * @param rawData Ledger data from GRPC
+     * @param bundle Receives a copy of the changed objects if bundleObjects_ is set
      */
     void
-    updateCache(ripple::LedgerInfo const& lgrInfo, GetLedgerResponseType& rawData)
+    updateCache(ripple::LedgerInfo const& lgrInfo, GetLedgerResponseType& rawData, LedgerBundle& bundle)
     {
+        struct BookDir
+        {
+            ripple::uint256 key;
+            ripple::uint256 bookBase;
+            bool isDeleted;
+        };
+
+        auto& cache = backend_->cache();
+        auto& objects = *(rawData.mutable_ledger_objects()->mutable_objects());
+        auto const useCache = !rawData.object_neighbors_included();
+
         std::vector<Backend::LedgerObject> cacheUpdates;
-        cacheUpdates.reserve(rawData.ledger_objects().objects_size());
+        cacheUpdates.reserve(objects.size());
 
-        // TODO change these to unordered_set
-        std::set<ripple::uint256> bookSuccessorsToCalculate;
-        std::set<ripple::uint256> modified;
+        // created and deleted objects, whose successors are calculated using the cache
+        std::vector<ripple::uint256> changedKeys;
+        std::vector<bool> changedIsDeleted;
+        std::vector<BookDir> bookDirs;
 
-        for (auto& obj : *(rawData.mutable_ledger_objects()->mutable_objects()))
+        for (auto& obj : objects)
         {
             auto key = ripple::uint256::fromVoidChecked(obj.key());
             assert(key);
 
-            cacheUpdates.push_back({*key, {obj.mutable_data()->begin(), obj.mutable_data()->end()}});
             log_.debug() << "key = " << ripple::strHex(*key) << " - mod type = " << obj.mod_type();
 
-            if (obj.mod_type() != RawLedgerObjectType::MODIFIED && !rawData.object_neighbors_included())
+            if (obj.mod_type() != RawLedgerObjectType::MODIFIED && useCache)
             {
                 log_.debug() << "object neighbors not included. using cache";
 
-                if (!backend_->cache().isFull() || backend_->cache().latestLedgerSequence() != lgrInfo.seq - 1)
+                if (!cache.isFull() || cache.latestLedgerSequence() != lgrInfo.seq - 1)
                     throw std::runtime_error("Cache is not full, but object neighbors were not included");
 
-                auto const blob = obj.mutable_data();
+                auto const isDeleted = obj.data().empty();
                 auto checkBookBase = false;
-                auto const isDeleted = (blob->size() == 0);
 
                 if (isDeleted)
                 {
-                    auto const old = backend_->cache().get(*key, lgrInfo.seq - 1);
+                    auto const old = cache.get(*key, lgrInfo.seq - 1);
                     assert(old);
                     checkBookBase = isBookDir(*key, *old);
                 }
                 else
                 {
-                    checkBookBase = isBookDir(*key, *blob);
+                    checkBookBase = isBookDir(*key, obj.data());
                 }
 
                 if (checkBookBase)
-                {
-                    log_.debug() << "Is book dir. Key = " << ripple::strHex(*key);
+                    bookDirs.push_back({*key, getBookBase(*key), isDeleted});
 
-                    auto const bookBase = getBookBase(*key);
-                    auto const oldFirstDir = backend_->cache().getSuccessor(bookBase, lgrInfo.seq - 1);
-                    assert(oldFirstDir);
+                changedKeys.push_back(*key);
+                changedIsDeleted.push_back(isDeleted);
+            }
 
-                    // We deleted the first directory, or we added a directory prior to the old first directory
-                    if ((isDeleted && key == oldFirstDir->key) || (!isDeleted && key < oldFirstDir->key))
-                    {
-                        log_.debug() << "Need to recalculate book base successor. base = " << ripple::strHex(bookBase)
-                                     << " - key = " << ripple::strHex(*key) << " - isDeleted = " << isDeleted
-                                     << " - seq = " << lgrInfo.seq;
-                        bookSuccessorsToCalculate.insert(bookBase);
-                    }
+            auto const& data = obj.data();
+            cacheUpdates.push_back({*key, {data.begin(), data.end()}});
+            backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
+        }
+
+        std::vector<ripple::uint256> bookSuccessorsToCalculate;
+        if (!bookDirs.empty())
+        {
+            std::vector<ripple::uint256> bookBases;
+            bookBases.reserve(bookDirs.size());
+            for (auto const& dir : bookDirs)
+                bookBases.push_back(dir.bookBase);
+
+            auto const oldFirstDirs = cache.getNeighbors(bookBases, lgrInfo.seq - 1);
+            if (oldFirstDirs.size() != bookDirs.size())
+                throw std::runtime_error("Cache is not full, but object neighbors were not included");
+
+            for (size_t i = 0; i < bookDirs.size(); ++i)
+            {
+                auto const& [key, bookBase, isDeleted] = bookDirs[i];
+                auto const& oldFirstDir = oldFirstDirs[i].successor;
+                assert(oldFirstDir);
+
+                log_.debug() << "Is book dir. Key = " << ripple::strHex(key);
+
+                // We deleted the first directory, or we added a directory prior to the old first directory
+                if ((isDeleted && key == *oldFirstDir) || (!isDeleted && key < *oldFirstDir))
+                {
+                    log_.debug() << "Need to recalculate book base successor. base = " << ripple::strHex(bookBase)
+                                 << " - key = " << ripple::strHex(key) << " - isDeleted = " << isDeleted
+                                 << " - seq = " << lgrInfo.seq;
+                    bookSuccessorsToCalculate.push_back(bookBase);
                 }
             }
 
-            if (obj.mod_type() == RawLedgerObjectType::MODIFIED)
-                modified.insert(*key);
-
-            backend_->writeLedgerObject(std::move(*obj.mutable_key()), lgrInfo.seq, std::move(*obj.mutable_data()));
+            std::sort(bookSuccessorsToCalculate.begin(), bookSuccessorsToCalculate.end());
+            bookSuccessorsToCalculate.erase(
+                std::unique(bookSuccessorsToCalculate.begin(), bookSuccessorsToCalculate.end()),
+                bookSuccessorsToCalculate.end());
         }
 
-        backend_->cache().update(cacheUpdates, lgrInfo.seq);
+        if (bundleObjects_)
+            bundle.objects = cacheUpdates;
+
+        cache.update(std::move(cacheUpdates), lgrInfo.seq);
 
         // rippled didn't send successor information, so use our cache
-        if (!rawData.object_neighbors_included())
+        if (useCache)
         {
             log_.debug() << "object neighbors not included. using cache";
-            if (!backend_->cache().isFull() || backend_->cache().latestLedgerSequence() != lgrInfo.seq)
+            if (!cache.isFull() || cache.latestLedgerSequence() != lgrInfo.seq)
                 throw std::runtime_error("Cache is not full, but object neighbors were not included");
 
-            for (auto const& obj : cacheUpdates)
-            {
-                if (modified.count(obj.key))
-                    continue;
+            auto const numChanged = changedKeys.size();
+            auto& lookups = changedKeys;
+            lookups.insert(lookups.end(), bookSuccessorsToCalculate.begin(), bookSuccessorsToCalculate.end());
 
-                auto lb = backend_->cache().getPredecessor(obj.key, lgrInfo.seq);
-                if (!lb)
-                    lb = {Backend::firstKey, {}};
+            auto const neighbors = cache.getNeighbors(lookups, lgrInfo.seq);
+            if (neighbors.size() != lookups.size())
+                throw std::runtime_error("Cache is not full, but object neighbors were not included");
 
-                auto ub = backend_->cache().getSuccessor(obj.key, lgrInfo.seq);
-                if (!ub)
-                    ub = {Backend::lastKey, {}};
+            for (size_t i = 0; i < numChanged; ++i)
+            {
+                auto const& key = lookups[i];
+                auto const lb = neighbors[i].predecessor.value_or(Backend::firstKey);
+                auto const ub = neighbors[i].successor.value_or(Backend::lastKey);
 
-                if (obj.blob.size() == 0)
+                if (changedIsDeleted[i])
                 {
-                    log_.debug() << "writing successor for deleted object " << ripple::strHex(obj.key) << " - "
-                                 << ripple::strHex(lb->key) << " - " << ripple::strHex(ub->key);
+                    log_.debug() << "writing successor for deleted object " << ripple::strHex(key) << " - "
+                                 << ripple::strHex(lb) << " - " << ripple::strHex(ub);
 
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(ub->key));
+                    backend_->writeSuccessor(uint256ToString(lb), lgrInfo.seq, uint256ToString(ub));
                 }
                 else
                 {
-                    backend_->writeSuccessor(uint256ToString(lb->key), lgrInfo.seq, uint256ToString(obj.key));
-                    backend_->writeSuccessor(uint256ToString(obj.key), lgrInfo.seq, uint256ToString(ub->key));
+                    backend_->writeSuccessor(uint256ToString(lb), lgrInfo.seq, uint256ToString(key));
+                    backend_->writeSuccessor(uint256ToString(key), lgrInfo.seq, uint256ToString(ub));
 
-                    log_.debug() << "writing successor for new object " << ripple::strHex(lb->key) << " - "
-                                 << ripple::strHex(obj.key) << " - " << ripple::strHex(ub->key);
+                    log_.debug() << "writing successor for new object " << ripple::strHex(lb) << " - "
+                                 << ripple::strHex(key) << " - " << ripple::strHex(ub);
                 }
             }
 
-            for (auto const& base : bookSuccessorsToCalculate)
+            for (size_t i = numChanged; i < lookups.size(); ++i)
             {
-                auto succ = backend_->cache().getSuccessor(base, lgrInfo.seq);
-                if (succ)
-                {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(succ->key));
+                auto const& base = lookups[i];
+                auto const succ = neighbors[i].successor.value_or(Backend::lastKey);
+                backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(succ));
 
-                    log_.debug() << "Updating book successor " << ripple::strHex(base) << " - "
-                                 << ripple::strHex(succ->key);
-                }
-                else
-                {
-                    backend_->writeSuccessor(uint256ToString(base), lgrInfo.seq, uint256ToString(Backend::lastKey));
-
-                    log_.debug() << "Updating book successor " << ripple::strHex(base) << " - "
-                                 << ripple::strHex(Backend::lastKey);
-                }
+                log_.debug() << "Updating book successor " << ripple::strHex(base) << " - " << ripple::strHex(succ);
             }
         }
     }
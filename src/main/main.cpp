@@ -177,8 +177,7 @@ try
     io_context ioc{threads};
 
     // Rate limiter, to prevent abuse
-    auto sweepHandler = IntervalSweepHandler{config, ioc};
-    auto dosGuard = DOSGuard{config, sweepHandler};
+    auto dosGuard = DOSGuard{config};
 
     // Interface to the database
     auto backend = Backend::make_Backend(ioc, config);
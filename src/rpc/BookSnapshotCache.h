@@ -0,0 +1,209 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/WorkCost.h>
+
+#include <ripple/protocol/AccountID.h>
+#include <ripple/protocol/Book.h>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json.hpp>
+
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace RPC {
+
+/**
+ * @brief Order book snapshots of the latest ledger, shared by the sessions subscribing to a book with snapshot
+ *
+ * Many clients subscribe to the same few books right after a ledger closes. The first of them fetches and renders the
+ * snapshot; the others wait for it instead of doing the same work. Snapshots are dropped as soon as one is asked for a
+ * newer ledger.
+ */
+class BookSnapshotCache
+{
+public:
+    using Snapshot = std::shared_ptr<boost::json::array const>;
+
+    static constexpr std::size_t MAX_ENTRIES = 1024;
+
+private:
+    struct Entry
+    {
+        std::mutex mtx;
+        bool done = false;
+        Snapshot snapshot;  // stays empty if rendering failed
+        // timers of the coroutines waiting for the snapshot, cancelled once it is done
+        std::vector<std::shared_ptr<boost::asio::steady_timer>> waiters;
+
+        /**
+         * @brief Set the snapshot and wake the coroutines waiting for it
+         */
+        void
+        finish(Snapshot result)
+        {
+            std::scoped_lock lck{mtx};
+            snapshot = std::move(result);
+            done = true;
+            for (auto const& timer : waiters)
+                timer->cancel();
+            waiters.clear();
+        }
+
+        /**
+         * @brief Suspend the coroutine until the snapshot is done
+         * @return The snapshot; empty if rendering failed
+         */
+        Snapshot
+        wait(boost::asio::yield_context& yield)
+        {
+            auto const timer = std::make_shared<boost::asio::steady_timer>(
+                yield.get_executor(), std::chrono::steady_clock::time_point::max());
+            boost::system::error_code ec;
+            auto token = yield[ec];
+
+            util::WorkCost::Suspension const suspension;
+            boost::asio::async_initiate<boost::asio::yield_context, void(boost::system::error_code)>(
+                [this, timer](auto&& handler) {
+                    // the wait starts under the lock finish cancels the timers under, so that it can not be missed
+                    std::scoped_lock lck{mtx};
+                    if (done)
+                        timer->expires_at(std::chrono::steady_clock::time_point::min());
+                    else
+                        waiters.push_back(timer);
+
+                    timer->async_wait(std::move(handler));
+                },
+                token);
+
+            std::scoped_lock lck{mtx};
+            return snapshot;
+        }
+    };
+
+    using Key = std::pair<ripple::Book, ripple::AccountID>;
+
+    std::mutex mtx_;
+    std::uint32_t seq_ = 0;
+    std::map<Key, std::shared_ptr<Entry>> entries_;
+
+public:
+    /**
+     * @brief Get the snapshot of a book, rendering it if no other coroutine did or does it for the same ledger
+     *
+     * @param book The book
+     * @param taker The taker the offers are rendered for
+     * @param seq The ledger of the snapshot
+     * @param yield The coroutine context; waiting for the snapshot to be rendered elsewhere does not block the thread
+     * @param render Renders the snapshot if needed, returning a boost::json::array
+     * @return The snapshot
+     */
+    template <typename RenderFunc>
+    Snapshot
+    get(ripple::Book const& book,
+        ripple::AccountID const& taker,
+        std::uint32_t seq,
+        boost::asio::yield_context& yield,
+        RenderFunc&& render)
+    {
+        auto const key = Key{book, taker};
+        auto entry = std::shared_ptr<Entry>{};
+        auto owner = false;
+        {
+            std::scoped_lock lck{mtx_};
+            if (seq > seq_)
+            {
+                entries_.clear();
+                seq_ = seq;
+            }
+
+            if (seq == seq_)
+            {
+                if (auto const it = entries_.find(key); it != entries_.end())
+                {
+                    entry = it->second;
+                }
+                else if (entries_.size() < MAX_ENTRIES)
+                {
+                    entry = std::make_shared<Entry>();
+                    entries_.emplace(key, entry);
+                    owner = true;
+                }
+            }
+        }
+
+        // an older ledger than the latest one asked for, or too many books at once
+        if (!entry)
+            return std::make_shared<boost::json::array const>(render());
+
+        if (owner)
+        {
+            auto snapshot = Snapshot{};
+            try
+            {
+                snapshot = std::make_shared<boost::json::array const>(render());
+            }
+            catch (...)
+            {
+                drop(key, entry);
+                entry->finish(nullptr);
+                throw;
+            }
+
+            entry->finish(snapshot);
+            return snapshot;
+        }
+
+        // rendering failed for the first caller; try for ourselves
+        if (auto snapshot = entry->wait(yield); snapshot)
+            return snapshot;
+
+        return std::make_shared<boost::json::array const>(render());
+    }
+
+    /**
+     * @return Number of snapshots kept or being rendered
+     */
+    std::size_t
+    size()
+    {
+        std::scoped_lock lck{mtx_};
+        return entries_.size();
+    }
+
+private:
+    void
+    drop(Key const& key, std::shared_ptr<Entry> const& entry)
+    {
+        std::scoped_lock lck{mtx_};
+        if (auto const it = entries_.find(key); it != entries_.end() && it->second == entry)
+            entries_.erase(it);
+    }
+};
+
+}  // namespace RPC
@@ -97,6 +97,30 @@ Counters::onInternalError()
     ++internalErrorCounter_;
 }
 
+void
+Counters::onMessagesDropped(std::uint64_t count)
+{
+    droppedMessagesCounter_ += count;
+}
+
+void
+Counters::onSlowConsumerDisconnected()
+{
+    ++slowConsumerDisconnectsCounter_;
+}
+
+void
+Counters::onResponseCacheHit()
+{
+    ++responseCacheHitsCounter_;
+}
+
+void
+Counters::onResponseCacheMiss()
+{
+    ++responseCacheMissesCounter_;
+}
+
 std::chrono::seconds
 Counters::uptime() const
 {
@@ -131,6 +155,10 @@ Counters::report() const
     obj["bad_syntax_errors"] = std::to_string(badSyntaxCounter_);
     obj["unknown_command_errors"] = std::to_string(unknownCommandCounter_);
     obj["internal_errors"] = std::to_string(internalErrorCounter_);
+    obj["dropped_messages"] = std::to_string(droppedMessagesCounter_);
+    obj["slow_consumer_disconnects"] = std::to_string(slowConsumerDisconnectsCounter_);
+    obj["response_cache_hits"] = std::to_string(responseCacheHitsCounter_);
+    obj["response_cache_misses"] = std::to_string(responseCacheMissesCounter_);
 
     obj["work_queue"] = workQueue_.get().report();
 
@@ -52,6 +52,10 @@ class Counters
     std::atomic_uint64_t badSyntaxCounter_;
     std::atomic_uint64_t unknownCommandCounter_;
     std::atomic_uint64_t internalErrorCounter_;
+    std::atomic_uint64_t droppedMessagesCounter_;
+    std::atomic_uint64_t slowConsumerDisconnectsCounter_;
+    std::atomic_uint64_t responseCacheHitsCounter_;
+    std::atomic_uint64_t responseCacheMissesCounter_;
 
     std::reference_wrapper<const WorkQueue> workQueue_;
     std::chrono::time_point<std::chrono::system_clock> startupTime_;
@@ -95,6 +99,18 @@ public:
     void
     onInternalError();
 
+    void
+    onMessagesDropped(std::uint64_t count);
+
+    void
+    onSlowConsumerDisconnected();
+
+    void
+    onResponseCacheHit();
+
+    void
+    onResponseCacheMiss();
+
     std::chrono::seconds
     uptime() const;
 
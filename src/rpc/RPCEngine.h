@@ -26,6 +26,7 @@
 #include <rpc/Counters.h>
 #include <rpc/Errors.h>
 #include <rpc/RPCHelpers.h>
+#include <rpc/ResponseCache.h>
 #include <rpc/common/AnyHandler.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/impl/AdminVerificationStrategy.h>
@@ -61,7 +62,7 @@ class RPCEngineBase
     std::shared_ptr<BackendInterface> backend_;
     std::shared_ptr<SubscriptionManager> subscriptions_;
     std::shared_ptr<LoadBalancer> balancer_;
-    std::reference_wrapper<clio::DOSGuard const> dosGuard_;
+    std::reference_wrapper<clio::DOSGuard> dosGuard_;
     std::reference_wrapper<WorkQueue> workQueue_;
     std::reference_wrapper<Counters> counters_;
 
@@ -70,25 +71,30 @@ class RPCEngineBase
     detail::ForwardingProxy<LoadBalancer, Counters, HandlerProvider> forwardingProxy_;
     AdminVerificationStrategyType adminVerifier_;
 
+    std::unique_ptr<ResponseCache> responseCache_;  // missing if disabled
+
 public:
     RPCEngineBase(
         std::shared_ptr<BackendInterface> const& backend,
         std::shared_ptr<SubscriptionManager> const& subscriptions,
         std::shared_ptr<LoadBalancer> const& balancer,
         std::shared_ptr<ETLService> const& etl,
-        clio::DOSGuard const& dosGuard,
+        clio::DOSGuard& dosGuard,
         WorkQueue& workQueue,
         Counters& counters,
-        std::shared_ptr<HandlerProvider const> const& handlerProvider)
+        std::shared_ptr<HandlerProvider const> const& handlerProvider,
+        std::size_t responseCacheBytes = 0)
         : backend_{backend}
         , subscriptions_{subscriptions}
         , balancer_{balancer}
-        , dosGuard_{std::cref(dosGuard)}
+        , dosGuard_{std::ref(dosGuard)}
         , workQueue_{std::ref(workQueue)}
         , counters_{std::ref(counters)}
         , handlerProvider_{handlerProvider}
         , forwardingProxy_{balancer, counters, handlerProvider}
     {
+        if (responseCacheBytes > 0)
+            responseCache_ = std::make_unique<ResponseCache>(responseCacheBytes);
     }
 
     static std::shared_ptr<RPCEngineBase>
@@ -98,83 +104,49 @@ public:
         std::shared_ptr<SubscriptionManager> const& subscriptions,
         std::shared_ptr<LoadBalancer> const& balancer,
         std::shared_ptr<ETLService> const& etl,
-        clio::DOSGuard const& dosGuard,
+        clio::DOSGuard& dosGuard,
         WorkQueue& workQueue,
         Counters& counters,
         std::shared_ptr<HandlerProvider const> const& handlerProvider)
     {
+        auto const responseCacheBytes = config.valueOr<uint64_t>("response_cache.max_size_mb", 0u) * 1024u * 1024u;
         return std::make_shared<RPCEngineBase>(
-            backend, subscriptions, balancer, etl, dosGuard, workQueue, counters, handlerProvider);
+            backend, subscriptions, balancer, etl, dosGuard, workQueue, counters, handlerProvider, responseCacheBytes);
     }
 
     /**
      * @brief Main request processor routine
+     *
+     * Responses about a ledger that can no longer change are served from the response cache if it is enabled. The
+     * resources used to serve the request are recorded in the context and charged to the client by the DOSGuard.
+     *
      * @param ctx The @ref Context of the request
      */
     Result
     buildResponse(Web::Context const& ctx)
     {
-        if (forwardingProxy_.shouldForward(ctx))
-            return forwardingProxy_.forward(ctx);
-
-        if (backend_->isTooBusy())
-        {
-            log_.error() << "Database is too busy. Rejecting request";
-            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
-            return Status{RippledError::rpcTOO_BUSY};
-        }
-
-        auto const method = handlerProvider_->getHandler(ctx.method);
-        if (!method)
-        {
-            notifyUnknownCommand();
-            return Status{RippledError::rpcUNKNOWN_COMMAND};
-        }
-
-        try
-        {
-            perfLog_.debug() << ctx.tag() << " start executing rpc `" << ctx.method << '`';
-
-            auto const isAdmin = adminVerifier_.isAdmin(ctx.clientIp);
-            auto const context = Context{ctx.yield, ctx.session, isAdmin, ctx.clientIp, ctx.apiVersion};
-            auto const v = (*method).process(ctx.params, context);
-
-            perfLog_.debug() << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
-
-            if (v)
-                return v->as_object();
-            else
-            {
-                notifyErrored(ctx.method);
-                return Status{v.error()};
-            }
-        }
-        catch (Backend::DatabaseTimeout const& t)
-        {
-            log_.error() << "Database timeout";
-            notifyTooBusy();
-
-            return Status{RippledError::rpcTOO_BUSY};
-        }
-        catch (std::exception const& ex)
-        {
-            log_.error() << ctx.tag() << "Caught exception: " << ex.what();
-            notifyInternalError();
+        auto result = [&] {
+            util::WorkCost::Scope const costScope{ctx.cost};
+            return doBuildResponse(ctx);
+        }();
 
-            return Status{RippledError::rpcINTERNAL};
-        }
+        dosGuard_.get().addCost(ctx.clientIp, *ctx.cost);
+        return result;
     }
 
     /**
      * @brief Used to schedule request processing onto the work queue
      * @param func The lambda to execute when this request is handled
      * @param ip The ip address for which this request is being executed
+     * @param method The method of the request, which determines its priority
      */
     template <typename Fn>
     bool
-    post(Fn&& func, std::string const& ip)
+    post(Fn&& func, std::string const& ip, std::string_view method)
     {
-        return workQueue_.get().postCoro(std::forward<Fn>(func), dosGuard_.get().isWhiteListed(ip));
+        auto& workQueue = workQueue_.get();
+        return workQueue.postCoro(
+            std::forward<Fn>(func), dosGuard_.get().isWhiteListed(ip), workQueue.priorityOf(method), ip);
     }
 
     /**
@@ -266,7 +238,136 @@ public:
         counters_.get().onInternalError();
     }
 
+    /**
+     * @brief Notify the system that messages queued for a slow websocket client were dropped
+     *
+     * @param count The number of messages dropped
+     */
+    void
+    notifyMessagesDropped(std::uint64_t count)
+    {
+        counters_.get().onMessagesDropped(count);
+    }
+
+    /**
+     * @brief Notify the system that a websocket client was disconnected because it could not keep up
+     */
+    void
+    notifySlowConsumerDisconnected()
+    {
+        counters_.get().onSlowConsumerDisconnected();
+    }
+
 private:
+    Result
+    doBuildResponse(Web::Context const& ctx)
+    {
+        if (forwardingProxy_.shouldForward(ctx))
+        {
+            // the time spent waiting for rippled is not work done by this server
+            util::WorkCost::Suspension const suspension;
+            return forwardingProxy_.forward(ctx);
+        }
+
+        auto const isAdmin = adminVerifier_.isAdmin(ctx.clientIp);
+        auto const cacheKey = responseCache_
+            ? ResponseCache::makeKey(ctx.method, ctx.params, ctx.apiVersion, isAdmin, ctx.range)
+            : std::nullopt;
+
+        if (cacheKey)
+        {
+            if (auto cached = responseCache_->get(*cacheKey); cached)
+            {
+                counters_.get().onResponseCacheHit();
+                perfLog_.debug() << ctx.tag() << " served rpc `" << ctx.method << "` from the response cache";
+                return SerializedResult{std::move(cached)};
+            }
+
+            counters_.get().onResponseCacheMiss();
+        }
+
+        if (backend_->isTooBusy())
+        {
+            log_.error() << "Database is too busy. Rejecting request";
+            notifyTooBusy();  // TODO: should we add ctx.method if we have it?
+            return Status{RippledError::rpcTOO_BUSY};
+        }
+
+        auto const method = handlerProvider_->getHandler(ctx.method);
+        if (!method)
+        {
+            notifyUnknownCommand();
+            return Status{RippledError::rpcUNKNOWN_COMMAND};
+        }
+
+        try
+        {
+            perfLog_.debug() << ctx.tag() << " start executing rpc `" << ctx.method << '`';
+
+            auto const context = Context{ctx.yield, ctx.session, isAdmin, ctx.clientIp, ctx.apiVersion};
+            if (method->streamsOutput())
+                return buildSerializedResponse(ctx, *method, context, cacheKey);
+
+            auto const v = (*method).process(ctx.params, context);
+
+            perfLog_.debug() << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+
+            if (v)
+            {
+                if (cacheKey)
+                    responseCache_->put(*cacheKey, v->as_object());
+
+                return v->as_object();
+            }
+            else
+            {
+                notifyErrored(ctx.method);
+                return Status{v.error()};
+            }
+        }
+        catch (Backend::DatabaseTimeout const& t)
+        {
+            log_.error() << "Database timeout";
+            notifyTooBusy();
+
+            return Status{RippledError::rpcTOO_BUSY};
+        }
+        catch (std::exception const& ex)
+        {
+            log_.error() << ctx.tag() << "Caught exception: " << ex.what();
+            notifyInternalError();
+
+            return Status{RippledError::rpcINTERNAL};
+        }
+    }
+
+    /**
+     * @brief Run a handler that writes its output straight into the serialized result, for large results such as
+     * expanded ledgers and long account histories
+     */
+    Result
+    buildSerializedResponse(
+        Web::Context const& ctx,
+        AnyHandler const& method,
+        Context const& context,
+        std::optional<std::string> const& cacheKey)
+    {
+        auto v = method.processSerialized(ctx.params, context);
+        perfLog_.debug() << ctx.tag() << " finish executing rpc `" << ctx.method << '`';
+
+        if (!v)
+        {
+            notifyErrored(ctx.method);
+            return Status{v.error()};
+        }
+
+        auto json = std::make_shared<std::string const>(std::move(*v));
+        if (cacheKey)
+            responseCache_->put(*cacheKey, json);
+
+        return SerializedResult{std::move(json)};
+    }
+
     bool
     validHandler(std::string const& method) const
     {
@@ -25,6 +25,8 @@
 #include <util/Profiler.h>
 
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/protocol/STArray.h>
+#include <ripple/protocol/STInteger.h>
 #include <ripple/protocol/nftPageMask.h>
 #include <boost/algorithm/string.hpp>
 #include <boost/format.hpp>
@@ -181,12 +183,140 @@ deserializeTxPlusMeta(Backend::TransactionAndMetadata const& blobs, std::uint32_
     return {tx, m};
 }
 
+namespace {
+
+/**
+ * @brief Fields of a JSON object that is still being built, keyed by their name
+ */
+using JsonFields = std::vector<std::pair<std::string_view, boost::json::value>>;
+
+boost::json::value
+fieldToJson(ripple::STBase const& field);
+
+JsonFields
+collectFields(ripple::STObject const& obj)
+{
+    JsonFields fields;
+    fields.reserve(obj.getCount() + 1);
+
+    for (auto const& field : obj)
+    {
+        if (field.getSType() != ripple::STI_NOTPRESENT)
+            fields.emplace_back(field.getFName().fieldName, fieldToJson(field));
+    }
+
+    return fields;
+}
+
+/**
+ * @brief Build the object the same way a Json::Value object would hold it, i.e. with its keys sorted
+ */
+boost::json::object
+toObject(JsonFields&& fields)
+{
+    std::stable_sort(
+        std::begin(fields), std::end(fields), [](auto const& lhs, auto const& rhs) { return lhs.first < rhs.first; });
+
+    boost::json::object json;
+    json.reserve(fields.size());
+    for (auto& [key, value] : fields)
+        json.insert_or_assign(key, std::move(value));
+
+    return json;
+}
+
+/**
+ * @brief Same output as ripple::STBase::getJson(JsonOptions::none) without going through Json::Value
+ *
+ * Fields whose JSON depends on rippled's format tables (transaction and ledger entry types, result codes) and the
+ * less common types are converted from their own getJson, which only builds the Json::Value of that one field.
+ */
+boost::json::value
+fieldToJson(ripple::STBase const& field)
+{
+    switch (field.getSType())
+    {
+        case ripple::STI_OBJECT:
+            return toObject(collectFields(static_cast<ripple::STObject const&>(field)));
+
+        case ripple::STI_ARRAY: {
+            auto const& array = static_cast<ripple::STArray const&>(field);
+            boost::json::array json;
+            json.reserve(array.size());
+            for (auto const& object : array)
+            {
+                if (object.getSType() == ripple::STI_NOTPRESENT)
+                    continue;
+
+                auto& inner = json.emplace_back(boost::json::object{}).as_object();
+                inner[object.getFName().fieldName] = toObject(collectFields(object));
+            }
+
+            return json;
+        }
+
+        case ripple::STI_AMOUNT: {
+            auto const& amount = static_cast<ripple::STAmount const&>(field);
+            if (amount.native())
+                return amount.getText();
+
+            return boost::json::object{
+                {JS(currency), ripple::to_string(amount.getCurrency())},
+                {JS(issuer), ripple::to_string(amount.getIssuer())},
+                {JS(value), amount.getText()}};
+        }
+
+        case ripple::STI_ACCOUNT:
+        case ripple::STI_VL:
+        case ripple::STI_HASH128:
+        case ripple::STI_HASH160:
+        case ripple::STI_HASH256:
+            return field.getText();
+
+        case ripple::STI_UINT32:
+            return static_cast<std::int64_t>(static_cast<ripple::STUInt32 const&>(field).value());
+
+        case ripple::STI_UINT16:
+            if (field.getFName() != ripple::sfLedgerEntryType && field.getFName() != ripple::sfTransactionType)
+                return static_cast<std::int64_t>(static_cast<ripple::STUInt16 const&>(field).value());
+            break;
+
+        case ripple::STI_UINT8:
+            if (field.getFName() != ripple::sfTransactionResult)
+                return static_cast<std::int64_t>(static_cast<ripple::STUInt8 const&>(field).value());
+            break;
+
+        default:
+            break;
+    }
+
+    return toBoostJson(field.getJson(ripple::JsonOptions::none));
+}
+
+}  // namespace
+
 boost::json::object
 toJson(ripple::STBase const& obj)
 {
-    boost::json::value value = boost::json::parse(obj.getJson(ripple::JsonOptions::none).toStyledString());
+    // STTx and STLedgerEntry add a field of their own to the JSON of the object
+    if (auto const* txn = dynamic_cast<ripple::STTx const*>(&obj))
+    {
+        auto fields = collectFields(*txn);
+        fields.emplace_back(JS(hash), ripple::to_string(txn->getTransactionID()));
+        return toObject(std::move(fields));
+    }
 
-    return value.as_object();
+    if (auto const* sle = dynamic_cast<ripple::SLE const*>(&obj))
+    {
+        auto fields = collectFields(*sle);
+        fields.emplace_back(JS(index), ripple::to_string(sle->key()));
+        return toObject(std::move(fields));
+    }
+
+    if (auto const* object = dynamic_cast<ripple::STObject const*>(&obj))
+        return toObject(collectFields(*object));
+
+    return toBoostJson(obj.getJson(ripple::JsonOptions::none)).as_object();
 }
 
 std::pair<boost::json::object, boost::json::object>
@@ -220,23 +350,52 @@ insertDeliveredAmount(
 boost::json::object
 toJson(ripple::TxMeta const& meta)
 {
-    boost::json::value value = boost::json::parse(meta.getJson(ripple::JsonOptions::none).toStyledString());
-
-    return value.as_object();
+    return toObject(collectFields(meta.getAsObject()));
 }
 
 boost::json::value
 toBoostJson(Json::Value const& value)
 {
-    boost::json::value boostValue = boost::json::parse(value.toStyledString());
+    // numbers are stored the way boost::json::parse would read them back from the text of the value
+    switch (value.type())
+    {
+        case Json::nullValue:
+            return nullptr;
+        case Json::intValue:
+            return static_cast<std::int64_t>(value.asInt());
+        case Json::uintValue:
+            return static_cast<std::int64_t>(value.asUInt());
+        case Json::realValue:
+            return value.asDouble();
+        case Json::stringValue:
+            return value.asString();
+        case Json::booleanValue:
+            return value.asBool();
+        case Json::arrayValue: {
+            boost::json::array json;
+            json.reserve(value.size());
+            for (auto const& element : value)
+                json.push_back(toBoostJson(element));
+
+            return json;
+        }
+        case Json::objectValue: {
+            boost::json::object json;
+            json.reserve(value.size());
+            for (auto it = value.begin(); it != value.end(); ++it)
+                json.emplace(it.memberName(), toBoostJson(*it));
+
+            return json;
+        }
+    }
 
-    return boostValue;
+    return nullptr;
 }
 
 boost::json::object
 toJson(ripple::SLE const& sle)
 {
-    boost::json::value value = boost::json::parse(sle.getJson(ripple::JsonOptions::none).toStyledString());
+    boost::json::value value = toJson(static_cast<ripple::STBase const&>(sle));
     if (sle.getType() == ripple::ltACCOUNT_ROOT)
     {
         if (sle.isFieldPresent(ripple::sfEmailHash))
@@ -372,6 +531,37 @@ getLedgerInfoFromHashOrSeq(
     return *lgrInfo;
 }
 
+boost::asio::awaitable<std::variant<Status, ripple::LedgerInfo>>
+getLedgerInfoFromHashOrSeq(
+    BackendInterface const& backend,
+    boost::asio::use_awaitable_t<> token,
+    std::optional<std::string> ledgerHash,
+    std::optional<uint32_t> ledgerIndex,
+    uint32_t maxSeq)
+{
+    std::optional<ripple::LedgerInfo> lgrInfo;
+    auto const err = Status{RippledError::rpcLGR_NOT_FOUND, "ledgerNotFound"};
+    if (ledgerHash)
+    {
+        ripple::uint256 ledgerHash256{std::string_view(*ledgerHash)};
+        lgrInfo = co_await backend.fetchLedgerByHash(ledgerHash256, token);
+        if (!lgrInfo || lgrInfo->seq > maxSeq)
+            co_return err;
+
+        co_return *lgrInfo;
+    }
+    auto const ledgerSequence = ledgerIndex.value_or(maxSeq);
+    // return without check db
+    if (ledgerSequence > maxSeq)
+        co_return err;
+
+    lgrInfo = co_await backend.fetchLedgerBySequence(ledgerSequence, token);
+    if (!lgrInfo)
+        co_return err;
+
+    co_return *lgrInfo;
+}
+
 std::vector<unsigned char>
 ledgerInfoToBlob(ripple::LedgerInfo const& info, bool includeHash)
 {
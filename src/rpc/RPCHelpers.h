@@ -101,6 +101,14 @@ getLedgerInfoFromHashOrSeq(
     std::optional<uint32_t> ledgerIndex,
     uint32_t maxSeq);
 
+boost::asio::awaitable<std::variant<Status, ripple::LedgerInfo>>
+getLedgerInfoFromHashOrSeq(
+    BackendInterface const& backend,
+    boost::asio::use_awaitable_t<> token,
+    std::optional<std::string> ledgerHash,
+    std::optional<uint32_t> ledgerIndex,
+    uint32_t maxSeq);
+
 std::variant<Status, AccountCursor>
 traverseOwnedNodes(
     BackendInterface const& backend,
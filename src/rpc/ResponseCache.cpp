@@ -0,0 +1,194 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/ResponseCache.h>
+
+#include <algorithm>
+#include <charconv>
+#include <set>
+#include <vector>
+
+namespace RPC {
+
+namespace {
+
+// methods whose response depends only on the parameters once the ledger asked about is validated
+std::set<std::string> const CACHEABLE_METHODS =
+    {"ledger", "tx", "transaction_entry", "ledger_entry", "account_info", "book_changes"};
+
+// fields that identify the request or select the API version rather than ask for something
+std::set<std::string_view> const IGNORED_FIELDS = {"id", "command", "method", "api_version", "jsonrpc", "ripplerpc"};
+
+boost::json::value
+normalized(boost::json::value const& value)
+{
+    if (value.is_array())
+    {
+        boost::json::array result;
+        result.reserve(value.as_array().size());
+        for (auto const& item : value.as_array())
+            result.push_back(normalized(item));
+
+        return result;
+    }
+
+    if (!value.is_object())
+        return value;
+
+    std::vector<boost::json::key_value_pair const*> fields;
+    for (auto const& field : value.as_object())
+        fields.push_back(&field);
+
+    std::sort(fields.begin(), fields.end(), [](auto const* lhs, auto const* rhs) { return lhs->key() < rhs->key(); });
+
+    boost::json::object result;
+    for (auto const* field : fields)
+        result.emplace(field->key(), normalized(field->value()));
+
+    return result;
+}
+
+/**
+ * @return true if the request asks about one ledger, by hash or by an index within the range
+ */
+bool
+isForSpecificLedger(boost::json::object const& params, Backend::LedgerRange const& range)
+{
+    if (params.contains("ledger_hash"))
+        return params.at("ledger_hash").is_string();
+
+    if (!params.contains("ledger_index"))
+        return false;
+
+    auto const& index = params.at("ledger_index");
+    std::optional<std::uint64_t> seq;
+    if (index.is_int64() && index.as_int64() >= 0)
+    {
+        seq = static_cast<std::uint64_t>(index.as_int64());
+    }
+    else if (index.is_uint64())
+    {
+        seq = index.as_uint64();
+    }
+    else if (index.is_string())
+    {
+        // "validated", "current" and "closed" move with the network
+        auto const& str = index.as_string();
+        std::uint64_t parsed = 0;
+        if (auto const [end, ec] = std::from_chars(str.data(), str.data() + str.size(), parsed);
+            ec == std::errc{} && end == str.data() + str.size())
+            seq = parsed;
+    }
+
+    return seq && *seq >= range.minSequence && *seq <= range.maxSequence;
+}
+
+}  // namespace
+
+std::optional<std::string>
+ResponseCache::makeKey(
+    std::string const& method,
+    boost::json::object const& params,
+    std::uint32_t apiVersion,
+    bool isAdmin,
+    Backend::LedgerRange const& range)
+{
+    if (!CACHEABLE_METHODS.contains(method))
+        return std::nullopt;
+
+    // a transaction found by tx is in a validated ledger whatever the parameters
+    if (method != "tx" && !isForSpecificLedger(params, range))
+        return std::nullopt;
+
+    boost::json::object relevant;
+    for (auto const& [key, value] : params)
+    {
+        if (!IGNORED_FIELDS.contains(std::string_view{key.data(), key.size()}))
+            relevant.emplace(key, value);
+    }
+
+    // admins may be answered with more than other clients for the same parameters
+    return method + '/' + std::to_string(apiVersion) + (isAdmin ? "/admin/" : "/") +
+        boost::json::serialize(normalized(relevant));
+}
+
+std::shared_ptr<std::string const>
+ResponseCache::get(std::string const& key)
+{
+    std::scoped_lock lck{mtx_};
+    auto const it = index_.find(key);
+    if (it == index_.end())
+        return nullptr;
+
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->response;
+}
+
+void
+ResponseCache::put(std::string key, boost::json::object const& response)
+{
+    if (response.contains("status") || response.contains("error"))
+        return;
+
+    put(std::move(key), std::make_shared<std::string const>(boost::json::serialize(response)));
+}
+
+void
+ResponseCache::put(std::string key, std::shared_ptr<std::string const> response)
+{
+    auto const size = key.size() + response->size();
+    if (size > maxBytes_)
+        return;
+
+    std::scoped_lock lck{mtx_};
+    if (auto const it = index_.find(key); it != index_.end())
+    {
+        bytes_ -= it->second->key.size() + it->second->response->size();
+        entries_.erase(it->second);
+        index_.erase(it);
+    }
+
+    entries_.push_front(Entry{std::move(key), std::move(response)});
+    index_.emplace(entries_.front().key, entries_.begin());
+    bytes_ += size;
+
+    while (bytes_ > maxBytes_)
+    {
+        auto const& last = entries_.back();
+        bytes_ -= last.key.size() + last.response->size();
+        index_.erase(last.key);
+        entries_.pop_back();
+    }
+}
+
+std::size_t
+ResponseCache::bytes() const
+{
+    std::scoped_lock lck{mtx_};
+    return bytes_;
+}
+
+std::size_t
+ResponseCache::size() const
+{
+    std::scoped_lock lck{mtx_};
+    return entries_.size();
+}
+
+}  // namespace RPC
@@ -0,0 +1,123 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <backend/Types.h>
+
+#include <boost/json.hpp>
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+
+namespace RPC {
+
+/**
+ * @brief Serialized responses to requests whose answer can no longer change
+ *
+ * Only some methods asked about one specific ledger of the range, by index or hash, are cached; asking for the
+ * current or validated ledger always goes to the handler. Responses are kept within a byte budget, evicting the least
+ * recently used first.
+ */
+class ResponseCache
+{
+    struct Entry
+    {
+        std::string key;
+        std::shared_ptr<std::string const> response;
+    };
+
+    std::size_t const maxBytes_;
+
+    mutable std::mutex mtx_;
+    std::list<Entry> entries_;  // most recently used first
+    std::unordered_map<std::string_view, std::list<Entry>::iterator> index_;
+    std::size_t bytes_ = 0;
+
+public:
+    /**
+     * @param maxBytes The budget for the keys and serialized responses kept
+     */
+    explicit ResponseCache(std::size_t maxBytes) : maxBytes_(maxBytes)
+    {
+    }
+
+    /**
+     * @brief The key a request is cached under
+     *
+     * The parameters are normalized: the order of the fields and the fields that don't change the response, like the
+     * request id, make no difference.
+     *
+     * @param method The method of the request
+     * @param params The parameters of the request
+     * @param apiVersion The API version of the request
+     * @param isAdmin Whether the request comes from an admin
+     * @param range The range of ledgers in the database
+     * @return The key; nothing if the response may change over time
+     */
+    static std::optional<std::string>
+    makeKey(
+        std::string const& method,
+        boost::json::object const& params,
+        std::uint32_t apiVersion,
+        bool isAdmin,
+        Backend::LedgerRange const& range);
+
+    /**
+     * @return The serialized response to the request with the given key, or nullptr if it is not cached
+     */
+    std::shared_ptr<std::string const>
+    get(std::string const& key);
+
+    /**
+     * @brief Cache a successful response
+     *
+     * A response bigger than the whole budget is not cached. Neither is a response with a "status" or "error" field,
+     * so that cached responses can be written as they are, with the status added at their end.
+     */
+    void
+    put(std::string key, boost::json::object const& response);
+
+    /**
+     * @brief Cache a successful response that is serialized already
+     *
+     * The response must be an object without a "status" or "error" field.
+     */
+    void
+    put(std::string key, std::shared_ptr<std::string const> response);
+
+    /**
+     * @return The bytes used by the keys and responses kept
+     */
+    std::size_t
+    bytes() const;
+
+    /**
+     * @return The number of responses kept
+     */
+    std::size_t
+    size() const;
+};
+
+}  // namespace RPC
@@ -19,10 +19,32 @@
 
 #include <rpc/WorkQueue.h>
 
-WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize)
+namespace {
+
+// weight of the latest wait time in the moving average
+constexpr double WAIT_SMOOTHING = 0.125;
+
+constexpr std::array<std::string_view, WorkQueue::NUM_PRIORITIES> PRIORITY_NAMES = {"high", "normal", "low"};
+
+}  // namespace
+
+WorkQueue::WorkQueue(std::uint32_t numWorkers, uint32_t maxSize) : WorkQueue(numWorkers, Settings{.maxSize = maxSize})
 {
-    if (maxSize != 0)
-        maxSize_ = maxSize;
+}
+
+WorkQueue::WorkQueue(std::uint32_t numWorkers, Settings settings)
+    : maxWait_{settings.maxWait}, weights_{settings.weights}, priorities_{defaultPriorities()}
+{
+    if (settings.maxSize != 0)
+        maxSize_ = settings.maxSize;
+
+    for (auto& weight : weights_)
+        weight = std::max(weight, 1u);
+
+    for (auto& [method, priority] : settings.priorities)
+        priorities_[method] = priority;
+
+    credit_ = weights_[current_];
 
     while (--numWorkers)
         threads_.emplace_back([this] { ioc_.run(); });
@@ -34,3 +56,207 @@ WorkQueue::~WorkQueue()
     for (auto& thread : threads_)
         thread.join();
 }
+
+WorkQueue
+WorkQueue::make_WorkQueue(clio::Config const& config)
+{
+    static clio::Logger log{"RPC"};
+    auto const serverConfig = config.section("server");
+    auto const numThreads = config.valueOr<uint32_t>("workers", std::thread::hardware_concurrency());
+
+    Settings settings;
+    settings.maxSize = serverConfig.valueOr<uint32_t>("max_queue_size", 0);  // 0 is no limit
+    settings.maxWait = std::chrono::milliseconds{serverConfig.valueOr<uint32_t>("max_queue_wait_ms", 0)};
+
+    for (std::size_t i = 0; i < NUM_PRIORITIES; ++i)
+    {
+        auto const name = std::string{PRIORITY_NAMES[i]};
+        settings.weights[i] = serverConfig.valueOr<uint32_t>("priority_weights." + name, settings.weights[i]);
+
+        for (auto const& method : serverConfig.arrayOr(name + "_priority_methods", {}))
+            settings.priorities[method.value<std::string>()] = static_cast<Priority>(i);
+    }
+
+    log.info() << "Number of workers = " << numThreads << ". Max queue size = " << settings.maxSize
+               << ". Max queue wait = " << settings.maxWait.count() << "ms";
+    return WorkQueue{numThreads, std::move(settings)};
+}
+
+std::unordered_map<std::string, WorkQueue::Priority>
+WorkQueue::defaultPriorities()
+{
+    // cheap lookups of a single object or of the server state, and the ledgers fed to read-only nodes
+    static constexpr auto high = std::array{
+        "/ledger_feed",
+        "account_info",
+        "fee",
+        "ledger_closed",
+        "ledger_current",
+        "ledger_entry",
+        "ledger_range",
+        "ping",
+        "random",
+        "server_info",
+        "server_state",
+        "transaction_entry",
+        "tx"};
+
+    // scans of many objects or transactions, including the download of cache pages
+    static constexpr auto low = std::array{
+        "/cache",
+        "account_objects",
+        "account_tx",
+        "book_changes",
+        "gateway_balances",
+        "ledger",
+        "ledger_data",
+        "nft_history",
+        "noripple_check"};
+
+    std::unordered_map<std::string, Priority> priorities;
+    for (auto const* method : high)
+        priorities[method] = Priority::HIGH;
+
+    for (auto const* method : low)
+        priorities[method] = Priority::LOW;
+
+    return priorities;
+}
+
+WorkQueue::Priority
+WorkQueue::priorityOf(std::string_view method) const
+{
+    if (auto const it = priorities_.find(std::string{method}); it != std::end(priorities_))
+        return it->second;
+
+    return Priority::NORMAL;
+}
+
+bool
+WorkQueue::admit(Priority priority)
+{
+    if (curSize_ >= maxSize_)
+    {
+        log_.warn() << "Queue is full. rejecting job. current size = " << curSize_ << " max size = " << maxSize_;
+        return false;
+    }
+
+    if (maxWait_.count() == 0)
+        return true;
+
+    // the recent wait times only tell how long a new job would wait while jobs of its class are queued
+    std::scoped_lock const lck{mtx_};
+    auto const& queue = classes_[static_cast<std::size_t>(priority)];
+    auto const maxWaitUs = std::chrono::duration_cast<std::chrono::microseconds>(maxWait_).count();
+    if (queue.size > 0 && queue.waitUs > maxWaitUs)
+    {
+        log_.warn() << "Queue wait is too long. rejecting job. "
+                    << PRIORITY_NAMES[static_cast<std::size_t>(priority)] << " priority wait = " << queue.waitUs
+                    << "us max wait = " << maxWaitUs << "us";
+        return false;
+    }
+
+    return true;
+}
+
+void
+WorkQueue::push(Priority priority, std::string const& client, Job&& job)
+{
+    std::scoped_lock const lck{mtx_};
+    classes_[static_cast<std::size_t>(priority)].push(client, std::move(job));
+}
+
+WorkQueue::Job
+WorkQueue::pop()
+{
+    auto [job, priority] = [this] {
+        std::scoped_lock const lck{mtx_};
+
+        // weighted round robin over the classes that have jobs waiting; one job was pushed for every pop
+        while (classes_[current_].size == 0 || credit_ == 0)
+        {
+            current_ = (current_ + 1) % NUM_PRIORITIES;
+            credit_ = weights_[current_];
+        }
+
+        --credit_;
+        return std::make_pair(classes_[current_].pop(), current_);
+    }();
+
+    auto const wait =
+        std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::system_clock::now() - job.start).count();
+
+    {
+        std::scoped_lock const lck{mtx_};
+        auto& queue = classes_[priority];
+        ++queue.queued;
+        queue.durationUs += wait;
+        queue.waitUs += WAIT_SMOOTHING * (static_cast<double>(wait) - queue.waitUs);
+    }
+
+    // increment queued_ here, in the same place we implement durationUs_
+    ++queued_;
+    durationUs_ += wait;
+    log_.info() << "WorkQueue wait time = " << wait << " queue size = " << curSize_ << " priority = "
+                << PRIORITY_NAMES[priority];
+
+    return std::move(job);
+}
+
+boost::json::object
+WorkQueue::report() const
+{
+    auto obj = boost::json::object{};
+
+    obj["queued"] = queued_;
+    obj["queued_duration_us"] = durationUs_;
+    obj["current_queue_size"] = curSize_;
+    obj["max_queue_size"] = maxSize_;
+    obj["max_queue_wait_ms"] = maxWait_.count();
+
+    auto classes = boost::json::object{};
+    std::scoped_lock const lck{mtx_};
+    for (std::size_t i = 0; i < NUM_PRIORITIES; ++i)
+    {
+        auto const& queue = classes_[i];
+        classes[PRIORITY_NAMES[i]] = boost::json::object{
+            {"weight", weights_[i]},
+            {"queued", queue.queued},
+            {"queued_duration_us", queue.durationUs},
+            {"current_queue_size", queue.size},
+            {"recent_wait_us", static_cast<std::uint64_t>(queue.waitUs)}};
+    }
+    obj["priorities"] = std::move(classes);
+
+    return obj;
+}
+
+void
+WorkQueue::ClassQueue::push(std::string const& client, Job&& job)
+{
+    auto& jobs = clients[client];
+    if (jobs.empty())
+        turns.push_back(client);
+
+    jobs.push_back(std::move(job));
+    ++size;
+}
+
+WorkQueue::Job
+WorkQueue::ClassQueue::pop()
+{
+    auto const client = std::move(turns.front());
+    turns.pop_front();
+
+    auto& jobs = clients[client];
+    auto job = std::move(jobs.front());
+    jobs.pop_front();
+
+    if (jobs.empty())
+        clients.erase(client);
+    else
+        turns.push_back(client);
+
+    --size;
+    return job;
+}
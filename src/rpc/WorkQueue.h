@@ -26,67 +26,137 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/json.hpp>
 
+#include <array>
+#include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <queue>
 #include <shared_mutex>
+#include <string_view>
 #include <thread>
-
+#include <unordered_map>
+
+/**
+ * @brief Queue of the jobs (requests) waiting for a worker
+ *
+ * Jobs belong to a priority class, determined by the RPC method. Classes are served in weighted round robin and,
+ * within a class, the clients that have jobs waiting are served in turn, so a burst of requests from one client only
+ * delays that client.
+ */
 class WorkQueue
 {
+public:
+    enum class Priority { HIGH, NORMAL, LOW };
+
+    static constexpr std::size_t NUM_PRIORITIES = 3;
+
+    /**
+     * @brief Settings of the queue
+     */
+    struct Settings
+    {
+        std::uint32_t maxSize = 0;  // 0 is no limit
+        std::chrono::milliseconds maxWait{0};  // 0 is no limit
+        std::array<std::uint32_t, NUM_PRIORITIES> weights = {4, 2, 1};
+        std::unordered_map<std::string, Priority> priorities;  // on top of defaultPriorities()
+    };
+
+private:
+    using JobType = std::function<void(boost::asio::yield_context)>;
+
+    struct Job
+    {
+        JobType run;
+        std::chrono::system_clock::time_point start;
+    };
+
+    // jobs of one priority class, queued per client
+    struct ClassQueue
+    {
+        std::unordered_map<std::string, std::deque<Job>> clients;
+        std::deque<std::string> turns;  // clients with jobs waiting, in the order they are served
+        std::size_t size = 0;
+
+        // these are cumulative for the lifetime of the process
+        std::uint64_t queued = 0;
+        std::uint64_t durationUs = 0;
+
+        // moving average of the recent wait times
+        double waitUs = 0;
+
+        void
+        push(std::string const& client, Job&& job);
+
+        Job
+        pop();
+    };
+
     // these are cumulative for the lifetime of the process
     std::atomic_uint64_t queued_ = 0;
     std::atomic_uint64_t durationUs_ = 0;
 
     std::atomic_uint64_t curSize_ = 0;
     uint32_t maxSize_ = std::numeric_limits<uint32_t>::max();
+    std::chrono::milliseconds maxWait_{0};
+    std::array<std::uint32_t, NUM_PRIORITIES> weights_;
+    std::unordered_map<std::string, Priority> priorities_;
     clio::Logger log_{"RPC"};
 
+    mutable std::mutex mtx_;
+    std::array<ClassQueue, NUM_PRIORITIES> classes_;
+    std::size_t current_ = 0;  // class being served
+    std::uint32_t credit_ = 0;  // jobs the current class may still run before its turn ends
+
     std::vector<std::thread> threads_ = {};
     boost::asio::io_context ioc_ = {};
     std::optional<boost::asio::io_context::work> work_{ioc_};
 
 public:
     WorkQueue(std::uint32_t numWorkers, uint32_t maxSize = 0);
+    WorkQueue(std::uint32_t numWorkers, Settings settings);
     ~WorkQueue();
 
     static WorkQueue
-    make_WorkQueue(clio::Config const& config)
-    {
-        static clio::Logger log{"RPC"};
-        auto const serverConfig = config.section("server");
-        auto const numThreads = config.valueOr<uint32_t>("workers", std::thread::hardware_concurrency());
-        auto const maxQueueSize = serverConfig.valueOr<uint32_t>("max_queue_size", 0);  // 0 is no limit
-
-        log.info() << "Number of workers = " << numThreads << ". Max queue size = " << maxQueueSize;
-        return WorkQueue{numThreads, maxQueueSize};
-    }
-
+    make_WorkQueue(clio::Config const& config);
+
+    /**
+     * @return The methods that are not in the normal priority class by default
+     */
+    static std::unordered_map<std::string, Priority>
+    defaultPriorities();
+
+    /**
+     * @return The priority class of the given RPC method
+     */
+    Priority
+    priorityOf(std::string_view method) const;
+
+    /**
+     * @brief Queue a job
+     *
+     * @param f The job
+     * @param isWhiteListed Whether the client is whitelisted; such jobs are never rejected
+     * @param priority The priority class of the job
+     * @param client The client the job is for, jobs of different clients are served in turn
+     * @return true if the job was queued; false if it was rejected because the queue is full
+     */
     template <typename F>
     bool
-    postCoro(F&& f, bool isWhiteListed)
+    postCoro(F&& f, bool isWhiteListed, Priority priority = Priority::NORMAL, std::string const& client = {})
     {
-        if (curSize_ >= maxSize_ && !isWhiteListed)
-        {
-            log_.warn() << "Queue is full. rejecting job. current size = " << curSize_ << " max size = " << maxSize_;
+        if (!isWhiteListed && !admit(priority))
             return false;
-        }
 
         ++curSize_;
-        auto start = std::chrono::system_clock::now();
+        push(priority, client, Job{std::forward<F>(f), std::chrono::system_clock::now()});
 
-        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job at the front
-        // of the job queue.
-        boost::asio::spawn(ioc_, [this, f = std::move(f), start](auto yield) mutable {
-            auto const run = std::chrono::system_clock::now();
-            auto const wait = std::chrono::duration_cast<std::chrono::microseconds>(run - start).count();
-
-            // increment queued_ here, in the same place we implement durationUs_
-            ++queued_;
-            durationUs_ += wait;
-            log_.info() << "WorkQueue wait time = " << wait << " queue size = " << curSize_;
-
-            f(yield);
+        // Each time we enqueue a job, we want to post a symmetrical job that will dequeue and run the job that is
+        // next in line, which is not necessarily this one.
+        boost::asio::spawn(ioc_, [this](auto yield) {
+            auto job = pop();
+            job.run(yield);
 
             --curSize_;
         });
@@ -95,15 +165,21 @@ public:
     }
 
     boost::json::object
-    report() const
-    {
-        auto obj = boost::json::object{};
+    report() const;
 
-        obj["queued"] = queued_;
-        obj["queued_duration_us"] = durationUs_;
-        obj["current_queue_size"] = curSize_;
-        obj["max_queue_size"] = maxSize_;
+private:
+    /**
+     * @brief Whether a job of the given class can be queued
+     */
+    bool
+    admit(Priority priority);
 
-        return obj;
-    }
+    void
+    push(Priority priority, std::string const& client, Job&& job);
+
+    /**
+     * @brief Take the next job in line, recording how long it waited
+     */
+    Job
+    pop();
 };
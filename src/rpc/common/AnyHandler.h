@@ -23,6 +23,8 @@
 #include <rpc/common/Types.h>
 #include <rpc/common/impl/Processors.h>
 
+#include <boost/asio/awaitable.hpp>
+
 namespace RPC {
 
 /**
@@ -78,6 +80,45 @@ public:
         return pimpl_->process(value, ctx);
     }
 
+    /**
+     * @brief Process incoming JSON by the stored handler into a serialized result
+     *
+     * A handler whose output can be written piece by piece (see StreamingHandler) writes it straight into the result.
+     *
+     * @param value The JSON to process
+     * @param ctx Request context
+     * @return Serialized result or @ref Status on error
+     */
+    [[nodiscard]] SerializedReturnType
+    processSerialized(boost::json::value const& value, Context const& ctx) const
+    {
+        return pimpl_->processSerialized(value, ctx);
+    }
+
+    /**
+     * @return true if the stored handler writes its output piece by piece, so that processSerialized is preferred
+     */
+    [[nodiscard]] bool
+    streamsOutput() const
+    {
+        return pimpl_->streamsOutput();
+    }
+
+    /**
+     * @brief Process incoming JSON by the stored handler from a C++20 coroutine
+     *
+     * Handlers that are not coroutines themselves run on a stackful coroutine spawned for the call.
+     *
+     * @param value The JSON to process; must outlive the returned awaitable
+     * @param ctx Request context; must outlive the returned awaitable
+     * @return JSON result or @ref Status on error
+     */
+    [[nodiscard]] boost::asio::awaitable<ReturnType>
+    processAsync(boost::json::value const& value, AsyncContext const& ctx) const
+    {
+        return pimpl_->processAsync(value, ctx);
+    }
+
 private:
     struct Concept
     {
@@ -86,6 +127,15 @@ private:
         [[nodiscard]] virtual ReturnType
         process(boost::json::value const& value, Context const& ctx) const = 0;
 
+        [[nodiscard]] virtual boost::asio::awaitable<ReturnType>
+        processAsync(boost::json::value const& value, AsyncContext const& ctx) const = 0;
+
+        [[nodiscard]] virtual SerializedReturnType
+        processSerialized(boost::json::value const& value, Context const& ctx) const = 0;
+
+        [[nodiscard]] virtual bool
+        streamsOutput() const = 0;
+
         [[nodiscard]] virtual std::unique_ptr<Concept>
         clone() const = 0;
     };
@@ -106,6 +156,24 @@ private:
             return processor(handler, value, ctx);
         }
 
+        [[nodiscard]] boost::asio::awaitable<ReturnType>
+        processAsync(boost::json::value const& value, AsyncContext const& ctx) const override
+        {
+            return processor(handler, value, ctx);
+        }
+
+        [[nodiscard]] SerializedReturnType
+        processSerialized(boost::json::value const& value, Context const& ctx) const override
+        {
+            return processor.serialized(handler, value, ctx);
+        }
+
+        [[nodiscard]] bool
+        streamsOutput() const override
+        {
+            return StreamingHandler<HandlerType>;
+        }
+
         [[nodiscard]] std::unique_ptr<Concept>
         clone() const override
         {
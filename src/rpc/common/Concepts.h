@@ -20,7 +20,9 @@
 #pragma once
 
 #include <rpc/common/Types.h>
+#include <util/JsonWriter.h>
 
+#include <boost/asio/awaitable.hpp>
 #include <boost/json/value_from.hpp>
 #include <boost/json/value_to.hpp>
 
@@ -56,6 +58,9 @@ concept Processor = (Requirement<T> or Modifier<T>);
  *
  * Note that value_from and value_to should be implemented using tag_invoke
  * as per boost::json documentation for these functions.
+ *
+ * process either takes a @ref Context and runs on the stackful coroutine of the request, or takes an
+ * @ref AsyncContext and is a C++20 coroutine returning boost::asio::awaitable.
  */
 // clang-format off
 template <typename T>
@@ -68,15 +73,30 @@ concept ContextProcessWithoutInput = requires(T a, typename T::Output out, Conte
     { a.process(ctx) } -> std::same_as<HandlerReturnType<decltype(out)>>; 
 };
 
+template <typename T>
+concept CoroutineProcessWithInput = requires(
+    T a, typename T::Input in, typename T::Output out, AsyncContext const& ctx
+) {
+    { a.process(in, ctx) } -> std::same_as<boost::asio::awaitable<HandlerReturnType<decltype(out)>>>; 
+};
+
+template <typename T>
+concept CoroutineProcessWithoutInput = requires(T a, typename T::Output out, AsyncContext const& ctx) {
+    { a.process(ctx) } -> std::same_as<boost::asio::awaitable<HandlerReturnType<decltype(out)>>>; 
+};
+
 template <typename T>
 concept HandlerWithInput = requires(T a, uint32_t version) {
     { a.spec(version) } -> std::same_as<RpcSpecConstRef>; 
 }
-and ContextProcessWithInput<T>
+and (ContextProcessWithInput<T> or CoroutineProcessWithInput<T>)
 and boost::json::has_value_to<typename T::Input>::value;
 
 template <typename T>
-concept HandlerWithoutInput = ContextProcessWithoutInput<T>;
+concept HandlerWithoutInput = ContextProcessWithoutInput<T> or CoroutineProcessWithoutInput<T>;
+
+template <typename T>
+concept CoroutineHandler = CoroutineProcessWithInput<T> or CoroutineProcessWithoutInput<T>;
 
 template <typename T>
 concept Handler = 
@@ -87,4 +107,22 @@ concept Handler =
 and boost::json::has_value_from<typename T::Output>::value;
 // clang-format on
 
+/**
+ * @brief A concept for handler output that can be written into the response piece by piece
+ *
+ * Such output is written straight into the response by writeJson rather than converted into a boost::json value
+ * first, which copies it. writeJson must write the same object as the value_from conversion does, and that object
+ * never has a "status" or "error" field.
+ */
+// clang-format off
+template <typename T>
+concept StreamedOutput = requires(util::JsonWriter& writer, T const& output) {
+    writeJson(writer, output);
+};
+
+template <typename T>
+concept StreamingHandler = Handler<T> and HandlerWithInput<T> and ContextProcessWithInput<T>
+and StreamedOutput<typename T::Output>;
+// clang-format on
+
 }  // namespace RPC
@@ -27,6 +27,9 @@
 #include <boost/asio/spawn.hpp>
 #include <boost/json/value.hpp>
 
+#include <memory>
+#include <string>
+
 namespace Server {
 struct ConnectionBase;
 }
@@ -60,6 +63,11 @@ using HandlerReturnType = util::Expected<OutputType, Status>;
  */
 using ReturnType = util::Expected<boost::json::value, Status>;
 
+/**
+ * @brief Return type out of RPC engine for a result that is serialized as soon as the handler produced it
+ */
+using SerializedReturnType = util::Expected<std::string, Status>;
+
 struct RpcSpec;
 struct FieldSpec;
 
@@ -80,7 +88,30 @@ struct Context
     uint32_t apiVersion = 0u;  // invalid by default
 };
 
-using Result = std::variant<Status, boost::json::object>;
+/**
+ * @brief Context of a handler that runs as a C++20 coroutine
+ *
+ * Same as @ref Context without the yield_context: such a handler awaits the backend instead of yielding.
+ */
+struct AsyncContext
+{
+    std::shared_ptr<Server::ConnectionBase> session;
+    bool isAdmin = false;
+    std::string clientIp;
+    uint32_t apiVersion = 0u;  // invalid by default
+};
+
+/**
+ * @brief A successful result that is serialized already, such as a response of the response cache
+ *
+ * It is written into the response as it is, without being parsed and serialized again.
+ */
+struct SerializedResult
+{
+    std::shared_ptr<std::string const> json;
+};
+
+using Result = std::variant<Status, boost::json::object, SerializedResult>;
 
 struct AccountCursor
 {
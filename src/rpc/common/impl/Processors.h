@@ -22,6 +22,9 @@
 #include <rpc/common/APIVersion.h>
 #include <rpc/common/Concepts.h>
 #include <rpc/common/Types.h>
+#include <util/Coroutine.h>
+
+#include <boost/asio/awaitable.hpp>
 
 namespace RPC::detail {
 
@@ -36,16 +39,19 @@ struct DefaultProcessor final
     {
         using boost::json::value_from;
         using boost::json::value_to;
-        if constexpr (HandlerWithInput<HandlerType>)
+        if constexpr (CoroutineHandler<HandlerType>)
+        {
+            auto const asyncCtx = AsyncContext{ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
+            return util::runAwaitable(ctx.yield.get(), (*this)(handler, value, asyncCtx));
+        }
+        else if constexpr (HandlerWithInput<HandlerType>)
         {
             // first we run validation against specified API version
-            auto const spec = handler.spec(ctx.apiVersion);
-            auto input = value;  // copy here, spec require mutable data
+            auto const input = validate(handler, value, ctx.apiVersion);
+            if (not input)
+                return Error{input.error()};  // forward Status
 
-            if (auto const ret = spec.process(input); not ret)
-                return Error{ret.error()};  // forward Status
-
-            auto const inData = value_to<typename HandlerType::Input>(input);
+            auto const inData = value_to<typename HandlerType::Input>(input.value());
             auto const ret = handler.process(inData, ctx);
 
             // real handler is given expected Input, not json
@@ -71,6 +77,96 @@ struct DefaultProcessor final
             static_assert(unsupported_handler_v<HandlerType>);
         }
     }
+
+    /**
+     * @brief Process value from a C++20 coroutine; handlers that take a @ref Context run on a stackful coroutine
+     *
+     * handler, value and ctx must outlive the returned awaitable.
+     */
+    [[nodiscard]] boost::asio::awaitable<ReturnType>
+    operator()(HandlerType const& handler, boost::json::value const& value, AsyncContext const& ctx) const
+    {
+        using boost::json::value_from;
+        using boost::json::value_to;
+        if constexpr (not CoroutineHandler<HandlerType>)
+        {
+            co_return co_await util::awaitStackful([&](boost::asio::yield_context& yield) {
+                auto const stackfulCtx =
+                    Context{std::ref(yield), ctx.session, ctx.isAdmin, ctx.clientIp, ctx.apiVersion};
+                return (*this)(handler, value, stackfulCtx);
+            });
+        }
+        else if constexpr (HandlerWithInput<HandlerType>)
+        {
+            auto const input = validate(handler, value, ctx.apiVersion);
+            if (not input)
+                co_return Error{input.error()};  // forward Status
+
+            auto const inData = value_to<typename HandlerType::Input>(input.value());
+            auto const ret = co_await handler.process(inData, ctx);
+
+            if (!ret)
+                co_return Error{ret.error()};  // forward Status
+            else
+                co_return value_from(ret.value());
+        }
+        else
+        {
+            if (auto const ret = co_await handler.process(ctx); not ret)
+                co_return Error{ret.error()};  // forward Status
+            else
+                co_return value_from(ret.value());
+        }
+    }
+
+    /**
+     * @brief Process value into a serialized result
+     *
+     * The output of a StreamingHandler is written piece by piece by its writeJson, without converting it into a
+     * boost::json value; the output of any other handler is serialized from its value.
+     */
+    [[nodiscard]] SerializedReturnType
+    serialized(HandlerType const& handler, boost::json::value const& value, Context const& ctx) const
+    {
+        if constexpr (StreamingHandler<HandlerType>)
+        {
+            auto const input = validate(handler, value, ctx.apiVersion);
+            if (not input)
+                return Error{input.error()};  // forward Status
+
+            auto const inData = boost::json::value_to<typename HandlerType::Input>(input.value());
+            auto const ret = handler.process(inData, ctx);
+            if (!ret)
+                return Error{ret.error()};  // forward Status
+
+            util::JsonWriter writer;
+            writeJson(writer, ret.value());
+            return std::move(writer).finish();
+        }
+        else
+        {
+            auto const ret = (*this)(handler, value, ctx);
+            if (!ret)
+                return Error{ret.error()};  // forward Status
+
+            return boost::json::serialize(ret.value());
+        }
+    }
+
+private:
+    // runs the spec of the handler against a copy of value; the copy lives in the same memory resource as the request
+    [[nodiscard]] static ReturnType
+    validate(HandlerType const& handler, boost::json::value const& value, uint32_t apiVersion)
+    {
+        // spec require mutable data
+        auto const spec = handler.spec(apiVersion);
+        auto input = boost::json::value{value, value.storage()};
+
+        if (auto const ret = spec.process(input); not ret)
+            return Error{ret.error()};  // forward Status
+
+        return input;
+    }
 };
 
 }  // namespace RPC::detail
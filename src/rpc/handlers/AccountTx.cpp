@@ -128,7 +128,7 @@ AccountTxHandler::process(AccountTxHandler::Input input, Context const& ctx) con
 
         obj[JS(validated)] = true;
 
-        response.transactions.push_back(obj);
+        response.transactions.push_back(std::move(obj));
     }
 
     response.limit = input.limit;
@@ -157,6 +157,34 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountTxHandler
         jv.as_object()[JS(limit)] = *(output.limit);
 }
 
+void
+writeJson(util::JsonWriter& writer, AccountTxHandler::Output const& output)
+{
+    writer.startObject()
+        .field(JS(account), output.account)
+        .field(JS(ledger_index_min), output.ledgerIndexMin)
+        .field(JS(ledger_index_max), output.ledgerIndexMax)
+        .key(JS(transactions))
+        .startArray();
+
+    for (auto const& transaction : output.transactions)
+        writer.value(transaction);
+
+    writer.endArray().field(JS(validated), output.validated);
+
+    if (output.marker)
+        writer.key(JS(marker))
+            .startObject()
+            .field(JS(ledger), output.marker->ledger)
+            .field(JS(seq), output.marker->seq)
+            .endObject();
+
+    if (output.limit)
+        writer.field(JS(limit), *output.limit);
+
+    writer.endObject();
+}
+
 void
 tag_invoke(boost::json::value_from_tag, boost::json::value& jv, AccountTxHandler::Marker const& marker)
 {
@@ -26,6 +26,7 @@
 #include <rpc/common/Modifiers.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
+#include <util/JsonWriter.h>
 
 namespace RPC {
 
@@ -120,6 +121,10 @@ private:
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
 
+    // writes the transactions one by one straight into the response, as there may be up to a thousand of them
+    friend void
+    writeJson(util::JsonWriter& writer, Output const& output);
+
     friend Input
     tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv);
 
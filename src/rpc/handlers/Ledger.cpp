@@ -173,6 +173,17 @@ tag_invoke(boost::json::value_from_tag, boost::json::value& jv, LedgerHandler::O
     };
 }
 
+void
+writeJson(util::JsonWriter& writer, LedgerHandler::Output const& output)
+{
+    writer.startObject()
+        .field(JS(ledger_hash), output.ledgerHash)
+        .field(JS(ledger_index), output.ledgerIndex)
+        .field(JS(validated), output.validated)
+        .field(JS(ledger), output.header)
+        .endObject();
+}
+
 LedgerHandler::Input
 tag_invoke(boost::json::value_to_tag<LedgerHandler::Input>, boost::json::value const& jv)
 {
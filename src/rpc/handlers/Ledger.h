@@ -23,6 +23,7 @@
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
+#include <util/JsonWriter.h>
 
 namespace RPC {
 
@@ -91,6 +92,10 @@ private:
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output);
 
+    // writes the header with its transactions and diff straight into the response instead of copying it
+    friend void
+    writeJson(util::JsonWriter& writer, Output const& output);
+
     friend Input
     tag_invoke(boost::json::value_to_tag<Input>, boost::json::value const& jv);
 };
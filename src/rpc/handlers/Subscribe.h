@@ -20,9 +20,14 @@
 #pragma once
 
 #include <backend/BackendInterface.h>
+#include <rpc/BookSnapshotCache.h>
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/Types.h>
 #include <rpc/common/Validators.h>
+#include <subscriptions/ReplayBuffer.h>
+#include <subscriptions/TransactionFilter.h>
+
+#include <charconv>
 
 namespace RPC {
 template <typename SubscriptionManagerType>
@@ -30,6 +35,8 @@ class BaseSubscribeHandler
 {
     std::shared_ptr<BackendInterface> sharedPtrBackend_;
     std::shared_ptr<SubscriptionManagerType> subscriptions_;
+    // shared by the copies of the handler, so that all requests use the same snapshots
+    std::shared_ptr<BookSnapshotCache> snapshotCache_ = std::make_shared<BookSnapshotCache>();
 
 public:
     struct Output
@@ -60,6 +67,10 @@ public:
         std::optional<std::vector<std::string>> streams;
         std::optional<std::vector<std::string>> accountsProposed;
         std::optional<std::vector<OrderBook>> books;
+        // only for the transactions stream
+        std::optional<TransactionFilter> transactionsFilter;
+        // replay the ledger and transactions streams and the accounts from this ledger before going live
+        std::optional<std::uint32_t> fromLedger;
     };
 
     using Result = HandlerReturnType<Output>;
@@ -102,11 +113,52 @@ public:
                 return MaybeError{};
             }};
 
+        static auto const transactionsFilterValidator =
+            validation::CustomValidator{[](boost::json::value const& value, std::string_view key) -> MaybeError {
+                if (!value.is_object())
+                    return Error{Status{RippledError::rpcINVALID_PARAMS, std::string(key) + "NotObject"}};
+
+                auto const& filter = value.as_object();
+                auto const checkNames = [&](char const* field, auto isValid) -> MaybeError {
+                    if (!filter.contains(field))
+                        return MaybeError{};
+
+                    if (!filter.at(field).is_array())
+                        return Error{Status{RippledError::rpcINVALID_PARAMS, std::string(field) + "NotArray"}};
+
+                    for (auto const& name : filter.at(field).as_array())
+                    {
+                        if (!name.is_string() || !isValid(name.as_string().c_str()))
+                            return Error{Status{RippledError::rpcINVALID_PARAMS, std::string(field) + "Malformed"}};
+                    }
+
+                    return MaybeError{};
+                };
+
+                if (auto const err = checkNames("transaction_types", [](std::string const& name) {
+                        return ripple::TxFormats::getInstance().findByName(name) != nullptr;
+                    });
+                    !err)
+                    return err;
+
+                if (auto const err = checkNames(
+                        "engine_results", [](std::string const& name) { return ripple::transCode(name).has_value(); });
+                    !err)
+                    return err;
+
+                if (filter.contains("min_xrp_amount") && !parseDrops(filter.at("min_xrp_amount")))
+                    return Error{Status{RippledError::rpcINVALID_PARAMS, "min_xrp_amountMalformed"}};
+
+                return MaybeError{};
+            }};
+
         static auto const rpcSpec = RpcSpec{
             {JS(streams), validation::SubscribeStreamValidator},
             {JS(accounts), validation::SubscribeAccountsValidator},
             {JS(accounts_proposed), validation::SubscribeAccountsValidator},
             {JS(books), booksValidator},
+            {"transactions_filter", transactionsFilterValidator},
+            {"from_ledger", validation::Type<uint32_t>{}},
         };
 
         return rpcSpec;
@@ -116,15 +168,33 @@ public:
     process(Input input, Context const& ctx) const
     {
         auto output = Output{};
+        auto const replayed = input.fromLedger.has_value();
+
+        if (replayed)
+        {
+            auto const ledger =
+                subscriptions_->subReplay(ctx.yield, ctx.session, *(input.fromLedger), makeReplayRequest(input));
+            if (!ledger)
+                return Error{Status{RippledError::rpcLGR_NOT_FOUND, "fromLedgerNotReplayable"}};
+
+            if (!ledger->empty())
+                output.ledger = *ledger;
+        }
 
         if (input.streams)
         {
-            auto const ledger = subscribeToStreams(ctx.yield, *(input.streams), ctx.session);
+            auto const ledger = subscribeToStreams(
+                ctx.yield,
+                *(input.streams),
+                input.transactionsFilter.value_or(TransactionFilter{}),
+                replayed,
+                ctx.session);
             if (!ledger.empty())
                 output.ledger = ledger;
         }
 
-        if (input.accounts)
+        // subReplay already subscribed to the accounts
+        if (input.accounts && !replayed)
             subscribeToAccounts(*(input.accounts), ctx.session);
 
         if (input.accountsProposed)
@@ -139,20 +209,49 @@ public:
     }
 
 private:
+    static ReplayRequest
+    makeReplayRequest(Input const& input)
+    {
+        auto request = ReplayRequest{};
+        if (input.streams)
+        {
+            auto const& streams = *(input.streams);
+            request.ledger = std::find(streams.begin(), streams.end(), "ledger") != streams.end();
+            if (std::find(streams.begin(), streams.end(), "transactions") != streams.end())
+                request.transactions = input.transactionsFilter.value_or(TransactionFilter{});
+        }
+
+        if (input.accounts)
+        {
+            for (auto const& account : *(input.accounts))
+                request.accounts.push_back(*accountFromStringStrict(account));
+        }
+
+        return request;
+    }
+
+    /**
+     * @param replayed Whether subReplay already subscribed to the ledger and transactions streams
+     */
     boost::json::object
     subscribeToStreams(
         boost::asio::yield_context& yield,
         std::vector<std::string> const& streams,
+        TransactionFilter const& transactionsFilter,
+        bool replayed,
         std::shared_ptr<Server::ConnectionBase> const& session) const
     {
         auto response = boost::json::object{};
 
         for (auto const& stream : streams)
         {
+            if ((stream == "ledger" || stream == "transactions") && replayed)
+                continue;
+
             if (stream == "ledger")
                 response = subscriptions_->subLedger(yield, session);
             else if (stream == "transactions")
-                subscriptions_->subTransactions(session);
+                subscriptions_->subTransactions(session, transactionsFilter);
             else if (stream == "transactions_proposed")
                 subscriptions_->subProposedTransactions(session);
             else if (stream == "validations")
@@ -209,18 +308,20 @@ private:
                     rng = sharedPtrBackend_->fetchLedgerRange();
 
                 auto const getOrderBook = [&](auto const& book, auto& snapshots) {
-                    auto const bookBase = getBookBase(book);
-                    auto const [offers, _] =
-                        sharedPtrBackend_->fetchBookOffers(bookBase, rng->maxSequence, fetchLimit, yield);
-
                     // the taker is not really uesed, same issue with
                     // https://github.com/XRPLF/xrpl-dev-portal/issues/1818
                     auto const takerID =
                         internalBook.taker ? accountFromStringStrict(*(internalBook.taker)) : beast::zero;
 
-                    auto const orderBook =
-                        postProcessOrderBook(offers, book, *takerID, *sharedPtrBackend_, rng->maxSequence, yield);
-                    std::copy(orderBook.begin(), orderBook.end(), std::back_inserter(snapshots));
+                    // sessions subscribing to the same book at the same ledger share one snapshot
+                    auto const orderBook = snapshotCache_->get(book, *takerID, rng->maxSequence, yield, [&]() {
+                        auto const bookBase = getBookBase(book);
+                        auto const [offers, _] =
+                            sharedPtrBackend_->fetchBookOffers(bookBase, rng->maxSequence, fetchLimit, yield);
+                        return postProcessOrderBook(
+                            offers, book, *takerID, *sharedPtrBackend_, rng->maxSequence, yield);
+                    });
+                    std::copy(orderBook->begin(), orderBook->end(), std::back_inserter(snapshots));
                 };
 
                 if (internalBook.both)
@@ -247,6 +348,24 @@ private:
         }
     }
 
+    /**
+     * @brief Parse an amount of drops, given as a string like other XRP amounts
+     */
+    static std::optional<std::int64_t>
+    parseDrops(boost::json::value const& value)
+    {
+        if (!value.is_string())
+            return std::nullopt;
+
+        auto const& str = value.as_string();
+        std::int64_t drops = 0;
+        auto const [end, ec] = std::from_chars(str.data(), str.data() + str.size(), drops);
+        if (ec != std::errc{} || end != str.data() + str.size() || drops < 0)
+            return std::nullopt;
+
+        return drops;
+    }
+
     friend void
     tag_invoke(boost::json::value_from_tag, boost::json::value& jv, Output const& output)
     {
@@ -310,6 +429,32 @@ private:
             }
         }
 
+        if (auto const& filter = jsonObject.find("transactions_filter"); filter != jsonObject.end())
+        {
+            auto const& filterObject = filter->value().as_object();
+            input.transactionsFilter = TransactionFilter{};
+
+            if (auto const& types = filterObject.find("transaction_types"); types != filterObject.end())
+            {
+                for (auto const& type : types->value().as_array())
+                    input.transactionsFilter->types.insert(
+                        ripple::TxFormats::getInstance().findTypeByName(type.as_string().c_str()));
+            }
+
+            if (auto const& results = filterObject.find("engine_results"); results != filterObject.end())
+            {
+                for (auto const& result : results->value().as_array())
+                    input.transactionsFilter->results.insert(
+                        ripple::TERtoInt(*ripple::transCode(result.as_string().c_str())));
+            }
+
+            if (auto const& minXrp = filterObject.find("min_xrp_amount"); minXrp != filterObject.end())
+                input.transactionsFilter->minXrpDrops = parseDrops(minXrp->value());
+        }
+
+        if (auto const& fromLedger = jsonObject.find("from_ledger"); fromLedger != jsonObject.end())
+            input.fromLedger = fromLedger->value().as_int64();
+
         return input;
     }
 };
@@ -21,18 +21,19 @@
 
 namespace RPC {
 
-TransactionEntryHandler::Result
-TransactionEntryHandler::process(TransactionEntryHandler::Input input, Context const& ctx) const
+boost::asio::awaitable<TransactionEntryHandler::Result>
+TransactionEntryHandler::process(TransactionEntryHandler::Input input, [[maybe_unused]] AsyncContext const& ctx) const
 {
     auto const range = sharedPtrBackend_->fetchLedgerRange();
-    auto const lgrInfoOrStatus = getLedgerInfoFromHashOrSeq(
-        *sharedPtrBackend_, ctx.yield, input.ledgerHash, input.ledgerIndex, range->maxSequence);
+    auto const lgrInfoOrStatus = co_await getLedgerInfoFromHashOrSeq(
+        *sharedPtrBackend_, boost::asio::use_awaitable, input.ledgerHash, input.ledgerIndex, range->maxSequence);
 
     if (auto status = std::get_if<Status>(&lgrInfoOrStatus))
-        return Error{*status};
+        co_return Error{*status};
 
     auto const lgrInfo = std::get<ripple::LedgerInfo>(lgrInfoOrStatus);
-    auto const dbRet = sharedPtrBackend_->fetchTransaction(ripple::uint256{input.txHash.c_str()}, ctx.yield);
+    auto const txHash = ripple::uint256{input.txHash.c_str()};
+    auto const dbRet = co_await sharedPtrBackend_->fetchTransaction(txHash, boost::asio::use_awaitable);
     // Note: transaction_entry is meant to only search a specified ledger for
     // the specified transaction. tx searches the entire range of history. For
     // rippled, having two separate commands made sense, as tx would use SQLite
@@ -43,7 +44,7 @@ TransactionEntryHandler::process(TransactionEntryHandler::Input input, Context c
     // ledger; we simulate that here by returning not found if the transaction
     // is in a different ledger than the one specified.
     if (!dbRet || dbRet->ledgerSequence != lgrInfo.seq)
-        return Error{Status{RippledError::rpcTXN_NOT_FOUND, "transactionNotFound", "Transaction not found."}};
+        co_return Error{Status{RippledError::rpcTXN_NOT_FOUND, "transactionNotFound", "Transaction not found."}};
 
     auto output = TransactionEntryHandler::Output{};
     auto [txn, meta] = toExpandedJson(*dbRet);
@@ -53,7 +54,7 @@ TransactionEntryHandler::process(TransactionEntryHandler::Input input, Context c
     output.ledgerIndex = lgrInfo.seq;
     output.ledgerHash = ripple::strHex(lgrInfo.hash);
 
-    return output;
+    co_return output;
 }
 
 void
@@ -76,8 +76,8 @@ public:
         return rpcSpec;
     }
 
-    Result
-    process(Input input, Context const& ctx) const;
+    boost::asio::awaitable<Result>
+    process(Input input, AsyncContext const& ctx) const;
 
 private:
     friend void
@@ -0,0 +1,135 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <subscriptions/TransactionFilter.h>
+
+#include <ripple/protocol/AccountID.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+/**
+ * @brief The streams a session wants replayed when it subscribes with from_ledger
+ */
+struct ReplayRequest
+{
+    bool ledger = false;
+    std::optional<TransactionFilter> transactions;  // the transactions stream, with its filter
+    std::vector<ripple::AccountID> accounts;
+};
+
+/**
+ * @brief The messages published for the most recent ledgers, so that a client reconnecting shortly after losing its
+ * connection can resume its subscriptions without querying the database for what it missed
+ *
+ * Ledgers are evicted oldest first once more than the configured number are kept. Not thread safe.
+ *
+ * @tparam Transaction A rendered transaction message
+ */
+template <class Transaction>
+class ReplayBuffer
+{
+public:
+    struct Ledger
+    {
+        std::uint32_t seq = 0;
+        std::shared_ptr<std::string> message;  // of the ledger stream; missing if only transactions were published
+        std::vector<Transaction> transactions = {};
+    };
+
+private:
+    std::size_t maxLedgers_;
+    std::deque<Ledger> ledgers_;
+
+public:
+    /**
+     * @param maxLedgers Number of ledgers to keep; nothing is kept if 0
+     */
+    explicit ReplayBuffer(std::size_t maxLedgers) : maxLedgers_(maxLedgers)
+    {
+    }
+
+    void
+    addLedger(std::uint32_t seq, std::shared_ptr<std::string> message)
+    {
+        if (auto ledger = ledgerFor(seq); ledger != nullptr)
+            ledger->message = std::move(message);
+    }
+
+    void
+    addTransaction(std::uint32_t seq, Transaction transaction)
+    {
+        if (auto ledger = ledgerFor(seq); ledger != nullptr)
+            ledger->transactions.push_back(std::move(transaction));
+    }
+
+    /**
+     * @return true if everything published since the given ledger, included, is still kept
+     */
+    bool
+    covers(std::uint32_t seq) const
+    {
+        return !ledgers_.empty() && seq >= ledgers_.front().seq;
+    }
+
+    /**
+     * @brief Call a function with each kept ledger starting from the given one, oldest first
+     */
+    template <class Func>
+    void
+    forEachSince(std::uint32_t seq, Func&& func) const
+    {
+        auto const first = std::find_if(
+            ledgers_.begin(), ledgers_.end(), [seq](Ledger const& ledger) { return ledger.seq >= seq; });
+        std::for_each(first, ledgers_.end(), func);
+    }
+
+    std::size_t
+    size() const
+    {
+        return ledgers_.size();
+    }
+
+private:
+    Ledger*
+    ledgerFor(std::uint32_t seq)
+    {
+        if (maxLedgers_ == 0)
+            return nullptr;
+
+        if (ledgers_.empty() || ledgers_.back().seq < seq)
+        {
+            ledgers_.push_back(Ledger{seq});
+            if (ledgers_.size() > maxLedgers_)
+                ledgers_.pop_front();
+
+            return &ledgers_.back();
+        }
+
+        // publishing a ledger again; nothing is kept for a ledger older than the newest one
+        return ledgers_.back().seq == seq ? &ledgers_.back() : nullptr;
+    }
+};
@@ -21,6 +21,9 @@
 #include <rpc/RPCHelpers.h>
 #include <subscriptions/SubscriptionManager.h>
 
+#include <exception>
+#include <future>
+
 void
 Subscription::subscribe(SessionPtrType const& session)
 {
@@ -39,6 +42,68 @@ Subscription::publish(std::shared_ptr<std::string> const& message)
     boost::asio::post(strand_, [this, message]() { sendToSubscribers(message, subscribers_, subCount_); });
 }
 
+void
+TransactionSubscription::subscribe(SessionPtrType const& session, TransactionFilter const& filter)
+{
+    std::scoped_lock lck{mtx_};
+    unsubscribeLocked(session);
+    subscribers_[filter].insert(session);
+    ++subCount_;
+}
+
+void
+TransactionSubscription::unsubscribe(SessionPtrType const& session)
+{
+    std::scoped_lock lck{mtx_};
+    unsubscribeLocked(session);
+}
+
+void
+TransactionSubscription::unsubscribeLocked(SessionPtrType const& session)
+{
+    for (auto it = subscribers_.begin(); it != subscribers_.end();)
+    {
+        if (it->second.erase(session) > 0)
+            --subCount_;
+
+        if (it->second.empty())
+            it = subscribers_.erase(it);
+        else
+            ++it;
+    }
+}
+
+void
+TransactionSubscription::publish(
+    std::shared_ptr<std::string> const& message,
+    ripple::TxType type,
+    ripple::TERUnderlyingType result,
+    std::optional<std::int64_t> xrpDrops)
+{
+    std::vector<SessionPtrType> sessions;
+    {
+        std::shared_lock lck{mtx_};
+        for (auto const& [filter, subscribers] : subscribers_)
+        {
+            if (filter.matches(type, result, xrpDrops))
+                sessions.insert(sessions.end(), subscribers.begin(), subscribers.end());
+        }
+    }
+
+    if (sessions.empty())
+        return;
+
+    boost::asio::post(strand_, [this, message, sessions = std::move(sessions)]() {
+        for (auto const& session : sessions)
+        {
+            if (session->dead())
+                unsubscribe(session);
+            else
+                session->send(message);
+        }
+    });
+}
+
 boost::json::object
 getLedgerPubMessage(
     ripple::LedgerInfo const& lgrInfo,
@@ -67,7 +132,12 @@ boost::json::object
 SubscriptionManager::subLedger(boost::asio::yield_context& yield, SessionPtrType session)
 {
     subscribeHelper(session, ledgerSubscribers_, [this](SessionPtrType session) { unsubLedger(session); });
+    return ledgerStreamInfo(yield);
+}
 
+boost::json::object
+SubscriptionManager::ledgerStreamInfo(boost::asio::yield_context& yield) const
+{
     auto ledgerRange = backend_->fetchLedgerRange();
     assert(ledgerRange);
     auto lgrInfo = backend_->fetchLedgerBySequence(ledgerRange->maxSequence, yield);
@@ -91,10 +161,68 @@ SubscriptionManager::unsubLedger(SessionPtrType session)
     ledgerSubscribers_.unsubscribe(session);
 }
 
+std::optional<boost::json::object>
+SubscriptionManager::subReplay(
+    boost::asio::yield_context& yield,
+    SessionPtrType session,
+    std::uint32_t fromLedger,
+    ReplayRequest const& request)
+{
+    {
+        std::scoped_lock lck{replayMtx_};
+        if (!replayBuffer_.covers(fromLedger))
+            return {};
+
+        auto const affectsAccounts = [&request](TransactionMessage const& txMessage) {
+            return std::any_of(txMessage.accounts.begin(), txMessage.accounts.end(), [&request](auto const& account) {
+                return std::find(request.accounts.begin(), request.accounts.end(), account) != request.accounts.end();
+            });
+        };
+
+        // the same messages a live subscriber would have received, in the same order
+        std::vector<std::shared_ptr<std::string>> messages;
+        replayBuffer_.forEachSince(fromLedger, [&](auto const& ledger) {
+            if (request.ledger && ledger.message)
+                messages.push_back(ledger.message);
+
+            for (auto const& txMessage : ledger.transactions)
+            {
+                if (request.transactions &&
+                    request.transactions->matches(txMessage.type, txMessage.result, txMessage.xrpDrops))
+                    messages.push_back(txMessage.message);
+
+                if (affectsAccounts(txMessage))
+                    messages.push_back(txMessage.message);
+            }
+        });
+
+        // the strand of the ledger stream runs the subscription before any message published once the lock is
+        // released; transactions and accounts are looked up by publishTransaction, so they are subscribed before it
+        if (request.ledger)
+            subscribeHelper(session, ledgerSubscribers_, [this](SessionPtrType session) { unsubLedger(session); });
+
+        if (request.transactions)
+            subTransactions(session, *request.transactions);
+
+        for (auto const& account : request.accounts)
+            subAccount(account, session);
+
+        // queued by the session ahead of the live messages, which are sent once the lock is released
+        session->sendMessages(std::move(messages));
+    }
+
+    if (!request.ledger)
+        return boost::json::object{};
+
+    return ledgerStreamInfo(yield);
+}
+
 void
-SubscriptionManager::subTransactions(SessionPtrType session)
+SubscriptionManager::subTransactions(SessionPtrType session, TransactionFilter const& filter)
 {
-    subscribeHelper(session, txSubscribers_, [this](SessionPtrType session) { unsubTransactions(session); });
+    txSubscribers_.subscribe(session, filter);
+    std::scoped_lock lk(cleanupMtx_);
+    cleanupFuncs_[session].push_back([this](SessionPtrType session) { unsubTransactions(session); });
 }
 
 void
@@ -152,11 +280,99 @@ SubscriptionManager::pubLedger(
     auto message = std::make_shared<std::string>(
         boost::json::serialize(getLedgerPubMessage(lgrInfo, fees, ledgerRange, txnCount)));
 
+    std::scoped_lock lck{replayMtx_};
+    replayBuffer_.addLedger(lgrInfo.seq, message);
     ledgerSubscribers_.publish(message);
 }
 
 void
 SubscriptionManager::pubTransaction(Backend::TransactionAndMetadata const& blobs, ripple::LedgerInfo const& lgrInfo)
+{
+    publishTransaction(renderTransaction(blobs, lgrInfo));
+}
+
+void
+SubscriptionManager::pubTransactions(
+    std::vector<Backend::TransactionAndMetadata> const& transactions,
+    ripple::LedgerInfo const& lgrInfo)
+{
+    auto const ownerFunds = fetchOwnerFunds(transactions, lgrInfo.seq);
+
+    std::vector<std::future<TransactionMessage>> rendered;
+    rendered.reserve(transactions.size());
+
+    for (auto const& blobs : transactions)
+    {
+        auto task = std::make_shared<std::packaged_task<TransactionMessage()>>(
+            [this, &blobs, &lgrInfo, &ownerFunds]() { return renderTransaction(blobs, lgrInfo, ownerFunds); });
+        rendered.push_back(task->get_future());
+        boost::asio::post(ioc_, [task]() { (*task)(); });
+    }
+
+    // the tasks reference transactions, lgrInfo and ownerFunds, so all of them must finish before returning
+    std::exception_ptr error;
+    for (auto& future : rendered)
+    {
+        try
+        {
+            auto const txMessage = future.get();
+            if (!error)
+                publishTransaction(txMessage);
+        }
+        catch (...)
+        {
+            if (!error)
+                error = std::current_exception();
+        }
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+}
+
+SubscriptionManager::OwnerFunds
+SubscriptionManager::fetchOwnerFunds(
+    std::vector<Backend::TransactionAndMetadata> const& transactions,
+    std::uint32_t seq) const
+{
+    OwnerFunds ownerFunds;
+    for (auto const& blobs : transactions)
+    {
+        ripple::SerialIter it{blobs.transaction.data(), blobs.transaction.size()};
+        ripple::STObject const tx{it, ripple::sfTransaction};
+        if (tx.getFieldU16(ripple::sfTransactionType) != ripple::ttOFFER_CREATE)
+            continue;
+
+        auto const account = tx.getAccountID(ripple::sfAccount);
+        auto const issue = tx.getFieldAmount(ripple::sfTakerGets).issue();
+        if (account != issue.account)
+            ownerFunds.try_emplace({account, issue});
+    }
+
+    if (ownerFunds.empty())
+        return ownerFunds;
+
+    // the funds of all owners are read concurrently; the entries already exist so each coroutine only writes its own
+    Backend::retryOnTimeout([&]() {
+        Backend::synchronous([&](boost::asio::yield_context& yield) {
+            for (auto& entry : ownerFunds)
+            {
+                boost::asio::spawn(yield.get_executor(), [this, &entry, seq](boost::asio::yield_context yield) {
+                    auto const& [account, issue] = entry.first;
+                    entry.second = RPC::accountFunds(*backend_, seq, ripple::STAmount{issue}, account, yield);
+                });
+            }
+        });
+    });
+
+    return ownerFunds;
+}
+
+SubscriptionManager::TransactionMessage
+SubscriptionManager::renderTransaction(
+    Backend::TransactionAndMetadata const& blobs,
+    ripple::LedgerInfo const& lgrInfo,
+    OwnerFunds const& ownerFunds) const
 {
     auto [tx, meta] = RPC::deserializeTxPlusMeta(blobs, lgrInfo.seq);
     boost::json::object pubObj;
@@ -183,26 +399,39 @@ SubscriptionManager::pubTransaction(Backend::TransactionAndMetadata const& blobs
         auto amount = tx->getFieldAmount(ripple::sfTakerGets);
         if (account != amount.issue().account)
         {
-            ripple::STAmount ownerFunds;
-            auto fetchFundsSynchronous = [&]() {
-                Backend::synchronous([&](boost::asio::yield_context& yield) {
-                    ownerFunds = RPC::accountFunds(*backend_, lgrInfo.seq, amount, account, yield);
-                });
-            };
+            ripple::STAmount funds;
+            if (auto const it = ownerFunds.find({account, amount.issue()}); it != ownerFunds.end())
+            {
+                funds = it->second;
+            }
+            else
+            {
+                auto fetchFundsSynchronous = [&]() {
+                    Backend::synchronous([&](boost::asio::yield_context& yield) {
+                        funds = RPC::accountFunds(*backend_, lgrInfo.seq, amount, account, yield);
+                    });
+                };
 
-            Backend::retryOnTimeout(fetchFundsSynchronous);
+                Backend::retryOnTimeout(fetchFundsSynchronous);
+            }
 
-            pubObj["transaction"].as_object()["owner_funds"] = ownerFunds.getText();
+            pubObj["transaction"].as_object()["owner_funds"] = funds.getText();
         }
     }
 
-    auto pubMsg = std::make_shared<std::string>(boost::json::serialize(pubObj));
-    txSubscribers_.publish(pubMsg);
-
-    auto accounts = meta->getAffectedAccounts();
+    TransactionMessage txMessage;
+    txMessage.seq = lgrInfo.seq;
+    txMessage.message = std::make_shared<std::string>(boost::json::serialize(pubObj));
+    txMessage.type = tx->getTxnType();
+    txMessage.result = meta->getResult();
+    if (tx->isFieldPresent(ripple::sfAmount))
+    {
+        if (auto const amount = tx->getFieldAmount(ripple::sfAmount); amount.native())
+            txMessage.xrpDrops = amount.xrp().drops();
+    }
 
-    for (auto const& account : accounts)
-        accountSubscribers_.publish(pubMsg, account);
+    auto const accounts = meta->getAffectedAccounts();
+    txMessage.accounts.assign(accounts.begin(), accounts.end());
 
     std::unordered_set<ripple::Book> alreadySent;
 
@@ -233,13 +462,28 @@ SubscriptionManager::pubTransaction(Backend::TransactionAndMetadata const& blobs
                         data->getFieldAmount(ripple::sfTakerPays).issue()};
                     if (alreadySent.find(book) == alreadySent.end())
                     {
-                        bookSubscribers_.publish(pubMsg, book);
+                        txMessage.books.push_back(book);
                         alreadySent.insert(book);
                     }
                 }
             }
         }
     }
+
+    return txMessage;
+}
+
+void
+SubscriptionManager::publishTransaction(TransactionMessage const& txMessage)
+{
+    std::scoped_lock replayLck{replayMtx_};
+    replayBuffer_.addTransaction(txMessage.seq, txMessage);
+
+    txSubscribers_.publish(txMessage.message, txMessage.type, txMessage.result, txMessage.xrpDrops);
+
+    std::unordered_set<SessionPtrType> sent;
+    accountSubscribers_.publish(txMessage.message, txMessage.accounts, sent);
+    bookSubscribers_.publish(txMessage.message, txMessage.books, sent);
 }
 
 void
@@ -261,8 +505,8 @@ SubscriptionManager::forwardProposedTransaction(boost::json::object const& respo
     auto transaction = response.at("transaction").as_object();
     auto accounts = RPC::getAccountsFromTransaction(transaction);
 
-    for (ripple::AccountID const& account : accounts)
-        accountProposedSubscribers_.publish(pubMsg, account);
+    std::unordered_set<SessionPtrType> sent;
+    accountProposedSubscribers_.publish(pubMsg, accounts, sent);
 }
 
 void
@@ -22,9 +22,18 @@
 #include <backend/BackendInterface.h>
 #include <config/Config.h>
 #include <log/Logger.h>
+#include <subscriptions/ReplayBuffer.h>
+#include <subscriptions/TransactionFilter.h>
 #include <webserver/interface/ConnectionBase.h>
 
+#include <algorithm>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_set>
+#include <utility>
+#include <vector>
 
 using SessionPtrType = std::shared_ptr<Server::ConnectionBase>;
 
@@ -67,13 +76,88 @@ public:
     }
 };
 
+/**
+ * @brief Subscribers of the transactions stream, each with a filter
+ *
+ * Subscribing, unsubscribing and replacing a filter take the mutex the subscribers are looked up under when
+ * publishing, so that a session changing its filter gets each transaction once. Messages are sent on the strand.
+ */
+class TransactionSubscription
+{
+    boost::asio::io_context::strand strand_;
+    std::shared_mutex mtx_;
+    // grouped by filter, so that each distinct filter is evaluated once per transaction; the empty one matches all
+    std::map<TransactionFilter, std::unordered_set<SessionPtrType>> subscribers_ = {};
+    std::atomic_uint64_t subCount_ = 0;
+
+public:
+    TransactionSubscription() = delete;
+    TransactionSubscription(TransactionSubscription&) = delete;
+    TransactionSubscription(TransactionSubscription&&) = delete;
+
+    explicit TransactionSubscription(boost::asio::io_context& ioc) : strand_(ioc)
+    {
+    }
+
+    ~TransactionSubscription() = default;
+
+    /**
+     * @brief Subscribe, replacing the filter of an earlier subscription of the session
+     */
+    void
+    subscribe(SessionPtrType const& session, TransactionFilter const& filter);
+
+    void
+    unsubscribe(SessionPtrType const& session);
+
+    /**
+     * @brief Send a transaction to the sessions whose filter matches it; dead sessions are unsubscribed
+     *
+     * @param message The message
+     * @param type The type of the transaction
+     * @param result The engine result of the transaction
+     * @param xrpDrops The Amount field of the transaction, if it is in XRP
+     */
+    void
+    publish(
+        std::shared_ptr<std::string> const& message,
+        ripple::TxType type,
+        ripple::TERUnderlyingType result,
+        std::optional<std::int64_t> xrpDrops);
+
+    std::uint64_t
+    count() const
+    {
+        return subCount_.load();
+    }
+
+private:
+    void
+    unsubscribeLocked(SessionPtrType const& session);
+};
+
+/**
+ * @brief Subscribers by key, such as an account or a book
+ *
+ * The keys are hashed across shards that each have their own mutex and strand. Subscribing and unsubscribing take the
+ * mutex of the shard of the key, so that the next message published sees the change. Messages are sent on the strands,
+ * so that the sends run on several subscription workers at once.
+ */
 template <class Key>
 class SubscriptionMap
 {
-    using subscribers = std::set<SessionPtrType>;
+    struct Shard
+    {
+        boost::asio::io_context::strand strand;
+        std::unordered_map<Key, std::set<SessionPtrType>> subscribers = {};
+        std::shared_mutex mtx;
 
-    boost::asio::io_context::strand strand_;
-    std::unordered_map<Key, subscribers> subscribers_ = {};
+        explicit Shard(boost::asio::io_context& ioc) : strand(ioc)
+        {
+        }
+    };
+
+    std::vector<std::unique_ptr<Shard>> shards_;
     std::atomic_uint64_t subCount_ = 0;
 
 public:
@@ -81,8 +165,15 @@ public:
     SubscriptionMap(SubscriptionMap&) = delete;
     SubscriptionMap(SubscriptionMap&&) = delete;
 
-    explicit SubscriptionMap(boost::asio::io_context& ioc) : strand_(ioc)
+    /**
+     * @param ioc The context the strands of the shards run on
+     * @param numShards Number of shards; at least one is used
+     */
+    explicit SubscriptionMap(boost::asio::io_context& ioc, std::size_t numShards = 1)
     {
+        shards_.reserve(std::max<std::size_t>(numShards, 1));
+        for (auto i = std::max<std::size_t>(numShards, 1); i > 0; --i)
+            shards_.push_back(std::make_unique<Shard>(ioc));
     }
 
     ~SubscriptionMap() = default;
@@ -96,11 +187,34 @@ public:
     void
     publish(std::shared_ptr<std::string> const& message, Key const& key);
 
+    /**
+     * @brief Send a message that concerns several keys once to each session subscribed to any of them
+     *
+     * The subscribers are looked up right away. The message is sent to a session on the strand picked by the session,
+     * so that a session gets the messages of this map in the order they are published. Dead sessions are unsubscribed.
+     *
+     * @param message The message
+     * @param keys The keys the message concerns
+     * @param sent Sessions that already got the message, e.g. from another map; the sessions it is sent to are added
+     */
+    void
+    publish(
+        std::shared_ptr<std::string> const& message,
+        std::vector<Key> const& keys,
+        std::unordered_set<SessionPtrType>& sent);
+
     std::uint64_t
     count() const
     {
         return subCount_.load();
     }
+
+private:
+    Shard&
+    shardFor(Key const& key)
+    {
+        return *shards_[std::hash<Key>{}(key) % shards_.size()];
+    }
 };
 
 template <class T>
@@ -149,41 +263,78 @@ template <class Key>
 void
 SubscriptionMap<Key>::subscribe(SessionPtrType const& session, Key const& account)
 {
-    boost::asio::post(strand_, [this, session, account]() { addSession(session, subscribers_[account], subCount_); });
+    auto& shard = shardFor(account);
+    std::scoped_lock lck{shard.mtx};
+    addSession(session, shard.subscribers[account], subCount_);
 }
 
 template <class Key>
 void
 SubscriptionMap<Key>::unsubscribe(SessionPtrType const& session, Key const& account)
 {
-    boost::asio::post(strand_, [this, account, session]() {
-        if (!subscribers_.contains(account))
-            return;
-
-        if (!subscribers_[account].contains(session))
-            return;
-
-        --subCount_;
-
-        subscribers_[account].erase(session);
-
-        if (subscribers_[account].size() == 0)
-        {
-            subscribers_.erase(account);
-        }
-    });
+    auto& shard = shardFor(account);
+    std::scoped_lock lck{shard.mtx};
+    auto const it = shard.subscribers.find(account);
+    if (it == shard.subscribers.end() || it->second.erase(session) == 0)
+        return;
+
+    --subCount_;
+    if (it->second.empty())
+        shard.subscribers.erase(it);
 }
 
 template <class Key>
 void
 SubscriptionMap<Key>::publish(std::shared_ptr<std::string> const& message, Key const& account)
 {
-    boost::asio::post(strand_, [this, account, message]() {
-        if (!subscribers_.contains(account))
-            return;
+    std::unordered_set<SessionPtrType> sent;
+    publish(message, std::vector<Key>{account}, sent);
+}
+
+template <class Key>
+void
+SubscriptionMap<Key>::publish(
+    std::shared_ptr<std::string> const& message,
+    std::vector<Key> const& keys,
+    std::unordered_set<SessionPtrType>& sent)
+{
+    if (keys.empty())
+        return;
+
+    std::vector<std::vector<SessionPtrType>> sessionsByShard(shards_.size());
+    for (auto const& key : keys)
+    {
+        auto& shard = shardFor(key);
+        std::shared_lock lck{shard.mtx};
+        if (auto const it = shard.subscribers.find(key); it != shard.subscribers.end())
+        {
+            for (auto const& session : it->second)
+            {
+                if (sent.insert(session).second)
+                    sessionsByShard[std::hash<SessionPtrType>{}(session) % shards_.size()].push_back(session);
+            }
+        }
+    }
 
-        sendToSubscribers(message, subscribers_[account], subCount_);
-    });
+    for (std::size_t i = 0; i < shards_.size(); ++i)
+    {
+        if (sessionsByShard[i].empty())
+            continue;
+
+        boost::asio::post(shards_[i]->strand, [this, message, keys, sessions = std::move(sessionsByShard[i])]() {
+            for (auto const& session : sessions)
+            {
+                if (!session->dead())
+                {
+                    session->send(message);
+                    continue;
+                }
+
+                for (auto const& key : keys)
+                    unsubscribe(session, key);
+            }
+        });
+    }
 }
 
 class SubscriptionManager
@@ -195,7 +346,7 @@ class SubscriptionManager
     std::optional<boost::asio::io_context::work> work_;
 
     Subscription ledgerSubscribers_;
-    Subscription txSubscribers_;
+    TransactionSubscription txSubscribers_;
     Subscription txProposedSubscribers_;
     Subscription manifestSubscribers_;
     Subscription validationsSubscribers_;
@@ -212,27 +363,41 @@ public:
     make_SubscriptionManager(clio::Config const& config, std::shared_ptr<Backend::BackendInterface const> const& b)
     {
         auto numThreads = config.valueOr<uint64_t>("subscription_workers", 1);
-        return std::make_shared<SubscriptionManager>(numThreads, b);
+        auto numShards = config.valueOr<uint64_t>("subscription_shards", numThreads);
+        auto replayLedgers = config.valueOr<uint64_t>("subscription_replay_ledgers", 32);
+        return std::make_shared<SubscriptionManager>(numThreads, b, numShards, replayLedgers);
     }
 
-    SubscriptionManager(std::uint64_t numThreads, std::shared_ptr<Backend::BackendInterface const> const& b)
+    /**
+     * @param numThreads Number of subscription workers
+     * @param b The backend
+     * @param numShards Number of shards of the account and book subscriptions; see SubscriptionMap
+     * @param replayLedgers Number of recent ledgers whose messages are kept for subReplay
+     */
+    SubscriptionManager(
+        std::uint64_t numThreads,
+        std::shared_ptr<Backend::BackendInterface const> const& b,
+        std::uint64_t numShards = 1,
+        std::uint64_t replayLedgers = 0)
         : ledgerSubscribers_(ioc_)
         , txSubscribers_(ioc_)
         , txProposedSubscribers_(ioc_)
         , manifestSubscribers_(ioc_)
         , validationsSubscribers_(ioc_)
         , bookChangesSubscribers_(ioc_)
-        , accountSubscribers_(ioc_)
-        , accountProposedSubscribers_(ioc_)
-        , bookSubscribers_(ioc_)
+        , accountSubscribers_(ioc_, numShards)
+        , accountProposedSubscribers_(ioc_, numShards)
+        , bookSubscribers_(ioc_, numShards)
         , backend_(b)
+        , replayBuffer_(replayLedgers)
     {
         work_.emplace(ioc_);
 
         // We will eventually want to clamp this to be the number of strands,
         // since adding more threads than we have strands won't see any
         // performance benefits
-        log_.info() << "Starting subscription manager with " << numThreads << " workers";
+        log_.info() << "Starting subscription manager with " << numThreads << " workers and " << numShards
+                    << " shards";
 
         workers_.reserve(numThreads);
         for (auto i = numThreads; i > 0; --i)
@@ -264,8 +429,36 @@ public:
     void
     unsubLedger(SessionPtrType session);
 
+    /**
+     * @brief Send the messages published since a ledger to a session, then subscribe it to the same streams
+     *
+     * The ledger and transactions streams and the accounts of the request are replayed from the messages kept for the
+     * most recent ledgers, in the order they were published. Publishing waits while the messages are collected and
+     * handed to the session at once, so no message is lost or sent twice between the replay and the live
+     * subscriptions.
+     *
+     * @param yield The coroutine context, to fetch the ledger returned for the ledger stream
+     * @param session The subscriber
+     * @param fromLedger The first ledger to replay
+     * @param request The streams to replay and subscribe to
+     * @return Like subLedger if the ledger stream is requested, an empty object otherwise; nothing if the messages of
+     * fromLedger are no longer kept, in which case the session is not subscribed
+     */
+    std::optional<boost::json::object>
+    subReplay(
+        boost::asio::yield_context& yield,
+        SessionPtrType session,
+        std::uint32_t fromLedger,
+        ReplayRequest const& request);
+
+    /**
+     * @brief Subscribe to the transactions stream, replacing the filter of an earlier subscription
+     *
+     * @param session The subscriber
+     * @param filter Only transactions matching it are sent; all of them if it is empty
+     */
     void
-    subTransactions(SessionPtrType session);
+    subTransactions(SessionPtrType session, TransactionFilter const& filter = {});
 
     void
     unsubTransactions(SessionPtrType session);
@@ -273,6 +466,21 @@ public:
     void
     pubTransaction(Backend::TransactionAndMetadata const& blobs, ripple::LedgerInfo const& lgrInfo);
 
+    /**
+     * @brief Publish all transactions of a ledger
+     *
+     * The messages are rendered in parallel on the subscription workers. Each message is published, in the order of
+     * the transactions, as soon as it and the ones before it are rendered. The owner funds of all offers created in the
+     * ledger are fetched beforehand, once per account and issue.
+     *
+     * @param transactions The transactions of the ledger, in order
+     * @param lgrInfo The ledger
+     */
+    void
+    pubTransactions(
+        std::vector<Backend::TransactionAndMetadata> const& transactions,
+        ripple::LedgerInfo const& lgrInfo);
+
     void
     subAccount(ripple::AccountID const& account, SessionPtrType const& session);
 
@@ -346,9 +554,60 @@ public:
     }
 
 private:
+    /**
+     * @brief A rendered transaction message and the streams it goes to
+     */
+    struct TransactionMessage
+    {
+        std::uint32_t seq = 0;
+        std::shared_ptr<std::string> message;
+        std::vector<ripple::AccountID> accounts;
+        std::vector<ripple::Book> books;
+
+        // what TransactionFilter looks at
+        ripple::TxType type = ripple::ttINVALID;
+        ripple::TERUnderlyingType result = 0;
+        std::optional<std::int64_t> xrpDrops;
+    };
+
+    // held while publishing the ledger and transactions streams, so that a replay and the live messages that follow
+    // it neither miss nor repeat a message
+    std::mutex replayMtx_;
+    ReplayBuffer<TransactionMessage> replayBuffer_;
+
+    /**
+     * @brief Funds of the owners of offers, by owner and issue offered
+     */
+    using OwnerFunds = std::map<std::pair<ripple::AccountID, ripple::Issue>, ripple::STAmount>;
+
+    OwnerFunds
+    fetchOwnerFunds(std::vector<Backend::TransactionAndMetadata> const& transactions, std::uint32_t seq) const;
+
+    /**
+     * @param ownerFunds Owner funds fetched beforehand; fetched on the spot if missing
+     */
+    TransactionMessage
+    renderTransaction(
+        Backend::TransactionAndMetadata const& blobs,
+        ripple::LedgerInfo const& lgrInfo,
+        OwnerFunds const& ownerFunds = {}) const;
+
+    /**
+     * @brief Send a rendered transaction to its streams; each session gets it once even if it is subscribed to
+     * several of the affected accounts and books
+     */
+    void
+    publishTransaction(TransactionMessage const& txMessage);
+
     void
     sendAll(std::string const& pubMsg, std::unordered_set<SessionPtrType>& subs);
 
+    /**
+     * @brief The response to subscribing to the ledger stream: the latest ledger and the range of ledgers available
+     */
+    boost::json::object
+    ledgerStreamInfo(boost::asio::yield_context& yield) const;
+
     using CleanupFunction = std::function<void(SessionPtrType const)>;
 
     void
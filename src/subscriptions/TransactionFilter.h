@@ -0,0 +1,71 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <ripple/protocol/TER.h>
+#include <ripple/protocol/TxFormats.h>
+
+#include <compare>
+#include <cstdint>
+#include <optional>
+#include <set>
+
+/**
+ * @brief Conditions a transaction must meet to be sent to a filtered subscriber of the transactions stream
+ *
+ * An empty set or a missing amount is no condition. Subscribers with equal filters are grouped, so that each distinct
+ * filter is evaluated once per transaction.
+ */
+struct TransactionFilter
+{
+    std::set<ripple::TxType> types;
+    std::set<ripple::TERUnderlyingType> results;
+    std::optional<std::int64_t> minXrpDrops;  // the transaction's Amount must be XRP and at least this much
+
+    /**
+     * @return true if every transaction matches
+     */
+    bool
+    empty() const
+    {
+        return types.empty() && results.empty() && !minXrpDrops;
+    }
+
+    /**
+     * @param type The type of the transaction
+     * @param result The engine result of the transaction
+     * @param xrpDrops The Amount field of the transaction, if it is in XRP
+     * @return true if the transaction should be sent
+     */
+    bool
+    matches(ripple::TxType type, ripple::TERUnderlyingType result, std::optional<std::int64_t> xrpDrops) const
+    {
+        if (!types.empty() && !types.contains(type))
+            return false;
+
+        if (!results.empty() && !results.contains(result))
+            return false;
+
+        return !minXrpDrops || (xrpDrops && *xrpDrops >= *minXrpDrops);
+    }
+
+    auto
+    operator<=>(TransactionFilter const&) const = default;
+};
@@ -0,0 +1,128 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <util/WorkCost.h>
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/spawn.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
+
+#include <exception>
+#include <optional>
+#include <type_traits>
+
+/*
+ * Code is moving from stackful coroutines (boost::asio::spawn and yield_context) to C++20 coroutines
+ * (boost::asio::awaitable), which only allocate the frame they need instead of a whole stack. The functions below let
+ * either kind call the other while both exist. The cost of the request, if one is bound, follows the call.
+ */
+
+namespace util {
+
+/**
+ * @brief Await a function written for stackful coroutines from a C++20 coroutine
+ *
+ * The function runs in a stackful coroutine spawned on the executor of the caller, so it still pays for a stack.
+ *
+ * @param fn The function to run; it is given the yield_context of the spawned coroutine
+ * @return The result of fn; exceptions thrown by fn are rethrown
+ */
+template <typename Fn>
+boost::asio::awaitable<std::invoke_result_t<Fn, boost::asio::yield_context&>>
+awaitStackful(Fn fn)
+{
+    using ResultType = std::invoke_result_t<Fn, boost::asio::yield_context&>;
+    using SignatureType = void(std::exception_ptr, std::optional<ResultType>);
+
+    auto const executor = co_await boost::asio::this_coro::executor;
+    auto const cost = WorkCost::current();
+    WorkCost::Suspension const suspension;
+
+    auto result = co_await boost::asio::async_initiate<boost::asio::use_awaitable_t<> const, SignatureType>(
+        [&](auto handler) {
+            boost::asio::spawn(
+                executor, [&fn, &cost, handler = std::move(handler)](boost::asio::yield_context yield) mutable {
+                    std::exception_ptr error;
+                    std::optional<ResultType> result;
+                    try
+                    {
+                        WorkCost::Scope const scope{cost};
+                        result.emplace(fn(yield));
+                    }
+                    catch (std::exception const&)
+                    {
+                        error = std::current_exception();
+                    }
+
+                    // resume the caller once this coroutine is done with its stack
+                    auto const handlerExecutor = boost::asio::get_associated_executor(handler);
+                    boost::asio::post(
+                        handlerExecutor,
+                        [handler = std::move(handler), error, result = std::move(result)]() mutable {
+                            std::move(handler)(error, std::move(result));
+                        });
+                });
+        },
+        boost::asio::use_awaitable);
+
+    co_return std::move(*result);
+}
+
+/**
+ * @brief Run a C++20 coroutine from a stackful coroutine, which is suspended until the former is done
+ *
+ * @param yield The currently executing stackful coroutine
+ * @param awaitable The coroutine to run; it is spawned on the executor of yield
+ * @return The result of the awaitable; exceptions thrown by it are rethrown
+ */
+template <typename T>
+T
+runAwaitable(boost::asio::yield_context& yield, boost::asio::awaitable<T> awaitable)
+{
+    auto const cost = WorkCost::current();
+    std::optional<T> result;
+    std::exception_ptr error;
+    {
+        WorkCost::Suspension const suspension;
+        error = boost::asio::async_initiate<boost::asio::yield_context&, void(std::exception_ptr)>(
+            [&](auto handler) {
+                boost::asio::co_spawn(
+                    yield.get_executor(),
+                    [&]() -> boost::asio::awaitable<void> {
+                        WorkCost::Scope const scope{cost};
+                        result.emplace(co_await std::move(awaitable));
+                    },
+                    std::move(handler));
+            },
+            yield);
+    }
+
+    if (error)
+        std::rethrow_exception(error);
+
+    return std::move(*result);
+}
+
+}  // namespace util
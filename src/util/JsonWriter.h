@@ -0,0 +1,186 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/json.hpp>
+
+#include <algorithm>
+#include <cassert>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace util {
+
+/**
+ * @brief Writes JSON into a string piece by piece, so that a large document is never built as a boost::json value
+ *
+ * Values are serialized in chunks straight into the output. Within an object, keys and values must alternate; the
+ * writer adds the separators but does not check the structure it is given.
+ */
+class JsonWriter
+{
+    static constexpr std::size_t MIN_CHUNK = 4096;
+
+    std::string out_;
+    bool needComma_ = false;
+
+public:
+    JsonWriter&
+    startObject()
+    {
+        separate();
+        out_ += '{';
+        needComma_ = false;
+        return *this;
+    }
+
+    JsonWriter&
+    endObject()
+    {
+        out_ += '}';
+        needComma_ = true;
+        return *this;
+    }
+
+    JsonWriter&
+    startArray()
+    {
+        separate();
+        out_ += '[';
+        needComma_ = false;
+        return *this;
+    }
+
+    JsonWriter&
+    endArray()
+    {
+        out_ += ']';
+        needComma_ = true;
+        return *this;
+    }
+
+    JsonWriter&
+    key(std::string_view key)
+    {
+        separate();
+        out_ += boost::json::serialize(boost::json::string{key});
+        out_ += ':';
+        needComma_ = false;
+        return *this;
+    }
+
+    template <typename T>
+    requires std::is_same_v<T, boost::json::value> || std::is_same_v<T, boost::json::object> ||
+        std::is_same_v<T, boost::json::array>
+    JsonWriter&
+    value(T const& value)
+    {
+        separate();
+
+        boost::json::serializer serializer;
+        serializer.reset(&value);
+        while (!serializer.done())
+        {
+            // grow geometrically, like appending would
+            auto const size = out_.size();
+            auto const chunk = std::max(MIN_CHUNK, size);
+            out_.resize(size + chunk);
+            auto const written = serializer.read(out_.data() + size, chunk);
+            out_.resize(size + written.size());
+        }
+
+        needComma_ = true;
+        return *this;
+    }
+
+    JsonWriter&
+    value(std::string_view value)
+    {
+        separate();
+        out_ += boost::json::serialize(boost::json::string{value});
+        needComma_ = true;
+        return *this;
+    }
+
+    template <typename T>
+    requires std::is_arithmetic_v<T>
+    JsonWriter&
+    value(T value)
+    {
+        separate();
+        out_ += boost::json::serialize(boost::json::value{value});
+        needComma_ = true;
+        return *this;
+    }
+
+    template <typename T>
+    JsonWriter&
+    field(std::string_view name, T const& value)
+    {
+        key(name);
+        return this->value(value);
+    }
+
+    /**
+     * @brief Write a value that is serialized already, as it is
+     */
+    JsonWriter&
+    raw(std::string_view json)
+    {
+        separate();
+        out_ += json;
+        needComma_ = true;
+        return *this;
+    }
+
+    /**
+     * @brief Write an object that is serialized already and leave it open, so that more fields can be added to it
+     */
+    JsonWriter&
+    reopenObject(std::string_view object)
+    {
+        assert(object.size() >= 2 && object.front() == '{' && object.back() == '}');
+
+        separate();
+        out_ += object.substr(0, object.size() - 1);
+        needComma_ = object.size() > 2;
+        return *this;
+    }
+
+    /**
+     * @return The JSON written
+     */
+    std::string
+    finish() &&
+    {
+        return std::move(out_);
+    }
+
+private:
+    void
+    separate()
+    {
+        if (needComma_)
+            out_ += ',';
+    }
+};
+
+}  // namespace util
@@ -20,6 +20,7 @@
 #pragma once
 
 #include <ripple/basics/StringUtilities.h>
+#include <ripple/protocol/Serializer.h>
 
 #include <sstream>
 #include <string>
@@ -46,6 +47,26 @@ deserializeHeader(ripple::Slice data)
     return info;
 }
 
+/**
+ * @brief Serialize a ledger header, including its hash, in the form read by deserializeHeader
+ */
+inline std::string
+serializeHeader(ripple::LedgerInfo const& info)
+{
+    ripple::Serializer s;
+    s.add32(info.seq);
+    s.add64(info.drops.drops());
+    s.addBitString(info.parentHash);
+    s.addBitString(info.txHash);
+    s.addBitString(info.accountHash);
+    s.add32(info.parentCloseTime.time_since_epoch().count());
+    s.add32(info.closeTime.time_since_epoch().count());
+    s.add8(info.closeTimeResolution.count());
+    s.add8(info.closeFlags);
+    s.addBitString(info.hash);
+    return std::string{static_cast<char const*>(s.getDataPtr()), s.getDataLength()};
+}
+
 inline std::string
 toString(ripple::LedgerInfo const& info)
 {
@@ -0,0 +1,113 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/WorkCost.h>
+
+#include <time.h>
+
+namespace util {
+
+namespace {
+
+std::chrono::nanoseconds
+threadCpuTime()
+{
+    timespec ts{};
+    clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+    return std::chrono::seconds{ts.tv_sec} + std::chrono::nanoseconds{ts.tv_nsec};
+}
+
+struct Binding
+{
+    std::shared_ptr<WorkCost> cost;
+    std::chrono::nanoseconds since{0};
+};
+
+// only accessed through binding(), in functions that never suspend: a coroutine may resume on another thread
+thread_local Binding gBinding;
+
+Binding&
+binding()
+{
+    return gBinding;
+}
+
+}  // namespace
+
+void
+WorkCost::bind(std::shared_ptr<WorkCost> cost)
+{
+    unbind();
+
+    auto& current = binding();
+    current.cost = std::move(cost);
+    current.since = threadCpuTime();
+}
+
+std::shared_ptr<WorkCost>
+WorkCost::unbind()
+{
+    auto& current = binding();
+    if (current.cost)
+        current.cost->cpuTimeNs_ += (threadCpuTime() - current.since).count();
+
+    return std::move(current.cost);
+}
+
+WorkCost::Scope::Scope(std::shared_ptr<WorkCost> cost)
+{
+    bind(std::move(cost));
+}
+
+WorkCost::Scope::~Scope()
+{
+    unbind();
+}
+
+WorkCost::Suspension::Suspension() : cost_{unbind()}
+{
+}
+
+WorkCost::Suspension::~Suspension()
+{
+    if (cost_)
+        bind(std::move(cost_));
+}
+
+std::shared_ptr<WorkCost>
+WorkCost::current()
+{
+    return binding().cost;
+}
+
+void
+WorkCost::recordReads(std::uint64_t count) noexcept
+{
+    if (auto const& cost = binding().cost; cost)
+        cost->reads_ += count;
+}
+
+void
+WorkCost::recordCacheMisses(std::uint64_t count) noexcept
+{
+    if (auto const& cost = binding().cost; cost)
+        cost->cacheMisses_ += count;
+}
+
+}  // namespace util
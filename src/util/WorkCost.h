@@ -0,0 +1,121 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <memory>
+
+namespace util {
+
+/**
+ * @brief Resources used to serve one request: database reads, cache misses and CPU time
+ *
+ * The code serving a request does not pass its cost around; the cost is bound to the thread running the coroutine of
+ * the request instead (see Scope) and the backend records its work into whichever cost is bound. As the coroutine may
+ * resume on another thread, the places where it suspends unbind the cost and bind it again on resumption (see
+ * Suspension). CPU time is counted while the cost is bound.
+ */
+class WorkCost
+{
+    std::atomic_uint64_t reads_ = 0;
+    std::atomic_uint64_t cacheMisses_ = 0;
+    std::atomic_int64_t cpuTimeNs_ = 0;
+
+    // bind the cost to the current thread, replacing the one bound already
+    static void
+    bind(std::shared_ptr<WorkCost> cost);
+
+    // unbind the cost bound to the current thread and return it
+    static std::shared_ptr<WorkCost>
+    unbind();
+
+public:
+    /**
+     * @brief Binds a cost to the current thread for the lifetime of this object
+     */
+    class Scope
+    {
+    public:
+        explicit Scope(std::shared_ptr<WorkCost> cost);
+        ~Scope();
+
+        Scope(Scope const&) = delete;
+        Scope&
+        operator=(Scope const&) = delete;
+    };
+
+    /**
+     * @brief Unbinds the cost of the current coroutine while it is suspended and binds it again once it resumes
+     *
+     * Must be created right before the coroutine suspends and destroyed right after it resumes.
+     */
+    class Suspension
+    {
+        std::shared_ptr<WorkCost> cost_;
+
+    public:
+        Suspension();
+        ~Suspension();
+
+        Suspension(Suspension const&) = delete;
+        Suspension&
+        operator=(Suspension const&) = delete;
+    };
+
+    /**
+     * @return The cost bound to the current thread, if any
+     */
+    static std::shared_ptr<WorkCost>
+    current();
+
+    /**
+     * @brief Record database reads into the cost bound to the current thread, if any
+     */
+    static void
+    recordReads(std::uint64_t count) noexcept;
+
+    /**
+     * @brief Record cache misses into the cost bound to the current thread, if any
+     */
+    static void
+    recordCacheMisses(std::uint64_t count) noexcept;
+
+    [[nodiscard]] std::uint64_t
+    reads() const noexcept
+    {
+        return reads_;
+    }
+
+    [[nodiscard]] std::uint64_t
+    cacheMisses() const noexcept
+    {
+        return cacheMisses_;
+    }
+
+    [[nodiscard]] std::chrono::nanoseconds
+    cpuTime() const noexcept
+    {
+        return std::chrono::nanoseconds{cpuTimeNs_.load()};
+    }
+};
+
+}  // namespace util
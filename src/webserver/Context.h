@@ -22,6 +22,7 @@
 #include <backend/BackendInterface.h>
 #include <log/Logger.h>
 #include <util/Taggable.h>
+#include <util/WorkCost.h>
 #include <webserver/interface/ConnectionBase.h>
 
 #include <boost/asio/spawn.hpp>
@@ -41,6 +42,7 @@ struct Context : util::Taggable
     std::shared_ptr<Server::ConnectionBase> session;
     Backend::LedgerRange range;
     std::string clientIp;
+    std::shared_ptr<util::WorkCost> cost = std::make_shared<util::WorkCost>();  // resources used to serve the request
 
     Context(
         boost::asio::yield_context& yield,
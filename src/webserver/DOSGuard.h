@@ -19,53 +19,172 @@
 
 #pragma once
 
+#include <boost/algorithm/string/predicate.hpp>
 #include <boost/asio.hpp>
-#include <boost/iterator/transform_iterator.hpp>
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cassert>
 #include <chrono>
+#include <mutex>
+#include <shared_mutex>
+#include <stdexcept>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
 #include <unordered_set>
 
 #include <config/Config.h>
+#include <log/Logger.h>
+#include <util/WorkCost.h>
+#include <webserver/details/RateLimit.h>
 
 namespace clio {
 
-class BaseDOSGuard
+/**
+ * @brief Limits of the queue of messages waiting to be sent to a websocket client
+ *
+ * A client that reads slower than messages are published to it would otherwise make the queue grow without bounds.
+ */
+struct SendQueueLimits
 {
-public:
-    virtual ~BaseDOSGuard() = default;
+    /**
+     * @brief What to do with a client whose queue is over its limits
+     */
+    enum class Policy {
+        DropOldest,  // drop the oldest queued messages
+        DropStream,  // drop the oldest queued stream messages; responses to requests are always sent
+        Disconnect   // close the connection with a reason
+    };
+
+    std::size_t maxMessages = 0;  // 0 means no limit
+    std::size_t maxBytes = 0;     // 0 means no limit
+    Policy policy = Policy::DropStream;
 
-    virtual void
-    clear() noexcept = 0;
+    /**
+     * @brief Read the limits from the "dos_guard" section of the config
+     */
+    static SendQueueLimits
+    fromConfig(clio::Config const& config)
+    {
+        SendQueueLimits limits;
+        limits.maxMessages = config.valueOr<std::size_t>("dos_guard.max_queued_messages", limits.maxMessages);
+        limits.maxBytes = config.valueOr<std::size_t>("dos_guard.max_queued_bytes", limits.maxBytes);
+
+        auto const policy = config.valueOr<std::string>("dos_guard.slow_consumer_policy", "drop_stream");
+        if (boost::iequals(policy, "drop_oldest"))
+            limits.policy = Policy::DropOldest;
+        else if (boost::iequals(policy, "disconnect"))
+            limits.policy = Policy::Disconnect;
+        else if (boost::iequals(policy, "drop_stream"))
+            limits.policy = Policy::DropStream;
+        else
+            throw std::runtime_error("Invalid dos_guard.slow_consumer_policy: " + policy);
+
+        return limits;
+    }
+
+    bool
+    isExceeded(std::size_t messages, std::size_t bytes) const
+    {
+        return (maxMessages != 0 && messages > maxMessages) || (maxBytes != 0 && bytes > maxBytes);
+    }
 };
 
 /**
- * @brief A simple denial of service guard used for rate limiting.
+ * @brief How much each resource used to serve a request counts towards the work cost limit of a client
+ */
+struct WorkCostWeights
+{
+    // the work cost buckets count thousandths of a point, so that requests using less than a millisecond of CPU time
+    // are charged for it too
+    static constexpr std::uint64_t MILLIPOINTS_PER_POINT = 1000;
+
+    std::uint32_t read = 1;       // per database read
+    std::uint32_t cacheMiss = 0;  // per ledger cache miss; these are also counted as reads
+    std::uint32_t cpuMs = 1;      // per millisecond of CPU time
+
+    /**
+     * @brief Read the weights from the "dos_guard.cost" section of the config
+     */
+    static WorkCostWeights
+    fromConfig(clio::Config const& config)
+    {
+        WorkCostWeights weights;
+        weights.read = config.valueOr("dos_guard.cost.read", weights.read);
+        weights.cacheMiss = config.valueOr("dos_guard.cost.cache_miss", weights.cacheMiss);
+        weights.cpuMs = config.valueOr("dos_guard.cost.cpu_ms", weights.cpuMs);
+        return weights;
+    }
+
+    /**
+     * @return The cost of the work done, in thousandths of a point
+     */
+    std::uint64_t
+    millipoints(util::WorkCost const& cost) const
+    {
+        return millipoints(cost.reads(), cost.cacheMisses(), cost.cpuTime());
+    }
+
+    /**
+     * @return The cost of the given reads, cache misses and CPU time, in thousandths of a point
+     */
+    std::uint64_t
+    millipoints(std::uint64_t reads, std::uint64_t cacheMisses, std::chrono::nanoseconds cpuTime) const
+    {
+        static constexpr std::uint64_t NS_PER_MS = 1'000'000;
+
+        auto const cpuNs = static_cast<std::uint64_t>(std::max<std::int64_t>(cpuTime.count(), 0));
+        return (reads * read + cacheMisses * cacheMiss) * MILLIPOINTS_PER_POINT +
+            cpuNs * cpuMs * MILLIPOINTS_PER_POINT / NS_PER_MS;
+    }
+};
+
+/**
+ * @brief A denial of service guard used for rate limiting.
+ *
+ * Each client, identified by its binary ip address, has token buckets for the bytes sent to it, the requests it makes
+ * and the work cost of those requests. The buckets refill continuously at their limit per "dos_guard.sweep_interval",
+ * so there is no moment at which all clients are let loose at once.
+ *
+ * Clients are spread over shards by the hash of their address. Known clients are only looked up under a shared lock
+ * of their shard and their buckets are updated without locking at all; a shard is exclusively locked to add a new
+ * client, which is also when idle clients of that shard are forgotten.
  *
- * @tparam SweepHandler Type of the sweep handler
+ * @tparam ClockType The clock used to refill the buckets
  */
-template <typename SweepHandler>
-class BasicDOSGuard : public BaseDOSGuard
+template <typename ClockType = std::chrono::steady_clock>
+class BasicDOSGuard
 {
-    // Accumulated state per IP, state will be reset accordingly
+    static constexpr std::size_t SHARD_COUNT = 64;
+    static constexpr std::size_t MIN_PRUNE_SIZE = 1024;
+
     struct ClientState
     {
-        // accumulated transfered byte
-        std::uint32_t transferedByte = 0;
-        // accumulated served requests count
-        std::uint32_t requestsCount = 0;
+        detail::TokenBucket transferedBytes;
+        detail::TokenBucket requests;
+        detail::TokenBucket workCost;
+        std::atomic_uint32_t connections = 0;
+    };
+
+    struct alignas(64) Shard
+    {
+        mutable std::shared_mutex mtx;
+        std::unordered_map<detail::ClientKey, ClientState, detail::ClientKeyHash> clients;
+        std::size_t pruneAt = MIN_PRUNE_SIZE;
     };
 
-    mutable std::mutex mtx_;
-    // accumulated states map
-    std::unordered_map<std::string, ClientState> ipState_;
-    std::unordered_map<std::string, std::uint32_t> ipConnCount_;
-    std::unordered_set<std::string> const whitelist_;
+    mutable std::array<Shard, SHARD_COUNT> shards_;
+    std::unordered_set<detail::ClientKey, detail::ClientKeyHash> const whitelist_;
+    typename ClockType::time_point const start_ = ClockType::now();
 
-    std::uint32_t const maxFetches_;
+    detail::RefillRate const fetchRate_;
+    detail::RefillRate const requestRate_;
+    detail::RefillRate const workCostRate_;  // in thousandths of a point; capacity of 0 is no limit
     std::uint32_t const maxConnCount_;
-    std::uint32_t const maxRequestCount_;
+    WorkCostWeights const workCostWeights_;
+    SendQueueLimits const sendQueueLimits_;
     clio::Logger log_{"RPC"};
 
 public:
@@ -73,15 +192,18 @@ public:
      * @brief Constructs a new DOS guard.
      *
      * @param config Clio config
-     * @param sweepHandler Sweep handler that implements the sweeping behaviour
      */
-    BasicDOSGuard(clio::Config const& config, SweepHandler& sweepHandler)
+    explicit BasicDOSGuard(clio::Config const& config)
         : whitelist_{getWhitelist(config)}
-        , maxFetches_{config.valueOr("dos_guard.max_fetches", 1000000u)}
+        , fetchRate_{config.valueOr("dos_guard.max_fetches", 1000000u), getInterval(config)}
+        , requestRate_{config.valueOr("dos_guard.max_requests", 20u), getInterval(config)}
+        , workCostRate_{
+              config.valueOr<std::uint64_t>("dos_guard.max_cost", 0u) * WorkCostWeights::MILLIPOINTS_PER_POINT,
+              getInterval(config)}
         , maxConnCount_{config.valueOr("dos_guard.max_connections", 20u)}
-        , maxRequestCount_{config.valueOr("dos_guard.max_requests", 20u)}
+        , workCostWeights_{WorkCostWeights::fromConfig(config)}
+        , sendQueueLimits_{SendQueueLimits::fromConfig(config)}
     {
-        sweepHandler.setup(this);
     }
 
     /**
@@ -94,7 +216,7 @@ public:
     [[nodiscard]] bool
     isWhiteListed(std::string const& ip) const noexcept
     {
-        return whitelist_.contains(ip);
+        return whitelist_.contains(detail::makeClientKey(ip));
     }
 
     /**
@@ -107,33 +229,14 @@ public:
     [[nodiscard]] bool
     isOk(std::string const& ip) const noexcept
     {
-        if (whitelist_.contains(ip))
+        auto const key = detail::makeClientKey(ip);
+        if (whitelist_.contains(key))
             return true;
 
-        {
-            std::scoped_lock lck(mtx_);
-            if (ipState_.find(ip) != ipState_.end())
-            {
-                auto [transferedByte, requests] = ipState_.at(ip);
-                if (transferedByte > maxFetches_ || requests > maxRequestCount_)
-                {
-                    log_.warn() << "Dosguard:Client surpassed the rate limit. ip = " << ip
-                                << " Transfered Byte:" << transferedByte << " Requests:" << requests;
-                    return false;
-                }
-            }
-            auto it = ipConnCount_.find(ip);
-            if (it != ipConnCount_.end())
-            {
-                if (it->second > maxConnCount_)
-                {
-                    log_.warn() << "Dosguard:Client surpassed the rate limit. ip = " << ip
-                                << " Concurrent connection:" << it->second;
-                    return false;
-                }
-            }
-        }
-        return true;
+        auto& shard = shardFor(key);
+        std::shared_lock const lck{shard.mtx};
+        auto const it = shard.clients.find(key);
+        return it == shard.clients.end() || isOk(ip, it->second);
     }
 
     /**
@@ -144,10 +247,7 @@ public:
     void
     increment(std::string const& ip) noexcept
     {
-        if (whitelist_.contains(ip))
-            return;
-        std::scoped_lock lck{mtx_};
-        ipConnCount_[ip]++;
+        update(ip, [](ClientState& state) { ++state.connections; });
     }
 
     /**
@@ -158,21 +258,17 @@ public:
     void
     decrement(std::string const& ip) noexcept
     {
-        if (whitelist_.contains(ip))
-            return;
-        std::scoped_lock lck{mtx_};
-        assert(ipConnCount_[ip] > 0);
-        ipConnCount_[ip]--;
-        if (ipConnCount_[ip] == 0)
-            ipConnCount_.erase(ip);
+        update(ip, [](ClientState& state) {
+            [[maybe_unused]] auto const previous = state.connections--;
+            assert(previous > 0);
+        });
     }
 
     /**
      * @brief Adds numObjects of usage for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxFetches_
-     * the operation is no longer allowed and false is returned; true is
-     * returned otherwise.
+     * If the bytes in use sum up to a value larger than max_fetches the operation is no longer allowed and false is
+     * returned; true is returned otherwise.
      *
      * @param ip
      * @param numObjects
@@ -182,23 +278,17 @@ public:
     [[maybe_unused]] bool
     add(std::string const& ip, uint32_t numObjects) noexcept
     {
-        if (whitelist_.contains(ip))
-            return true;
-
-        {
-            std::scoped_lock lck(mtx_);
-            ipState_[ip].transferedByte += numObjects;
-        }
-
-        return isOk(ip);
+        return update(ip, [&](ClientState& state) {
+            state.transferedBytes.consume(numObjects, fetchRate_.ticks(sinceStart()));
+            return isOk(ip, state);
+        });
     }
 
     /**
      * @brief Adds one request for the given ip address.
      *
-     * If the total sums up to a value equal or larger than maxRequestCount_
-     * the operation is no longer allowed and false is returned; true is
-     * returned otherwise.
+     * If the requests in use sum up to a value larger than max_requests the operation is no longer allowed and false
+     * is returned; true is returned otherwise.
      *
      * @param ip
      * @return true
@@ -207,101 +297,175 @@ public:
     [[maybe_unused]] bool
     request(std::string const& ip) noexcept
     {
-        if (whitelist_.contains(ip))
-            return true;
+        return update(ip, [&](ClientState& state) {
+            state.requests.consume(1, requestRate_.ticks(sinceStart()));
+            return isOk(ip, state);
+        });
+    }
 
-        {
-            std::scoped_lock lck(mtx_);
-            ipState_[ip].requestsCount++;
-        }
+    /**
+     * @brief Adds the work done to serve a request for the given ip address.
+     *
+     * The work is weighted into points according to the "dos_guard.cost" config. If the points in use sum up to a
+     * value larger than max_cost the operation is no longer allowed and false is returned; true is returned otherwise.
+     *
+     * @param ip
+     * @param cost The resources used to serve the request
+     * @return true
+     * @return false
+     */
+    [[maybe_unused]] bool
+    addCost(std::string const& ip, util::WorkCost const& cost) noexcept
+    {
+        if (workCostRate_.capacity() == 0)
+            return isOk(ip);
+
+        return update(ip, [&](ClientState& state) {
+            state.workCost.consume(workCostWeights_.millipoints(cost), workCostRate_.ticks(sinceStart()));
+            return isOk(ip, state);
+        });
+    }
 
-        return isOk(ip);
+    /**
+     * @brief Limits of the queue of messages waiting to be sent to each websocket client
+     */
+    [[nodiscard]] SendQueueLimits const&
+    sendQueueLimits() const noexcept
+    {
+        return sendQueueLimits_;
     }
 
     /**
-     * @brief Instantly clears all fetch counters added by @see add(std::string
-     * const&, uint32_t)
+     * @brief Instantly refills the buckets of all clients
      */
     void
-    clear() noexcept override
+    clear() noexcept
     {
-        std::scoped_lock lck(mtx_);
-        ipState_.clear();
+        for (auto& shard : shards_)
+        {
+            std::shared_lock const lck{shard.mtx};
+            for (auto& [_, state] : shard.clients)
+            {
+                state.transferedBytes.reset();
+                state.requests.reset();
+                state.workCost.reset();
+            }
+        }
     }
 
 private:
-    [[nodiscard]] std::unordered_set<std::string> const
-    getWhitelist(clio::Config const& config) const
+    [[nodiscard]] Shard&
+    shardFor(detail::ClientKey const& key) const noexcept
     {
-        using T = std::unordered_set<std::string> const;
-        auto whitelist = config.arrayOr("dos_guard.whitelist", {});
-        auto const transform = [](auto const& elem) { return elem.template value<std::string>(); };
-        return T{
-            boost::transform_iterator(std::begin(whitelist), transform),
-            boost::transform_iterator(std::end(whitelist), transform)};
+        return shards_[detail::ClientKeyHash{}(key) % SHARD_COUNT];
     }
-};
 
-/**
- * @brief Sweep handler using a steady_timer and boost::asio::io_context.
- */
-class IntervalSweepHandler
-{
-    std::chrono::milliseconds sweepInterval_;
-    std::reference_wrapper<boost::asio::io_context> ctx_;
-    BaseDOSGuard* dosGuard_ = nullptr;
-
-    boost::asio::steady_timer timer_{ctx_.get()};
+    [[nodiscard]] std::chrono::nanoseconds
+    sinceStart() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(ClockType::now() - start_);
+    }
 
-public:
     /**
-     * @brief Construct a new interval-based sweep handler
-     *
-     * @param config Clio config
-     * @param ctx The boost::asio::io_context
+     * @brief Run fn on the state of the client, creating the state if needed; whitelisted clients are always ok
      */
-    IntervalSweepHandler(clio::Config const& config, boost::asio::io_context& ctx)
-        : sweepInterval_{std::max(1u, static_cast<uint32_t>(config.valueOr("dos_guard.sweep_interval", 1.0) * 1000.0))}
-        , ctx_{std::ref(ctx)}
+    template <typename Fn>
+    bool
+    update(std::string const& ip, Fn&& fn) noexcept
     {
-    }
+        auto const key = detail::makeClientKey(ip);
+        if (whitelist_.contains(key))
+            return true;
 
-    ~IntervalSweepHandler()
-    {
-        timer_.cancel();
+        auto const run = [&fn](ClientState& state) {
+            if constexpr (std::is_void_v<std::invoke_result_t<Fn, ClientState&>>)
+            {
+                fn(state);
+                return true;
+            }
+            else
+            {
+                return fn(state);
+            }
+        };
+
+        auto& shard = shardFor(key);
+        {
+            std::shared_lock const lck{shard.mtx};
+            if (auto const it = shard.clients.find(key); it != shard.clients.end())
+                return run(it->second);
+        }
+
+        std::unique_lock const lck{shard.mtx};
+        if (shard.clients.size() >= shard.pruneAt)
+            prune(shard);
+
+        return run(shard.clients.try_emplace(key).first->second);
     }
 
     /**
-     * @brief This setup member function is called by @ref BasicDOSGuard during
-     * its initialization.
-     *
-     * @param guard Pointer to the dos guard
+     * @brief Forget the clients of a shard that have no connections and whose buckets are full, which is the same as
+     * never having seen them; the shard must be exclusively locked
      */
     void
-    setup(BaseDOSGuard* guard)
+    prune(Shard& shard) const noexcept
     {
-        assert(dosGuard_ == nullptr);
-        dosGuard_ = guard;
-        assert(dosGuard_ != nullptr);
+        auto const now = sinceStart();
+        std::erase_if(shard.clients, [&](auto const& entry) {
+            auto const& state = entry.second;
+            return state.connections == 0 && state.transferedBytes.used(fetchRate_.ticks(now)) == 0 &&
+                state.requests.used(requestRate_.ticks(now)) == 0 &&
+                state.workCost.used(workCostRate_.ticks(now)) == 0;
+        });
 
-        createTimer();
+        // prune again once the shard doubled, so the cost of pruning is spread over the clients added meanwhile
+        shard.pruneAt = std::max(MIN_PRUNE_SIZE, shard.clients.size() * 2);
     }
 
-private:
-    void
-    createTimer()
+    [[nodiscard]] bool
+    isOk(std::string const& ip, ClientState const& state) const noexcept
     {
-        timer_.expires_after(sweepInterval_);
-        timer_.async_wait([this](boost::system::error_code const& error) {
-            if (error == boost::asio::error::operation_aborted)
-                return;
+        auto const now = sinceStart();
+        auto const transferedBytes = state.transferedBytes.used(fetchRate_.ticks(now));
+        auto const requests = state.requests.used(requestRate_.ticks(now));
+        auto const workCost = state.workCost.used(workCostRate_.ticks(now));
+        if (transferedBytes > fetchRate_.capacity() || requests > requestRate_.capacity() ||
+            (workCostRate_.capacity() != 0 && workCost > workCostRate_.capacity()))
+        {
+            log_.warn() << "Dosguard:Client surpassed the rate limit. ip = " << ip
+                        << " Transfered Byte:" << transferedBytes << " Requests:" << requests
+                        << " Work cost:" << workCost / WorkCostWeights::MILLIPOINTS_PER_POINT;
+            return false;
+        }
 
-            dosGuard_->clear();
-            createTimer();
-        });
+        if (auto const connections = state.connections.load(); connections > maxConnCount_)
+        {
+            log_.warn() << "Dosguard:Client surpassed the rate limit. ip = " << ip
+                        << " Concurrent connection:" << connections;
+            return false;
+        }
+
+        return true;
+    }
+
+    [[nodiscard]] static std::chrono::nanoseconds
+    getInterval(clio::Config const& config)
+    {
+        auto const seconds = std::max(0.001, config.valueOr("dos_guard.sweep_interval", 1.0));
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::duration<double>{seconds});
+    }
+
+    [[nodiscard]] static std::unordered_set<detail::ClientKey, detail::ClientKeyHash>
+    getWhitelist(clio::Config const& config)
+    {
+        std::unordered_set<detail::ClientKey, detail::ClientKeyHash> whitelist;
+        for (auto const& elem : config.arrayOr("dos_guard.whitelist", {}))
+            whitelist.insert(detail::makeClientKey(elem.value<std::string>()));
+
+        return whitelist;
     }
 };
 
-using DOSGuard = BasicDOSGuard<IntervalSweepHandler>;
+using DOSGuard = BasicDOSGuard<>;
 
 }  // namespace clio
@@ -36,6 +36,7 @@ class HttpSession : public HttpBase<HttpSession, Handler>, public std::enable_sh
 {
     boost::beast::tcp_stream stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
+    std::shared_ptr<WsCompression> compression_;
 
 public:
     explicit HttpSession(
@@ -43,11 +44,13 @@ public:
         std::string const& ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer buffer)
         : HttpBase<HttpSession, Handler>(ip, tagFactory, dosGuard, handler, std::move(buffer))
         , stream_(std::move(socket))
         , tagFactory_(tagFactory)
+        , compression_(std::move(compression))
     {
     }
 
@@ -90,6 +93,7 @@ public:
             this->clientIp,
             tagFactory_,
             this->dosGuard_,
+            compression_,
             this->handler_,
             std::move(this->buffer_),
             std::move(this->req_))
@@ -30,7 +30,7 @@ namespace Server {
 template <ServerHandler Handler>
 class PlainWsSession : public WsBase<PlainWsSession, Handler>
 {
-    boost::beast::websocket::stream<boost::beast::tcp_stream> ws_;
+    boost::beast::websocket::stream<detail::CoalescingStream<boost::beast::tcp_stream>> ws_;
 
 public:
     explicit PlainWsSession(
@@ -38,13 +38,15 @@ public:
         std::string ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& callback,
         boost::beast::flat_buffer&& buffer)
-        : WsBase<PlainWsSession, Handler>(ip, tagFactory, dosGuard, callback, std::move(buffer)), ws_(std::move(socket))
+        : WsBase<PlainWsSession, Handler>(ip, tagFactory, dosGuard, std::move(compression), callback, std::move(buffer))
+        , ws_(std::move(socket))
     {
     }
 
-    boost::beast::websocket::stream<boost::beast::tcp_stream>&
+    boost::beast::websocket::stream<detail::CoalescingStream<boost::beast::tcp_stream>>&
     ws()
     {
         return ws_;
@@ -65,6 +67,7 @@ class WsUpgrader : public std::enable_shared_from_this<WsUpgrader<Handler>>
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::reference_wrapper<clio::DOSGuard> dosGuard_;
+    std::shared_ptr<WsCompression> compression_;
     http::request<http::string_body> req_;
     std::string ip_;
     std::shared_ptr<Handler> const handler_;
@@ -75,6 +78,7 @@ public:
         std::string ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer&& b,
         http::request<http::string_body> req)
@@ -82,6 +86,7 @@ public:
         , buffer_(std::move(b))
         , tagFactory_(tagFactory)
         , dosGuard_(dosGuard)
+        , compression_(std::move(compression))
         , req_(std::move(req))
         , ip_(ip)
         , handler_(handler)
@@ -122,7 +127,7 @@ private:
         boost::beast::get_lowest_layer(http_).expires_never();
 
         std::make_shared<PlainWsSession<Handler>>(
-            http_.release_socket(), ip_, tagFactory_, dosGuard_, handler_, std::move(buffer_))
+            http_.release_socket(), ip_, tagFactory_, dosGuard_, compression_, handler_, std::move(buffer_))
             ->run(std::move(req_));
     }
 };
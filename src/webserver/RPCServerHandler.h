@@ -19,16 +19,26 @@
 
 #pragma once
 
+#include <backend/CachePage.h>
+#include <etl/impl/LedgerFeed.h>
 #include <rpc/Errors.h>
 #include <rpc/Factories.h>
 #include <rpc/RPCHelpers.h>
 #include <rpc/common/impl/APIVersionParser.h>
+#include <rpc/common/impl/AdminVerificationStrategy.h>
 #include <util/JsonUtils.h>
 #include <util/Profiler.h>
 #include <webserver/details/ErrorHandling.h>
+#include <webserver/details/ResponseWriter.h>
 
+#include <boost/asio/steady_timer.hpp>
+#include <boost/json/monotonic_resource.hpp>
 #include <boost/json/parse.hpp>
 
+#include <chrono>
+#include <string_view>
+#include <unordered_set>
+
 /**
  * @brief The server handler for RPC requests called by web server
  *
@@ -37,6 +47,10 @@
 template <class Engine, class ETL>
 class RPCServerHandler
 {
+    // smallest arena a request is parsed into; the parsed tree is a few times larger than the text
+    static constexpr std::size_t MIN_ARENA_SIZE = 4096;
+    static constexpr std::size_t ARENA_SIZE_FACTOR = 4;
+
     std::shared_ptr<BackendInterface const> const backend_;
     std::shared_ptr<Engine> const rpcEngine_;
     std::shared_ptr<ETL const> const etl_;
@@ -44,6 +58,11 @@ class RPCServerHandler
     std::weak_ptr<SubscriptionManager> const subscriptions_;
     util::TagDecoratorFactory const tagFactory_;
     RPC::detail::ProductionAPIVersionParser apiVersionParser_;  // can be injected if needed
+    RPC::detail::IPAdminVerificationStrategy adminVerifier_;
+
+    // ips of the Clio nodes allowed to download the cache from this node, besides admin
+    std::unordered_set<std::string> const cachePeers_;
+    std::unordered_set<std::string> const ledgerFeedPeers_;
 
     clio::Logger log_{"RPC"};
     clio::Logger perfLog_{"Performance"};
@@ -61,6 +80,8 @@ public:
         , subscriptions_(subscriptions)
         , tagFactory_(config)
         , apiVersionParser_(config.sectionOr("api_version", {}))
+        , cachePeers_(getAllowedPeers(config, "cache.allowed_peers"))
+        , ledgerFeedPeers_(getAllowedPeers(config, "ledger_feed.allowed_peers"))
     {
     }
 
@@ -74,17 +95,34 @@ public:
     {
         try
         {
-            auto req = boost::json::parse(reqStr).as_object();
+            // each request gets its own arena, shared by the copies made from the request (context params, validated
+            // input) and released once the last of them is gone. the arena is not thread safe: these copies must not
+            // be used outside of the processing of this request
+            auto arena = boost::json::make_shared_resource<boost::json::monotonic_resource>(
+                std::max(MIN_ARENA_SIZE, reqStr.size() * ARENA_SIZE_FACTOR));
+            auto parsed = boost::json::parse(reqStr, std::move(arena));
+            auto req = std::move(parsed.as_object());
             perfLog_.debug() << connection->tag() << "Adding to work queue";
 
             if (not connection->upgraded and not req.contains("params"))
                 req["params"] = boost::json::array({boost::json::object{}});
 
+            // the method determines the priority of the request; malformed requests are rejected when processed
+            auto const method = [&req]() -> std::string {
+                for (auto const* key : {"command", "method"})
+                {
+                    if (auto const* value = req.if_contains(key); value != nullptr && value->is_string())
+                        return std::string{value->as_string()};
+                }
+                return {};
+            }();
+
             if (!rpcEngine_->post(
                     [request = std::move(req), connection, this](boost::asio::yield_context yc) mutable {
                         handleRequest(yc, std::move(request), connection);
                     },
-                    connection->clientIp))
+                    connection->clientIp,
+                    method))
             {
                 rpcEngine_->notifyTooBusy();
                 Server::detail::ErrorHelper(connection).sendTooBusyError();
@@ -110,6 +148,51 @@ public:
         }
     }
 
+    /**
+     * @brief Whether a GET request for the given target is served by serveBinary
+     *
+     * @param target The HTTP target of the request
+     */
+    bool
+    isBinaryTarget(std::string_view target) const
+    {
+        return target.starts_with(Backend::CachePage::TARGET) or target.starts_with(clio::detail::LedgerFeed::TARGET);
+    }
+
+    /**
+     * @brief The callback when server receives a GET request for binary data
+     *
+     * @param target The HTTP target of the request; see isBinaryTarget
+     * @param connection The connection
+     */
+    void
+    serveBinary(std::string_view target, std::shared_ptr<Server::ConnectionBase> const& connection)
+    {
+        if (target.starts_with(clio::detail::LedgerFeed::TARGET))
+            serveLedgerFeed(target, connection);
+        else
+            serveCache(target, connection);
+    }
+
+    /**
+     * @brief The callback when messages queued for a slow websocket client are dropped
+     * @param count The number of messages dropped
+     */
+    void
+    onMessagesDropped(std::size_t count)
+    {
+        rpcEngine_->notifyMessagesDropped(count);
+    }
+
+    /**
+     * @brief The callback when a slow websocket client is disconnected
+     */
+    void
+    onSlowConsumerDisconnected()
+    {
+        rpcEngine_->notifySlowConsumerDisconnected();
+    }
+
     /**
      * @brief The callback when there is an error.
      * Remove the session shared ptr from subscription manager
@@ -124,6 +207,117 @@ public:
     }
 
 private:
+    /**
+     * @brief The callback when server receives a request for a page of the ledger cache
+     *
+     * Only admin and the peers listed in cache.allowed_peers may download the cache; everyone else gets 403.
+     *
+     * Used by other Clio nodes to download the cache in binary form (see Backend::CachePage). The page is read from the
+     * cache while its latest ledger is the requested one, and from the database at the requested ledger once the
+     * cache has moved past it, so that all pages of a download are of the same ledger. A node that is still behind
+     * answers 503 so that the peer tries again; a node whose database no longer has the ledger answers 409 and the
+     * peer falls back to ledger_data.
+     *
+     * @param target The HTTP target of the request
+     * @param connection The connection
+     */
+    void
+    serveCache(std::string_view target, std::shared_ptr<Server::ConnectionBase> const& connection)
+    {
+        if (not isAllowedPeer(cachePeers_, connection->clientIp))
+            return connection->sendBinary("Forbidden", boost::beast::http::status::forbidden);
+
+        auto const request = Backend::CachePage::Request::parse(target);
+        if (!request)
+            return connection->sendBinary("Malformed cache request", boost::beast::http::status::bad_request);
+
+        if (!rpcEngine_->post(
+                [request = *request, connection, this](boost::asio::yield_context yield) {
+                    auto const seq = request.ledgerSequence;
+                    auto page = backend_->cache().getPage(
+                        request.from, request.to, Backend::CachePage::MAX_PAGE_BYTES, request.ledgerSequence);
+
+                    auto const range = backend_->fetchLedgerRange();
+                    if (!page and range and range->minSequence <= seq and seq <= range->maxSequence)
+                        page = backend_->fetchLedgerPage(
+                            request.from, request.to, Backend::CachePage::MAX_PAGE_BYTES, seq, yield);
+
+                    if (page)
+                        return connection->sendBinary(Backend::CachePage::serialize(*page, seq));
+
+                    if (range and range->minSequence > seq)
+                        return connection->sendBinary("Ledger no longer stored", boost::beast::http::status::conflict);
+
+                    connection->sendBinary("Ledger not stored yet", boost::beast::http::status::service_unavailable);
+                },
+                connection->clientIp,
+                Backend::CachePage::TARGET))
+        {
+            rpcEngine_->notifyTooBusy();
+            connection->sendBinary("Too busy", boost::beast::http::status::service_unavailable);
+        }
+    }
+
+    /**
+     * @brief Serve a ledger committed by this node to a read-only node (see clio::detail::LedgerFeed)
+     *
+     * Only admin and the peers listed in ledger_feed.allowed_peers may read the feed; everyone else gets 403.
+     *
+     * A ledger that is not committed yet is waited for up to LedgerFeed::MAX_WAIT, after which 204 is answered so that
+     * the read-only node asks again; the request is woken as soon as a ledger is committed. A ledger that is older than
+     * the ones kept in the feed is answered with 404; the read-only node then reads it from the database instead.
+     */
+    void
+    serveLedgerFeed(std::string_view target, std::shared_ptr<Server::ConnectionBase> const& connection)
+    {
+        if (not isAllowedPeer(ledgerFeedPeers_, connection->clientIp))
+            return connection->sendBinary("Forbidden", boost::beast::http::status::forbidden);
+
+        auto const sequence = clio::detail::LedgerFeed::parseTarget(target);
+        if (!sequence)
+            return connection->sendBinary("Malformed ledger feed request", boost::beast::http::status::bad_request);
+
+        if (!rpcEngine_->post(
+                [sequence = *sequence, connection, this](boost::asio::yield_context yield) {
+                    auto const deadline = std::chrono::steady_clock::now() + clio::detail::LedgerFeed::MAX_WAIT;
+                    while (true)
+                    {
+                        if (auto ledger = etl_->getCommittedLedger(sequence); ledger)
+                            return connection->sendBinary(std::move(ledger));
+
+                        auto const latest = etl_->getLatestCommittedLedger();
+                        if (!latest or *latest >= sequence)
+                            return connection->sendBinary("Ledger not in feed", boost::beast::http::status::not_found);
+
+                        if (std::chrono::steady_clock::now() >= deadline)
+                            return connection->sendBinary("", boost::beast::http::status::no_content);
+
+                        etl_->waitForCommittedLedger(sequence, deadline, yield);
+                    }
+                },
+                connection->clientIp,
+                clio::detail::LedgerFeed::TARGET))
+        {
+            rpcEngine_->notifyTooBusy();
+            connection->sendBinary("Too busy", boost::beast::http::status::service_unavailable);
+        }
+    }
+
+    bool
+    isAllowedPeer(std::unordered_set<std::string> const& peers, std::string const& ip) const
+    {
+        return adminVerifier_.isAdmin(ip) or peers.contains(ip);
+    }
+
+    static std::unordered_set<std::string>
+    getAllowedPeers(clio::Config const& config, std::string const& key)
+    {
+        std::unordered_set<std::string> peers;
+        for (auto const& elem : config.arrayOr(key, {}))
+            peers.insert(elem.value<std::string>());
+        return peers;
+    }
+
     void
     handleRequest(
         boost::asio::yield_context& yc,
@@ -181,55 +375,89 @@ private:
             auto us = std::chrono::duration<int, std::milli>(timeDiff);
             RPC::logDuration(*context, us);
 
-            boost::json::object response;
+            // the response is written field by field so that the result is serialized once, in place
+            Server::detail::ResponseWriter writer;
             if (auto const status = std::get_if<RPC::Status>(&v))
             {
                 // note: error statuses are counted/notified in buildResponse itself
-                response = Server::detail::ErrorHelper(connection, request).composeError(*status);
-                auto const responseStr = boost::json::serialize(response);
+                auto const error = Server::detail::ErrorHelper(connection, request).composeError(*status);
+                auto const responseStr = boost::json::serialize(error);
 
                 perfLog_.debug() << context->tag() << "Encountered error: " << responseStr;
                 log_.debug() << context->tag() << "Encountered error: " << responseStr;
+
+                writer.fields(error);
             }
             else
             {
                 // This can still technically be an error. Clio counts forwarded requests as successful.
                 rpcEngine_->notifyComplete(context->method, us);
 
-                auto& result = std::get<boost::json::object>(v);
-                auto const isForwarded = result.contains("forwarded") && result.at("forwarded").is_bool() &&
-                    result.at("forwarded").as_bool();
+                auto const id = request.contains("id") ? request.at("id") : nullptr;
+                auto hasError = false;
 
-                // if the result is forwarded - just use it as is
-                // if forwarded request has error, for http, error should be in "result"; for ws, error should be at top
-                if (isForwarded && (result.contains("result") || connection->upgraded))
+                if (auto const cached = std::get_if<RPC::SerializedResult>(&v))
                 {
-                    for (auto const& [k, v] : result)
-                        response.insert_or_assign(k, v);
+                    // cached results are never forwarded and have no status of their own, so they are written as is
+                    if (connection->upgraded)
+                        writer.rawField("result", *cached->json);
+                    else
+                        writer.rawField("result", *cached->json, "status", "success");
                 }
                 else
                 {
-                    response["result"] = result;
+                    auto& result = std::get<boost::json::object>(v);
+                    auto const isForwarded = result.contains("forwarded") && result.at("forwarded").is_bool() &&
+                        result.at("forwarded").as_bool();
+
+                    // if the result is forwarded - just use it as is
+                    // if forwarded request has error, for http, error should be in "result"; for ws, error should be
+                    // at top
+                    auto const onTop = isForwarded && (result.contains("result") || connection->upgraded);
+
+                    // for ws there is an additional field "status" in the response,
+                    // otherwise the "status" is in the "result" field
+                    if (!connection->upgraded)
+                    {
+                        auto* body = onTop ? result["result"].if_object() : &result;
+                        if (body != nullptr && !body->contains("error"))
+                            (*body)["status"] = "success";
+                    }
+
+                    hasError = onTop && result.contains("error");
+
+                    if (onTop)
+                    {
+                        // fields written below take precedence over the ones of the forwarded response
+                        result.erase("warnings");
+                        if (connection->upgraded)
+                        {
+                            if (not id.is_null())
+                                result.erase("id");
+
+                            if (!hasError)
+                                result.erase("status");
+
+                            result.erase("type");
+                        }
+
+                        writer.fields(result);
+                    }
+                    else
+                    {
+                        writer.field("result", result);
+                    }
                 }
 
-                // for ws there is an additional field "status" in the response,
-                // otherwise the "status" is in the "result" field
                 if (connection->upgraded)
                 {
-                    auto const id = request.contains("id") ? request.at("id") : nullptr;
-
                     if (not id.is_null())
-                        response["id"] = id;
+                        writer.field("id", id);
 
-                    if (!response.contains("error"))
-                        response["status"] = "success";
+                    if (!hasError)
+                        writer.field("status", "success");
 
-                    response["type"] = "response";
-                }
-                else
-                {
-                    if (response.contains("result") && !response["result"].as_object().contains("error"))
-                        response["result"].as_object()["status"] = "success";
+                    writer.field("type", "response");
                 }
             }
 
@@ -239,8 +467,8 @@ private:
             if (etl_->lastCloseAgeSeconds() >= 60)
                 warnings.emplace_back(RPC::makeWarning(RPC::warnRPC_OUTDATED));
 
-            response["warnings"] = warnings;
-            connection->send(boost::json::serialize(response));
+            writer.field("warnings", warnings);
+            connection->send(std::move(writer).finish());
         }
         catch (std::exception const& ex)
         {
@@ -46,6 +46,7 @@ class Detector : public std::enable_shared_from_this<Detector<PlainSession, SslS
     std::optional<std::reference_wrapper<boost::asio::ssl::context>> ctx_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::reference_wrapper<clio::DOSGuard> const dosGuard_;
+    std::shared_ptr<WsCompression> const compression_;
     std::shared_ptr<Handler> const handler_;
     boost::beast::flat_buffer buffer_;
 
@@ -56,12 +57,14 @@ public:
         std::optional<std::reference_wrapper<boost::asio::ssl::context>> ctx,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler)
         : ioc_(ioc)
         , stream_(std::move(socket))
         , ctx_(ctx)
         , tagFactory_(std::cref(tagFactory))
         , dosGuard_(dosGuard)
+        , compression_(std::move(compression))
         , handler_(handler)
     {
     }
@@ -106,13 +109,13 @@ public:
                 return fail(ec, "ssl not supported by this server");
             // Launch SSL session
             std::make_shared<SslSession<Handler>>(
-                stream_.release_socket(), ip, *ctx_, tagFactory_, dosGuard_, handler_, std::move(buffer_))
+                stream_.release_socket(), ip, *ctx_, tagFactory_, dosGuard_, compression_, handler_, std::move(buffer_))
                 ->run();
             return;
         }
         // Launch plain session
         std::make_shared<PlainSession<Handler>>(
-            stream_.release_socket(), ip, tagFactory_, dosGuard_, handler_, std::move(buffer_))
+            stream_.release_socket(), ip, tagFactory_, dosGuard_, compression_, handler_, std::move(buffer_))
             ->run();
     }
 };
@@ -134,6 +137,7 @@ class Server : public std::enable_shared_from_this<Server<PlainSession, SslSessi
     std::optional<std::reference_wrapper<boost::asio::ssl::context>> const ctx_;
     util::TagDecoratorFactory const tagFactory_;
     std::reference_wrapper<clio::DOSGuard> const dosGuard_;
+    std::shared_ptr<WsCompression> const compression_;
     std::shared_ptr<Handler> const handler_;
     tcp::acceptor acceptor_;
 
@@ -144,11 +148,13 @@ public:
         tcp::endpoint endpoint,
         util::TagDecoratorFactory tagFactory,
         clio::DOSGuard& dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& callback)
         : ioc_(std::ref(ioc))
         , ctx_(ctx)
         , tagFactory_(std::move(tagFactory))
         , dosGuard_(std::ref(dosGuard))
+        , compression_(std::move(compression))
         , handler_(callback)
         , acceptor_(boost::asio::make_strand(ioc))
     {
@@ -203,7 +209,7 @@ private:
                 ctx_ ? std::optional<std::reference_wrapper<boost::asio::ssl::context>>{ctx_.value()} : std::nullopt;
             // Create the detector session and run it
             std::make_shared<Detector<PlainSession, SslSession, Handler>>(
-                ioc_, std::move(socket), ctxRef, std::cref(tagFactory_), dosGuard_, handler_)
+                ioc_, std::move(socket), ctxRef, std::cref(tagFactory_), dosGuard_, compression_, handler_)
                 ->run();
         }
 
@@ -246,6 +252,7 @@ make_HttpServer(
         boost::asio::ip::tcp::endpoint{address, port},
         util::TagDecoratorFactory(config),
         dosGuard,
+        std::make_shared<WsCompression>(serverConfig),
         handler);
 
     server->run();
@@ -37,6 +37,7 @@ class SslHttpSession : public HttpBase<SslHttpSession, Handler>,
 {
     boost::beast::ssl_stream<boost::beast::tcp_stream> stream_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
+    std::shared_ptr<WsCompression> compression_;
 
 public:
     explicit SslHttpSession(
@@ -45,11 +46,13 @@ public:
         boost::asio::ssl::context& ctx,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer buffer)
         : HttpBase<SslHttpSession, Handler>(ip, tagFactory, dosGuard, handler, std::move(buffer))
         , stream_(std::move(socket), ctx)
         , tagFactory_(tagFactory)
+        , compression_(std::move(compression))
     {
     }
 
@@ -120,6 +123,7 @@ public:
             this->clientIp,
             tagFactory_,
             this->dosGuard_,
+            compression_,
             this->handler_,
             std::move(this->buffer_),
             std::move(this->req_))
@@ -30,7 +30,7 @@ namespace Server {
 template <ServerHandler Handler>
 class SslWsSession : public WsBase<SslWsSession, Handler>
 {
-    boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>> ws_;
+    boost::beast::websocket::stream<detail::CoalescingStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>> ws_;
 
 public:
     explicit SslWsSession(
@@ -38,13 +38,15 @@ public:
         std::string ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer&& b)
-        : WsBase<SslWsSession, Handler>(ip, tagFactory, dosGuard, handler, std::move(b)), ws_(std::move(stream))
+        : WsBase<SslWsSession, Handler>(ip, tagFactory, dosGuard, std::move(compression), handler, std::move(b))
+        , ws_(std::move(stream))
     {
     }
 
-    boost::beast::websocket::stream<boost::beast::ssl_stream<boost::beast::tcp_stream>>&
+    boost::beast::websocket::stream<detail::CoalescingStream<boost::beast::ssl_stream<boost::beast::tcp_stream>>>&
     ws()
     {
         return ws_;
@@ -63,6 +65,7 @@ class SslWsUpgrader : public std::enable_shared_from_this<SslWsUpgrader<Handler>
     std::string ip_;
     std::reference_wrapper<util::TagDecoratorFactory const> tagFactory_;
     std::reference_wrapper<clio::DOSGuard> dosGuard_;
+    std::shared_ptr<WsCompression> compression_;
     std::shared_ptr<Handler> const handler_;
     http::request<http::string_body> req_;
 
@@ -72,6 +75,7 @@ public:
         std::string ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer&& buf,
         http::request<http::string_body> req)
@@ -80,6 +84,7 @@ public:
         , ip_(ip)
         , tagFactory_(tagFactory)
         , dosGuard_(dosGuard)
+        , compression_(std::move(compression))
         , handler_(handler)
         , req_(std::move(req))
     {
@@ -129,7 +134,7 @@ private:
         boost::beast::get_lowest_layer(https_).expires_never();
 
         std::make_shared<SslWsSession<Handler>>(
-            std::move(https_), ip_, this->tagFactory_, this->dosGuard_, this->handler_, std::move(buffer_))
+            std::move(https_), ip_, tagFactory_, dosGuard_, compression_, handler_, std::move(buffer_))
             ->run(std::move(req_));
     }
 };
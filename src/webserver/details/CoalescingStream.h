@@ -0,0 +1,230 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/async_result.hpp>
+#include <boost/asio/bind_executor.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
+#include <boost/beast/core.hpp>
+#include <boost/beast/websocket/teardown.hpp>
+
+#include <array>
+#include <memory>
+#include <string>
+#include <utility>
+
+namespace Server::detail {
+
+/**
+ * @brief A stream that can hold back a write, so that several small websocket frames reach the next layer with a
+ * single write.
+ *
+ * The write following cork() is appended to an internal buffer and completes right away. The next write that is not
+ * corked sends the buffered bytes together with its own in one gather write. The websocket stream never has more than
+ * one write in flight, which keeps the frames in order.
+ *
+ * A frame built elsewhere, such as a message compressed once for all sessions, is sent by arming substitute() and
+ * writing an empty text message through the websocket stream: its frame is replaced by the substitute. Going through
+ * the websocket stream keeps the frame ordered with the control frames the stream writes on its own.
+ *
+ * @tparam NextLayer The stream to write to, e.g. a tcp or ssl stream
+ */
+template <class NextLayer>
+class CoalescingStream
+{
+    NextLayer next_;
+    boost::beast::flat_buffer pending_;
+    bool corked_ = false;
+    std::shared_ptr<std::string const> substitute_;
+
+public:
+    using executor_type = typename NextLayer::executor_type;
+
+    template <class... Args>
+    explicit CoalescingStream(Args&&... args) : next_(std::forward<Args>(args)...)
+    {
+    }
+
+    executor_type
+    get_executor() noexcept
+    {
+        return next_.get_executor();
+    }
+
+    NextLayer&
+    next_layer() noexcept
+    {
+        return next_;
+    }
+
+    NextLayer const&
+    next_layer() const noexcept
+    {
+        return next_;
+    }
+
+    /**
+     * @brief Hold back the next write until a write that is not corked
+     */
+    void
+    cork()
+    {
+        corked_ = true;
+    }
+
+    /**
+     * @brief Send the given frame in place of the next empty text frame
+     *
+     * @param frame The complete frame, header included
+     */
+    void
+    substitute(std::shared_ptr<std::string const> frame)
+    {
+        substitute_ = std::move(frame);
+    }
+
+    /**
+     * @return The number of bytes held back
+     */
+    std::size_t
+    pendingBytes() const
+    {
+        return pending_.size();
+    }
+
+    template <class MutableBufferSequence, class ReadHandler>
+    auto
+    async_read_some(MutableBufferSequence const& buffers, ReadHandler&& handler)
+    {
+        return next_.async_read_some(buffers, std::forward<ReadHandler>(handler));
+    }
+
+    template <class ConstBufferSequence, class WriteHandler>
+    auto
+    async_write_some(ConstBufferSequence const& buffers, WriteHandler&& handler)
+    {
+        return boost::asio::async_initiate<WriteHandler, void(boost::system::error_code, std::size_t)>(
+            [this](auto&& handler, ConstBufferSequence const& buffers) { initiateWrite(buffers, std::move(handler)); },
+            handler,
+            buffers);
+    }
+
+private:
+    template <class ConstBufferSequence, class WriteHandler>
+    void
+    initiateWrite(ConstBufferSequence const& buffers, WriteHandler&& handler)
+    {
+        auto const size = boost::asio::buffer_size(buffers);
+
+        // control frames written meanwhile by the websocket stream go through untouched
+        if (substitute_ && isEmptyMessage(buffers))
+        {
+            auto frame = std::exchange(substitute_, nullptr);
+            auto const data = boost::asio::buffer(*frame);
+            writeOrHold(data, size, std::move(handler), std::move(frame));
+            return;
+        }
+
+        writeOrHold(buffers, size, std::move(handler), nullptr);
+    }
+
+    /**
+     * @brief Hold back or write the buffers, completing the write with the size the websocket stream asked for
+     */
+    template <class ConstBufferSequence, class WriteHandler>
+    void
+    writeOrHold(
+        ConstBufferSequence const& buffers,
+        std::size_t size,
+        WriteHandler&& handler,
+        std::shared_ptr<std::string const> keepAlive)
+    {
+        if (std::exchange(corked_, false))
+        {
+            auto const bytes = boost::asio::buffer_size(buffers);
+            pending_.commit(boost::asio::buffer_copy(pending_.prepare(bytes), buffers));
+
+            auto completion = boost::beast::bind_front_handler(std::move(handler), boost::system::error_code{}, size);
+            boost::asio::post(next_.get_executor(), std::move(completion));
+            return;
+        }
+
+        if (pending_.size() == 0 && !keepAlive)
+        {
+            next_.async_write_some(buffers, std::move(handler));
+            return;
+        }
+
+        auto const executor = boost::asio::get_associated_executor(handler, next_.get_executor());
+        auto onFlushed = [this, size, keepAlive = std::move(keepAlive), handler = std::move(handler)](
+                             boost::system::error_code ec, std::size_t) mutable {
+            pending_.clear();
+            std::move(handler)(ec, ec ? 0 : size);
+        };
+
+        boost::asio::async_write(
+            next_,
+            boost::beast::buffers_cat(pending_.data(), buffers),
+            boost::asio::bind_executor(executor, std::move(onFlushed)));
+    }
+
+    /**
+     * @brief Whether the buffers hold a whole, short, final text frame
+     *
+     * The websocket stream may have compressed the empty message, so the RSV1 bit and a few bytes of payload are
+     * allowed.
+     */
+    template <class ConstBufferSequence>
+    static bool
+    isEmptyMessage(ConstBufferSequence const& buffers)
+    {
+        static constexpr unsigned char finAndOpcode = 0x8f;
+        static constexpr unsigned char finalText = 0x81;
+        static constexpr std::size_t maxPayload = 8;
+
+        std::array<unsigned char, 2> header{};
+        if (boost::asio::buffer_copy(boost::asio::buffer(header), buffers) != header.size())
+            return false;
+
+        // a server does not mask its frames, the second byte is the payload length
+        auto const length = static_cast<std::size_t>(header[1]);
+        return (header[0] & finAndOpcode) == finalText && length <= maxPayload &&
+            boost::asio::buffer_size(buffers) == header.size() + length;
+    }
+};
+
+template <class NextLayer>
+void
+teardown(boost::beast::role_type role, CoalescingStream<NextLayer>& stream, boost::system::error_code& ec)
+{
+    using boost::beast::websocket::teardown;
+    teardown(role, stream.next_layer(), ec);
+}
+
+template <class NextLayer, class TeardownHandler>
+void
+async_teardown(boost::beast::role_type role, CoalescingStream<NextLayer>& stream, TeardownHandler&& handler)
+{
+    using boost::beast::websocket::async_teardown;
+    async_teardown(role, stream.next_layer(), std::forward<TeardownHandler>(handler));
+}
+
+}  // namespace Server::detail
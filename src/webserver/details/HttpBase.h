@@ -22,6 +22,8 @@
 #include <log/Logger.h>
 #include <main/Build.h>
 #include <webserver/DOSGuard.h>
+#include <webserver/details/ResponseWriter.h>
+#include <webserver/details/SharedStringBody.h>
 #include <webserver/interface/Concepts.h>
 #include <webserver/interface/ConnectionBase.h>
 
@@ -32,6 +34,7 @@
 
 #include <memory>
 #include <string>
+#include <string_view>
 
 namespace Server {
 
@@ -188,6 +191,20 @@ public:
             return derived().upgrade();
         }
 
+        if constexpr (BinaryServingHandler<Handler>)
+        {
+            auto const target = std::string_view{req_.target().data(), req_.target().size()};
+            if (req_.method() == http::verb::get and handler_->isBinaryTarget(target))
+            {
+                if (!dosGuard_.get().request(clientIp))
+                    return sender_(httpResponse(http::status::service_unavailable, "text/plain", "Slow down"));
+
+                log_.info() << tag() << "Received " << target << " request from ip = " << clientIp
+                            << " - posting to WorkQueue";
+                return handler_->serveBinary(target, derived().shared_from_this());
+            }
+        }
+
         if (req_.method() != http::verb::post)
         {
             return sender_(httpResponse(http::status::bad_request, "text/html", "Expected a POST request"));
@@ -230,18 +247,33 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size()))
         {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array())
-                jsonResponse["warnings"].as_array().push_back(RPC::makeWarning(RPC::warnRPC_RATE_LIMIT));
-            else
-                jsonResponse["warnings"] = boost::json::array{RPC::makeWarning(RPC::warnRPC_RATE_LIMIT)};
-            // reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
+            detail::addLoadWarning(msg);
         }
         sender_(httpResponse(status, "application/json", std::move(msg)));
     }
 
+    /**
+     * @brief Send binary data to the client
+     * The data length is added to the DOSGuard like for JSON responses; once the limit is reached the next requests of
+     * the client are refused
+     */
+    void
+    sendBinary(std::string&& data, http::status status = http::status::ok) override
+    {
+        dosGuard_.get().add(clientIp, data.size());
+        sender_(httpResponse(status, "application/octet-stream", std::move(data)));
+    }
+
+    /**
+     * @brief Send binary data shared with others to the client; the data is written as is, without a copy
+     */
+    void
+    sendBinary(std::shared_ptr<std::string const> data, http::status status = http::status::ok) override
+    {
+        dosGuard_.get().add(clientIp, detail::SharedStringBody::size(data));
+        sender_(httpResponse<detail::SharedStringBody>(status, "application/octet-stream", std::move(data)));
+    }
+
     void
     onWrite(bool close, boost::beast::error_code ec, std::size_t bytes_transferred)
     {
@@ -262,10 +294,11 @@ public:
     }
 
 private:
-    http::response<http::string_body>
-    httpResponse(http::status status, std::string content_type, std::string message) const
+    template <typename Body = http::string_body>
+    http::response<Body>
+    httpResponse(http::status status, std::string content_type, typename Body::value_type message) const
     {
-        http::response<http::string_body> res{status, req_.version()};
+        http::response<Body> res{status, req_.version()};
         res.set(http::field::server, "clio-server-" + Build::getClioVersionString());
         res.set(http::field::content_type, content_type);
         res.keep_alive(req_.keep_alive());
@@ -0,0 +1,162 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <boost/asio/ip/address.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <string_view>
+
+namespace clio::detail {
+
+/**
+ * @brief Binary form of a client ip address; IPv4 addresses are stored IPv4-mapped so both forms are the same client
+ */
+using ClientKey = std::array<unsigned char, 16>;
+
+/**
+ * @brief Parse the ip address of a client into its key
+ *
+ * Strings that are not ip addresses are only expected from tests; they are hashed into a key of their own.
+ */
+inline ClientKey
+makeClientKey(std::string_view ip) noexcept
+{
+    namespace ip_ns = boost::asio::ip;
+
+    boost::system::error_code ec;
+    auto const address = ip_ns::make_address(ip, ec);
+    if (!ec)
+    {
+        if (address.is_v4())
+            return ip_ns::make_address_v6(ip_ns::v4_mapped, address.to_v4()).to_bytes();
+        return address.to_v6().to_bytes();
+    }
+
+    ClientKey key{};
+    auto const hash = std::hash<std::string_view>{}(ip);
+    key[0] = 0xff;  // a multicast prefix, never the address of a client
+    std::memcpy(key.data() + key.size() - sizeof(hash), &hash, sizeof(hash));
+    return key;
+}
+
+struct ClientKeyHash
+{
+    std::size_t
+    operator()(ClientKey const& key) const noexcept
+    {
+        std::uint64_t high = 0;
+        std::uint64_t low = 0;
+        std::memcpy(&high, key.data(), sizeof(high));
+        std::memcpy(&low, key.data() + sizeof(high), sizeof(low));
+
+        auto const mixed = (high * 0x9e3779b97f4a7c15ull) ^ (low * 0xc2b2ae3d27d4eb4full);
+        return static_cast<std::size_t>(mixed ^ (mixed >> 29));
+    }
+};
+
+/**
+ * @brief The rate at which a kind of token buckets refill: capacity tokens per interval
+ *
+ * Time is measured in ticks, the time it takes to refill one token, so buckets only deal in integers.
+ */
+class RefillRate
+{
+    std::uint64_t capacity_;
+    std::uint64_t intervalNs_;
+
+public:
+    RefillRate(std::uint64_t capacity, std::chrono::nanoseconds interval)
+        : capacity_{capacity}, intervalNs_{static_cast<std::uint64_t>(std::max<std::int64_t>(interval.count(), 1))}
+    {
+    }
+
+    [[nodiscard]] std::uint64_t
+    capacity() const noexcept
+    {
+        return capacity_;
+    }
+
+    /**
+     * @return Ticks elapsed since the limiter started
+     */
+    [[nodiscard]] std::int64_t
+    ticks(std::chrono::nanoseconds sinceStart) const noexcept
+    {
+        auto const ns = static_cast<unsigned __int128>(std::max<std::int64_t>(sinceStart.count(), 0));
+        return static_cast<std::int64_t>(ns * capacity_ / intervalNs_);
+    }
+};
+
+/**
+ * @brief A token bucket that refills continuously and is updated without locks
+ *
+ * Rather than a count of tokens that would need refilling, the bucket stores the tick at which it will be full again;
+ * the tokens in use are the ticks left until then. Consuming tokens pushes that tick further; the bucket may go into
+ * debt, which is how a client that is over its limit stays blocked until it has earned the tokens back.
+ */
+class TokenBucket
+{
+    std::atomic_int64_t fullAt_ = 0;
+
+public:
+    /**
+     * @brief Consume tokens, even if the bucket is already empty
+     *
+     * @param tokens The number of tokens to take
+     * @param now The current tick
+     * @return The tokens in use afterwards
+     */
+    std::uint64_t
+    consume(std::uint64_t tokens, std::int64_t now) noexcept
+    {
+        auto fullAt = fullAt_.load(std::memory_order_relaxed);
+        std::int64_t next = 0;
+        do
+        {
+            next = std::max(fullAt, now) + static_cast<std::int64_t>(tokens);
+        } while (!fullAt_.compare_exchange_weak(fullAt, next, std::memory_order_relaxed));
+
+        return static_cast<std::uint64_t>(next - now);
+    }
+
+    /**
+     * @return The tokens in use at the given tick
+     */
+    [[nodiscard]] std::uint64_t
+    used(std::int64_t now) const noexcept
+    {
+        return static_cast<std::uint64_t>(std::max<std::int64_t>(fullAt_.load(std::memory_order_relaxed) - now, 0));
+    }
+
+    void
+    reset() noexcept
+    {
+        fullAt_.store(0, std::memory_order_relaxed);
+    }
+};
+
+}  // namespace clio::detail
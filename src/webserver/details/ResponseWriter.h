@@ -0,0 +1,189 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <rpc/Errors.h>
+#include <util/JsonWriter.h>
+
+#include <boost/json.hpp>
+
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace Server::detail {
+
+/**
+ * @brief Writes the response to a request as a JSON object, field by field, into a single string
+ *
+ * Each value is serialized directly into the output in chunks, so that a large result is neither copied into an
+ * envelope object nor first serialized into a string of its own.
+ */
+class ResponseWriter
+{
+    util::JsonWriter writer_;
+
+public:
+    ResponseWriter()
+    {
+        writer_.startObject();
+    }
+
+    template <typename T>
+    requires std::is_same_v<T, boost::json::value> || std::is_same_v<T, boost::json::object> ||
+        std::is_same_v<T, boost::json::array>
+    ResponseWriter&
+    field(std::string_view key, T const& value)
+    {
+        writer_.field(key, value);
+        return *this;
+    }
+
+    ResponseWriter&
+    field(std::string_view key, std::string_view value)
+    {
+        writer_.field(key, value);
+        return *this;
+    }
+
+    /**
+     * @brief Write a value that is serialized already, such as a cached result, as it is
+     */
+    ResponseWriter&
+    rawField(std::string_view key, std::string_view json)
+    {
+        writer_.key(key).raw(json);
+        return *this;
+    }
+
+    /**
+     * @brief Write an object that is serialized already with one more string field added at its end
+     */
+    ResponseWriter&
+    rawField(std::string_view key, std::string_view object, std::string_view extraKey, std::string_view extraValue)
+    {
+        writer_.key(key).reopenObject(object).field(extraKey, extraValue).endObject();
+        return *this;
+    }
+
+    /**
+     * @brief Write all the fields of an object as fields of the response
+     */
+    ResponseWriter&
+    fields(boost::json::object const& object)
+    {
+        for (auto const& [key, value] : object)
+            field(std::string_view{key.data(), key.size()}, value);
+
+        return *this;
+    }
+
+    /**
+     * @return The serialized response
+     */
+    std::string
+    finish() &&
+    {
+        writer_.endObject();
+        return std::move(writer_).finish();
+    }
+};
+
+/**
+ * @brief Mark a serialized response as sent under load and add the rate limit warning to it
+ *
+ * A response written by ResponseWriter ends with its warnings, so the warning is appended without parsing the
+ * response. Anything else is parsed and serialized again.
+ *
+ * @param msg The response
+ */
+inline void
+addLoadWarning(std::string& msg)
+{
+    static constexpr std::string_view WARNINGS = "\"warnings\":[";
+
+    auto const rateLimitWarning = RPC::makeWarning(RPC::warnRPC_RATE_LIMIT);
+
+    // the warnings must be the last field of the top-level object, and nothing may set "warning" already
+    auto const warningsEnd = [&msg]() -> std::size_t {
+        if (!msg.ends_with("]}") || msg.find("\"warning\":") != std::string::npos)
+            return std::string::npos;
+
+        auto const start = msg.rfind(WARNINGS);
+        if (start == std::string::npos || start == 0 || (msg[start - 1] != ',' && msg[start - 1] != '{'))
+            return std::string::npos;
+
+        auto depth = 1;
+        auto inString = false;
+        auto escaped = false;
+        auto pos = start + WARNINGS.size();
+        for (; pos < msg.size() && depth > 0; ++pos)
+        {
+            auto const c = msg[pos];
+            if (inString)
+            {
+                if (escaped)
+                    escaped = false;
+                else if (c == '\\')
+                    escaped = true;
+                else if (c == '"')
+                    inString = false;
+            }
+            else if (c == '"')
+            {
+                inString = true;
+            }
+            else if (c == '[' || c == '{')
+            {
+                ++depth;
+            }
+            else if (c == ']' || c == '}')
+            {
+                --depth;
+            }
+        }
+
+        // the array must close right before the end of the response
+        return depth == 0 && pos == msg.size() - 1 ? pos - 1 : std::string::npos;
+    }();
+
+    if (warningsEnd == std::string::npos)
+    {
+        auto jsonResponse = boost::json::parse(msg).as_object();
+        jsonResponse["warning"] = "load";
+
+        if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array())
+            jsonResponse["warnings"].as_array().push_back(rateLimitWarning);
+        else
+            jsonResponse["warnings"] = boost::json::array{rateLimitWarning};
+
+        msg = boost::json::serialize(jsonResponse);
+        return;
+    }
+
+    msg.resize(warningsEnd);
+    if (msg.back() != '[')
+        msg += ',';
+
+    msg += boost::json::serialize(rateLimitWarning);
+    msg += "],\"warning\":\"load\"}";
+}
+
+}  // namespace Server::detail
@@ -22,12 +22,17 @@
 #include <log/Logger.h>
 #include <rpc/common/Types.h>
 #include <webserver/DOSGuard.h>
+#include <webserver/details/CoalescingStream.h>
+#include <webserver/details/ResponseWriter.h>
+#include <webserver/details/WsCompression.h>
 #include <webserver/interface/Concepts.h>
 #include <webserver/interface/ConnectionBase.h>
 
 #include <boost/beast/core.hpp>
 #include <boost/beast/websocket.hpp>
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
 #include <memory>
 
@@ -38,7 +43,13 @@ namespace Server {
  * write operations.
  * The write operation is via a queue, each write operation of this session will be sent in order.
  * The write operation also supports shared_ptr of string, so the caller can keep the string alive until it is sent. It
- * is useful when we have multiple sessions sending the same content
+ * is useful when we have multiple sessions sending the same content.
+ * When more messages are waiting, small ones are held back by the CoalescingStream so that a burst of frames is written
+ * to the socket at once.
+ * If compression is enabled and the client negotiates permessage-deflate, messages published to streams are sent as
+ * frames compressed once for all sessions by WsCompression.
+ * The queue is bounded by the dos guard's SendQueueLimits; a client that does not read fast enough either loses
+ * messages or is disconnected, according to the configured policy.
  * @tparam Derived The derived class
  * @tparam Handler The handler type, will be called when a request is received.
  */
@@ -49,8 +60,22 @@ class WsBase : public ConnectionBase, public std::enable_shared_from_this<WsBase
 
     boost::beast::flat_buffer buffer_;
     std::reference_wrapper<clio::DOSGuard> dosGuard_;
+    std::shared_ptr<WsCompression> compression_;
+    bool sharedFrames_ = false;  // the client reads the frames compressed once for all sessions
     bool sending_ = false;
-    std::queue<std::shared_ptr<std::string>> messages_;
+    bool corked_ = false;  // the message being written is held back until the next one is written
+
+    struct QueuedMessage
+    {
+        std::shared_ptr<std::string> message;
+        bool isStream;  // published to a stream, as opposed to a response to a request
+    };
+
+    // max bytes of frames held back to be written together
+    static constexpr std::size_t MAX_COALESCED_BYTES = 64 * 1024;
+
+    std::deque<QueuedMessage> messages_;
+    std::size_t queuedBytes_ = 0;
     std::shared_ptr<Handler> const handler_;
 
 protected:
@@ -74,9 +99,14 @@ public:
         std::string ip,
         std::reference_wrapper<util::TagDecoratorFactory const> tagFactory,
         std::reference_wrapper<clio::DOSGuard> dosGuard,
+        std::shared_ptr<WsCompression> compression,
         std::shared_ptr<Handler> const& handler,
         boost::beast::flat_buffer&& buffer)
-        : ConnectionBase(tagFactory, ip), buffer_(std::move(buffer)), dosGuard_(dosGuard), handler_(handler)
+        : ConnectionBase(tagFactory, ip)
+        , buffer_(std::move(buffer))
+        , dosGuard_(dosGuard)
+        , compression_(std::move(compression))
+        , handler_(handler)
     {
         upgraded = true;
         perfLog_.debug() << tag() << "session created";
@@ -98,8 +128,30 @@ public:
     doWrite()
     {
         sending_ = true;
+
+        // another message is waiting: hold this one back so that both go out with the same write
+        auto& stream = derived().ws().next_layer();
+        corked_ =
+            messages_.size() > 1 && stream.pendingBytes() + messages_.front().message->size() < MAX_COALESCED_BYTES;
+        if (corked_)
+            stream.cork();
+
+        auto const& message = *messages_.front().message;
+        if (sharedFrames_ && messages_.front().isStream)
+        {
+            if (auto frame = compression_->frameFor(messages_.front().message); frame)
+            {
+                // the websocket stream writes an empty message, which the shared frame replaces
+                stream.substitute(std::move(frame));
+                derived().ws().async_write(
+                    boost::asio::const_buffer{},
+                    boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this()));
+                return;
+            }
+        }
+
         derived().ws().async_write(
-            boost::asio::buffer(messages_.front()->data(), messages_.front()->size()),
+            boost::asio::buffer(message.data(), message.size()),
             boost::beast::bind_front_handler(&WsBase::onWrite, derived().shared_from_this()));
     }
 
@@ -112,8 +164,10 @@ public:
         }
         else
         {
-            messages_.pop();
+            queuedBytes_ -= messages_.front().message->size();
+            messages_.pop_front();
             sending_ = false;
+            corked_ = false;
             maybeSendNext();
         }
     }
@@ -135,10 +189,24 @@ public:
      */
     void
     send(std::shared_ptr<std::string> msg) override
+    {
+        enqueue(std::move(msg), true);
+    }
+
+    /**
+     * @brief Send several messages to the client, queued together so that no other message comes in between
+     * @param msgs The messages to send
+     * Be aware that the message lengths will not be added to the DOSGuard from this function.
+     */
+    void
+    sendMessages(std::vector<std::shared_ptr<std::string>> msgs) override
     {
         boost::asio::dispatch(
-            derived().ws().get_executor(), [this, self = derived().shared_from_this(), msg = std::move(msg)]() {
-                messages_.push(std::move(msg));
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), msgs = std::move(msgs)]() mutable {
+                for (auto& msg : msgs)
+                    push(std::move(msg), true);
+
                 maybeSendNext();
             });
     }
@@ -154,19 +222,113 @@ public:
     {
         if (!dosGuard_.get().add(clientIp, msg.size()))
         {
-            auto jsonResponse = boost::json::parse(msg).as_object();
-            jsonResponse["warning"] = "load";
+            detail::addLoadWarning(msg);
+        }
+        auto sharedMsg = std::make_shared<std::string>(std::move(msg));
+        enqueue(std::move(sharedMsg), false);
+    }
+
+    /**
+     * @brief Queue a message to be sent, applying the slow consumer policy if the queue is over its limits
+     * @param msg The message to send
+     * @param isStream Whether the message is published to a stream, as opposed to a response to a request
+     */
+    void
+    enqueue(std::shared_ptr<std::string> msg, bool isStream)
+    {
+        boost::asio::dispatch(
+            derived().ws().get_executor(),
+            [this, self = derived().shared_from_this(), msg = std::move(msg), isStream]() mutable {
+                push(std::move(msg), isStream);
+                maybeSendNext();
+            });
+    }
+
+    /**
+     * @brief Add a message to the queue, applying the slow consumer policy; runs on the executor of the stream
+     * @param msg The message to send
+     * @param isStream Whether the message is published to a stream, as opposed to a response to a request
+     */
+    void
+    push(std::shared_ptr<std::string> msg, bool isStream)
+    {
+        if (ec_)
+            return;
+
+        queuedBytes_ += msg->size();
+        messages_.push_back({std::move(msg), isStream});
+        enforceQueueLimits();
+    }
+
+    /**
+     * @brief Drop queued messages or disconnect, depending on the policy, while the queue is over its limits
+     * @return false if the client was disconnected
+     */
+    bool
+    enforceQueueLimits()
+    {
+        auto const& limits = dosGuard_.get().sendQueueLimits();
+        if (!limits.isExceeded(messages_.size(), queuedBytes_))
+            return true;
+
+        if (limits.policy == clio::SendQueueLimits::Policy::Disconnect)
+        {
+            disconnectSlowConsumer();
+            return false;
+        }
 
-            if (jsonResponse.contains("warnings") && jsonResponse["warnings"].is_array())
-                jsonResponse["warnings"].as_array().push_back(RPC::makeWarning(RPC::warnRPC_RATE_LIMIT));
-            else
-                jsonResponse["warnings"] = boost::json::array{RPC::makeWarning(RPC::warnRPC_RATE_LIMIT)};
+        // the message at the front is being written while sending_ is set, so it can not be dropped; neither can the
+        // next one if the front is corked, as the bytes held back are only written with it
+        std::size_t dropped = 0;
+        auto const kept = std::min<std::size_t>(sending_ ? (corked_ ? 2 : 1) : 0, messages_.size());
+        auto it = std::next(messages_.begin(), kept);
+        while (it != messages_.end() && limits.isExceeded(messages_.size(), queuedBytes_))
+        {
+            if (limits.policy == clio::SendQueueLimits::Policy::DropStream && !it->isStream)
+            {
+                ++it;
+                continue;
+            }
 
-            // reserialize when we need to include this warning
-            msg = boost::json::serialize(jsonResponse);
+            queuedBytes_ -= it->message->size();
+            it = messages_.erase(it);
+            ++dropped;
         }
-        auto sharedMsg = std::make_shared<std::string>(std::move(msg));
-        send(std::move(sharedMsg));
+
+        if (dropped > 0)
+        {
+            perfLog_.warn() << tag() << "Dropped " << dropped << " messages for slow client. ip = " << clientIp;
+            if constexpr (SlowConsumerAwareHandler<Handler>)
+                handler_->onMessagesDropped(dropped);
+        }
+
+        return true;
+    }
+
+    /**
+     * @brief Close the connection of a client that does not keep up, telling it why
+     */
+    void
+    disconnectSlowConsumer()
+    {
+        perfLog_.warn() << tag() << "Disconnecting slow client. ip = " << clientIp
+                        << " queued messages = " << messages_.size() << " queued bytes = " << queuedBytes_;
+        if constexpr (SlowConsumerAwareHandler<Handler>)
+            handler_->onSlowConsumerDisconnected();
+
+        // nothing is sent anymore; the message being written, if any, must live until the write completes
+        ec_ = boost::asio::error::no_buffer_space;
+        while (messages_.size() > (sending_ ? 1u : 0u))
+        {
+            queuedBytes_ -= messages_.back().message->size();
+            messages_.pop_back();
+        }
+
+        (*handler_)(ec_, derived().shared_from_this());
+
+        derived().ws().async_close(
+            boost::beast::websocket::close_reason{boost::beast::websocket::close_code::policy_error, "slow consumer"},
+            [self = derived().shared_from_this()](boost::beast::error_code) {});
     }
 
     /**
@@ -179,9 +341,20 @@ public:
 
         derived().ws().set_option(websocket::stream_base::timeout::suggested(role_type::server));
 
-        // Set a decorator to change the Server of the handshake
-        derived().ws().set_option(websocket::stream_base::decorator([](websocket::response_type& res) {
+        if (compression_->isEnabled())
+        {
+            // every message is compressed on its own, so that frames can be shared between sessions
+            websocket::permessage_deflate pmd;
+            pmd.server_enable = true;
+            pmd.server_no_context_takeover = true;
+            derived().ws().set_option(pmd);
+        }
+
+        // Set a decorator to change the Server of the handshake; it also sees the negotiated extensions
+        derived().ws().set_option(websocket::stream_base::decorator([this](websocket::response_type& res) {
             res.set(http::field::server, std::string(BOOST_BEAST_VERSION_STRING) + " websocket-server-async");
+            auto const extensions = res[http::field::sec_websocket_extensions];
+            sharedFrames_ = WsCompression::canShareFrames({extensions.data(), extensions.size()});
         }));
 
         derived().ws().async_accept(req, bind_front_handler(&WsBase::onAccept, this->shared_from_this()));
@@ -235,7 +408,7 @@ public:
                 e["request"] = std::move(requestStr);
             }
 
-            this->send(std::make_shared<std::string>(boost::json::serialize(e)));
+            enqueue(std::make_shared<std::string>(boost::json::serialize(e)), false);
         };
 
         std::string requestStr{static_cast<char const*>(buffer_.data().data()), buffer_.size()};
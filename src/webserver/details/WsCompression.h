@@ -0,0 +1,200 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#pragma once
+
+#include <config/Config.h>
+
+#include <boost/beast/zlib/deflate_stream.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace Server {
+
+/**
+ * @brief Opt-in permessage-deflate for websocket sessions, compressing each broadcast message once for all sessions
+ *
+ * Sessions that negotiate the extension do it with server_no_context_takeover. Every message is then compressed on
+ * its own, so the deflated frame of a message published to a stream can be built once and written as is to every
+ * subscriber that negotiated compatible parameters. Responses to requests are compressed by each session.
+ */
+class WsCompression
+{
+    static constexpr std::size_t SWEEP_THRESHOLD = 1024;
+    static constexpr int MAX_WINDOW_BITS = 15;
+
+    struct SharedFrame
+    {
+        std::once_flag compressed;
+        std::shared_ptr<std::string const> frame;
+    };
+
+    struct Entry
+    {
+        std::weak_ptr<std::string> message;
+        std::shared_ptr<SharedFrame> frame;
+    };
+
+    bool enabled_ = false;
+
+    std::mutex mtx_;
+    std::unordered_map<std::string const*, Entry> frames_;
+    std::size_t sweepAt_ = SWEEP_THRESHOLD;
+
+public:
+    WsCompression() = default;
+
+    /**
+     * @brief Read the settings from the server section of the config
+     *
+     * @param serverConfig The server section
+     */
+    explicit WsCompression(clio::Config const& serverConfig) : enabled_(serverConfig.valueOr("ws_compression", false))
+    {
+    }
+
+    /**
+     * @return true if sessions should offer permessage-deflate
+     */
+    bool
+    isEnabled() const
+    {
+        return enabled_;
+    }
+
+    /**
+     * @brief Find out from the Sec-WebSocket-Extensions header of the handshake response whether the client can read
+     * the frames built by frameFor
+     *
+     * @param extensions The value of the header
+     * @return true if the shared frames can be sent to the client
+     */
+    static bool
+    canShareFrames(std::string_view extensions)
+    {
+        if (extensions.find("permessage-deflate") == std::string_view::npos ||
+            extensions.find("server_no_context_takeover") == std::string_view::npos)
+            return false;
+
+        // shared frames are compressed with the largest window; a client asking for a smaller one can not read them
+        static constexpr std::string_view windowBits = "server_max_window_bits";
+        auto const pos = extensions.find(windowBits);
+        if (pos == std::string_view::npos)
+            return true;
+
+        return extensions.substr(pos + windowBits.size()).starts_with("=" + std::to_string(MAX_WINDOW_BITS));
+    }
+
+    /**
+     * @brief Get the deflated frame of a message, compressing it if no other session did yet
+     *
+     * @param message The message published to a stream
+     * @return The whole frame, header included; nullptr if it could not be compressed
+     */
+    std::shared_ptr<std::string const>
+    frameFor(std::shared_ptr<std::string> const& message)
+    {
+        std::shared_ptr<SharedFrame> shared;
+        {
+            std::scoped_lock const lck{mtx_};
+            auto& entry = frames_[message.get()];
+
+            // the address may belong to a message that is gone
+            if (!entry.frame || entry.message.owner_before(message) || message.owner_before(entry.message))
+                entry = Entry{message, std::make_shared<SharedFrame>()};
+
+            shared = entry.frame;
+            if (frames_.size() >= sweepAt_)
+            {
+                std::erase_if(frames_, [](auto const& item) { return item.second.message.expired(); });
+                sweepAt_ = std::max(SWEEP_THRESHOLD, 2 * frames_.size());
+            }
+        }
+
+        std::call_once(shared->compressed, [&] { shared->frame = makeFrame(*message); });
+        return shared->frame;
+    }
+
+    /**
+     * @brief Build a final, compressed text frame as sent by a server with no context takeover
+     *
+     * @param payload The message to compress
+     * @return The frame; nullptr if compression failed
+     */
+    static std::shared_ptr<std::string const>
+    makeFrame(std::string_view payload)
+    {
+        namespace zlib = boost::beast::zlib;
+
+        thread_local zlib::deflate_stream deflater;
+        deflater.reset();
+
+        static constexpr std::size_t maxHeaderSize = 10;
+        static constexpr std::size_t flushMargin = 16;
+        std::string frame(maxHeaderSize + deflater.upper_bound(payload.size()) + flushMargin, '\0');
+
+        zlib::z_params zs;
+        zs.next_in = payload.data();
+        zs.avail_in = payload.size();
+        zs.next_out = frame.data() + maxHeaderSize;
+        zs.avail_out = frame.size() - maxHeaderSize;
+
+        boost::beast::error_code ec;
+        deflater.write(zs, zlib::Flush::sync, ec);
+        if (ec || zs.avail_in != 0 || zs.avail_out == 0)
+            return nullptr;
+
+        // the sync flush ends with an empty block that the receiver appends by itself
+        static constexpr std::string_view tail{"\x00\x00\xff\xff", 4};
+        auto size = zs.total_out;
+        if (std::string_view{frame.data() + maxHeaderSize, size}.ends_with(tail))
+            size -= tail.size();
+
+        // FIN, RSV1 (compressed) and the text opcode, followed by the unmasked payload length
+        std::string header{'\xc1'};
+        if (size < 126)
+        {
+            header.push_back(static_cast<char>(size));
+        }
+        else if (size <= 0xffff)
+        {
+            header.push_back(static_cast<char>(126));
+            for (auto shift : {8, 0})
+                header.push_back(static_cast<char>((size >> shift) & 0xff));
+        }
+        else
+        {
+            header.push_back(static_cast<char>(127));
+            for (auto shift : {56, 48, 40, 32, 24, 16, 8, 0})
+                header.push_back(static_cast<char>((static_cast<std::uint64_t>(size) >> shift) & 0xff));
+        }
+
+        auto const begin = maxHeaderSize - header.size();
+        frame.replace(begin, header.size(), header);
+        return std::make_shared<std::string const>(frame.substr(begin, header.size() + size));
+    }
+};
+
+}  // namespace Server
@@ -23,7 +23,9 @@
 
 #include <boost/beast.hpp>
 
+#include <concepts>
 #include <memory>
+#include <string_view>
 
 namespace Server {
 
@@ -40,4 +42,30 @@ concept ServerHandler = requires(T handler, std::string const& req, std::shared_
 };
 // clang-format on
 
+/**
+ * @brief Handlers that can also serve binary data to other Clio nodes, such as pages of the ledger cache
+ */
+// clang-format off
+template <typename T>
+concept BinaryServingHandler = ServerHandler<T> && requires(T handler, std::string_view target, std::shared_ptr<ConnectionBase> const& ws) {
+    // whether a GET request for the target is served by the handler
+    { handler.isBinaryTarget(target) } -> std::same_as<bool>;
+    // the callback when server receives a GET request for such a target
+    { handler.serveBinary(target, ws) };
+};
+// clang-format on
+
+/**
+ * @brief Handlers that are told about websocket clients that can not keep up with the messages sent to them
+ */
+// clang-format off
+template <typename T>
+concept SlowConsumerAwareHandler = ServerHandler<T> && requires(T handler, std::size_t count) {
+    // the callback when messages queued for a client are dropped
+    { handler.onMessagesDropped(count) };
+    // the callback when a client is disconnected
+    { handler.onSlowConsumerDisconnected() };
+};
+// clang-format on
+
 }  // namespace Server
@@ -23,6 +23,10 @@
 
 #include <boost/beast/http.hpp>
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace Server {
 
 namespace http = boost::beast::http;
@@ -61,6 +65,39 @@ public:
         throw std::runtime_error("web server can not send the shared payload");
     }
 
+    /**
+     * @brief Send several messages published to streams, in order, with one call
+     * @param msgs The messages to send
+     */
+    virtual void
+    sendMessages(std::vector<std::shared_ptr<std::string>> msgs)
+    {
+        for (auto& msg : msgs)
+            send(std::move(msg));
+    }
+
+    /**
+     * @brief Send binary data that is not a JSON response, such as a page of the ledger cache
+     * @param data The data to send
+     * @param status The HTTP status
+     */
+    virtual void
+    sendBinary(std::string&& data, http::status status = http::status::ok)
+    {
+        throw std::runtime_error("web server can not send binary data");
+    }
+
+    /**
+     * @brief Send binary data that is shared with others, such as a ledger of the ledger feed, without copying it
+     * @param data The data to send
+     * @param status The HTTP status
+     */
+    virtual void
+    sendBinary(std::shared_ptr<std::string const> data, http::status status = http::status::ok)
+    {
+        throw std::runtime_error("web server can not send shared binary data");
+    }
+
     /**
      * @brief Indicates whether the connection had an error and is considered
      * dead
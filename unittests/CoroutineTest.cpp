@@ -0,0 +1,108 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+
+#include <util/Coroutine.h>
+#include <util/WorkCost.h>
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+using namespace util;
+
+class CoroutineTest : public SyncAsioContextTest
+{
+};
+
+TEST_F(CoroutineTest, AwaitStackfulReturnsResult)
+{
+    auto const cost = std::make_shared<WorkCost>();
+    runSpawn([&](auto& yield) {
+        WorkCost::Scope const scope{cost};
+        auto const result = runAwaitable(yield, []() -> boost::asio::awaitable<int> {
+            WorkCost::recordReads(1);
+            co_return co_await awaitStackful([](boost::asio::yield_context&) {
+                WorkCost::recordReads(2);
+                return 42;
+            });
+        }());
+
+        EXPECT_EQ(result, 42);
+    });
+
+    EXPECT_EQ(cost->reads(), 3);
+}
+
+TEST_F(CoroutineTest, AwaitStackfulRethrows)
+{
+    runSpawn([](auto& yield) {
+        auto const awaitThrowing = []() -> boost::asio::awaitable<int> {
+            co_return co_await awaitStackful([](boost::asio::yield_context&) -> int {
+                throw std::runtime_error{"stackful"};
+            });
+        };
+
+        EXPECT_THROW(runAwaitable(yield, awaitThrowing()), std::runtime_error);
+    });
+}
+
+TEST_F(CoroutineTest, RunAwaitableRethrows)
+{
+    runSpawn([](auto& yield) {
+        auto const throwing = []() -> boost::asio::awaitable<int> {
+            throw std::runtime_error{"awaitable"};
+            co_return 0;
+        };
+
+        EXPECT_THROW(runAwaitable(yield, throwing()), std::runtime_error);
+    });
+}
+
+TEST_F(CoroutineTest, OtherWorkRunsWhileSuspended)
+{
+    auto order = std::vector<int>{};
+    runSpawn([&](auto& yield) {
+        boost::asio::post(ctx, [&] { order.push_back(1); });
+
+        runAwaitable(yield, [&]() -> boost::asio::awaitable<bool> {
+            co_await awaitStackful([&](boost::asio::yield_context& yield) {
+                boost::asio::post(yield);  // let the posted handler run
+                order.push_back(2);
+                return true;
+            });
+            co_return true;
+        }());
+        order.push_back(3);
+    });
+
+    EXPECT_EQ(order, (std::vector<int>{1, 2, 3}));
+}
+
+TEST_F(CoroutineTest, YieldIsUsableAfterRunAwaitable)
+{
+    runSpawn([](auto& yield) {
+        auto const answer = [](int value) -> boost::asio::awaitable<int> { co_return value; };
+
+        EXPECT_EQ(runAwaitable(yield, answer(1)), 1);
+        EXPECT_EQ(runAwaitable(yield, answer(2)), 2);
+        boost::asio::post(yield);
+    });
+}
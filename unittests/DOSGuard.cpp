@@ -20,11 +20,17 @@
 #include <util/Fixtures.h>
 
 #include <config/Config.h>
+#include <util/WorkCost.h>
 #include <webserver/DOSGuard.h>
 
 #include <boost/json/parse.hpp>
 #include <gmock/gmock.h>
 
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <vector>
+
 using namespace testing;
 using namespace clio;
 using namespace std;
@@ -38,17 +44,11 @@ constexpr static auto JSONData = R"JSON(
             "sweep_interval": 1,
             "max_connections": 2,
             "max_requests": 3,
-            "whitelist": ["127.0.0.1"]
-        }
-    }
-)JSON";
-
-constexpr static auto JSONData2 = R"JSON(
-    {
-        "dos_guard": {
-            "max_fetches": 100,
-            "sweep_interval": 0.1,
-            "max_connections": 2,
+            "max_cost": 10,
+            "cost": {
+                "read": 2,
+                "cache_miss": 1
+            },
             "whitelist": ["127.0.0.1"]
         }
     }
@@ -56,23 +56,20 @@ constexpr static auto JSONData2 = R"JSON(
 
 constexpr static auto IP = "127.0.0.2";
 
-class FakeSweepHandler
+struct FakeClock
 {
-private:
-    using guard_type = BasicDOSGuard<FakeSweepHandler>;
-    guard_type* dosGuard_;
+    using duration = std::chrono::nanoseconds;
+    using rep = duration::rep;
+    using period = duration::period;
+    using time_point = std::chrono::time_point<FakeClock>;
+    static constexpr bool is_steady = true;
 
-public:
-    void
-    setup(guard_type* guard)
-    {
-        dosGuard_ = guard;
-    }
+    static inline time_point current{};
 
-    void
-    sweep()
+    static time_point
+    now() noexcept
     {
-        dosGuard_->clear();
+        return current;
     }
 };
 };  // namespace
@@ -81,8 +78,7 @@ class DOSGuardTest : public NoLoggerFixture
 {
 protected:
     Config cfg{json::parse(JSONData)};
-    FakeSweepHandler sweepHandler;
-    BasicDOSGuard<FakeSweepHandler> guard{cfg, sweepHandler};
+    BasicDOSGuard<FakeClock> guard{cfg};
 };
 
 TEST_F(DOSGuardTest, Whitelisting)
@@ -116,15 +112,65 @@ TEST_F(DOSGuardTest, FetchCount)
     EXPECT_TRUE(guard.isOk(IP));  // can fetch again
 }
 
-TEST_F(DOSGuardTest, ClearFetchCountOnTimer)
+TEST_F(DOSGuardTest, FetchCountRefillsOverTime)
 {
     EXPECT_TRUE(guard.add(IP, 50));  // half of allowence
     EXPECT_TRUE(guard.add(IP, 50));  // now fully charged
     EXPECT_FALSE(guard.add(IP, 1));  // can't add even 1 anymore
     EXPECT_FALSE(guard.isOk(IP));
 
-    sweepHandler.sweep();         // pretend sweep called from timer
-    EXPECT_TRUE(guard.isOk(IP));  // can fetch again
+    FakeClock::current += std::chrono::milliseconds{10};  // one percent of the interval refills one byte
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_FALSE(guard.add(IP, 2));
+
+    FakeClock::current += std::chrono::milliseconds{500};
+    EXPECT_TRUE(guard.add(IP, 48));
+    EXPECT_FALSE(guard.add(IP, 1));
+}
+
+TEST_F(DOSGuardTest, WorkCostLimit)
+{
+    auto const cost = std::make_shared<util::WorkCost>();
+    {
+        util::WorkCost::Scope const scope{cost};
+        util::WorkCost::recordReads(3);
+        util::WorkCost::recordCacheMisses(2);
+    }
+
+    EXPECT_TRUE(guard.addCost(IP, *cost));   // 3 reads and 2 misses are 8 points
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_FALSE(guard.addCost(IP, *cost));  // 16 points
+    EXPECT_FALSE(guard.isOk(IP));
+    EXPECT_TRUE(guard.addCost("127.0.0.1", *cost));
+
+    guard.clear();
+    EXPECT_TRUE(guard.isOk(IP));
+}
+
+TEST_F(DOSGuardTest, WorkCostWeightsChargeSubMillisecondCpuTime)
+{
+    auto const weights = WorkCostWeights::fromConfig(cfg);
+    EXPECT_EQ(weights.millipoints(0, 0, std::chrono::microseconds{900}), 900u);
+    EXPECT_EQ(weights.millipoints(3, 2, std::chrono::microseconds{1500}), 9'500u);
+}
+
+TEST_F(DOSGuardTest, WorkCostLimitCountsSubMillisecondCpuTime)
+{
+    auto const cost = std::make_shared<util::WorkCost>();
+    while (cost->cpuTime() < std::chrono::microseconds{100})
+    {
+        util::WorkCost::Scope const scope{cost};
+        auto const until = std::chrono::steady_clock::now() + std::chrono::microseconds{50};
+        while (std::chrono::steady_clock::now() < until)
+            ;
+    }
+
+    // each request costs a fraction of a point, yet enough of them exceed the limit of 10 points
+    auto const requests = std::chrono::nanoseconds{std::chrono::milliseconds{10}} / cost->cpuTime() + 1;
+    for (auto i = 0; i < requests; ++i)
+        guard.addCost(IP, *cost);
+
+    EXPECT_FALSE(guard.isOk(IP));
 }
 
 TEST_F(DOSGuardTest, RequestLimit)
@@ -139,7 +185,7 @@ TEST_F(DOSGuardTest, RequestLimit)
     EXPECT_TRUE(guard.isOk(IP));  // can request again
 }
 
-TEST_F(DOSGuardTest, RequestLimitOnTimer)
+TEST_F(DOSGuardTest, RequestLimitRefillsOverTime)
 {
     EXPECT_TRUE(guard.request(IP));
     EXPECT_TRUE(guard.request(IP));
@@ -147,31 +193,47 @@ TEST_F(DOSGuardTest, RequestLimitOnTimer)
     EXPECT_TRUE(guard.isOk(IP));
     EXPECT_FALSE(guard.request(IP));
     EXPECT_FALSE(guard.isOk(IP));
-    sweepHandler.sweep();
-    EXPECT_TRUE(guard.isOk(IP));  // can request again
+
+    FakeClock::current += std::chrono::milliseconds{334};  // a third of the interval refills one request
+    EXPECT_TRUE(guard.isOk(IP));
+    EXPECT_FALSE(guard.request(IP));
+
+    FakeClock::current += std::chrono::seconds{2};  // a full bucket holds no more than max_requests
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_FALSE(guard.request(IP));
 }
 
-template <typename SweepHandler>
-struct BasicDOSGuardMock : public BaseDOSGuard
+TEST_F(DOSGuardTest, MappedAddressIsSameClient)
 {
-    BasicDOSGuardMock(SweepHandler& handler)
-    {
-        handler.setup(this);
-    }
+    EXPECT_TRUE(guard.isWhiteListed("::ffff:127.0.0.1"));
 
-    MOCK_METHOD(void, clear, (), (noexcept, override));
-};
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_TRUE(guard.request("::ffff:127.0.0.2"));
+    EXPECT_TRUE(guard.request(IP));
+    EXPECT_FALSE(guard.request("::ffff:127.0.0.2"));
+    EXPECT_FALSE(guard.isOk(IP));
+    EXPECT_TRUE(guard.isOk("127.0.0.3"));
+}
 
-class DOSGuardIntervalSweepHandlerTest : public SyncAsioContextTest
+TEST_F(DOSGuardTest, ConcurrentRequestsConsumeEachToken)
 {
-protected:
-    Config cfg{json::parse(JSONData2)};
-    IntervalSweepHandler sweepHandler{cfg, ctx};
-    BasicDOSGuardMock<IntervalSweepHandler> guard{sweepHandler};
-};
+    std::atomic_uint32_t allowed = 0;
+    std::vector<std::thread> threads;
+    for (auto i = 0; i < 8; ++i)
+    {
+        threads.emplace_back([&] {
+            for (auto j = 0; j < 100; ++j)
+            {
+                if (guard.request(IP))
+                    ++allowed;
+            }
+        });
+    }
 
-TEST_F(DOSGuardIntervalSweepHandlerTest, SweepAfterInterval)
-{
-    EXPECT_CALL(guard, clear()).Times(AtLeast(2));
-    ctx.run_for(std::chrono::milliseconds(400));
+    for (auto& thread : threads)
+        thread.join();
+
+    EXPECT_EQ(allowed, 3);
 }
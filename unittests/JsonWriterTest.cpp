@@ -0,0 +1,79 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+
+#include <util/JsonWriter.h>
+
+#include <boost/json.hpp>
+#include <gtest/gtest.h>
+
+#include <string>
+
+TEST(JsonWriter, SeparatesFieldsAndValues)
+{
+    util::JsonWriter writer;
+    writer.startObject()
+        .field("string", "a \"quoted\" value")
+        .field("number", 42u)
+        .field("flag", true)
+        .key("array")
+        .startArray()
+        .value(1)
+        .startObject()
+        .endObject()
+        .value(boost::json::value{nullptr})
+        .endArray()
+        .field("object", boost::json::object{{"inner", -1}})
+        .endObject();
+
+    EXPECT_EQ(
+        std::move(writer).finish(),
+        R"({"string":"a \"quoted\" value","number":42,"flag":true,"array":[1,{},null],"object":{"inner":-1}})");
+}
+
+TEST(JsonWriter, LargeValuesAreWrittenWhole)
+{
+    boost::json::array array;
+    for (auto i = 0; i < 10000; ++i)
+        array.emplace_back(boost::json::object{{"index", i}, {"text", std::string(16, 'x')}});
+
+    util::JsonWriter writer;
+    writer.startArray().value(array).value(array).endArray();
+
+    EXPECT_EQ(std::move(writer).finish(), boost::json::serialize(boost::json::array{array, array}));
+}
+
+TEST(JsonWriter, RawAndReopenedObjects)
+{
+    util::JsonWriter writer;
+    writer.startObject()
+        .key("result")
+        .raw(R"({"a":1})")
+        .key("full")
+        .reopenObject(R"({"b":2})")
+        .field("c", 3)
+        .endObject()
+        .key("empty")
+        .reopenObject("{}")
+        .field("d", 4)
+        .endObject()
+        .endObject();
+
+    EXPECT_EQ(std::move(writer).finish(), R"({"result":{"a":1},"full":{"b":2,"c":3},"empty":{"d":4}})");
+}
@@ -102,6 +102,32 @@ protected:
     }
 };
 
+/*
+ * test account subscriptions spread across shards are counted and cleaned up
+ */
+TEST(SubscriptionManagerTest, ShardedAccountSubscriptions)
+{
+    clio::Config cfg{json::parse(R"({"subscription_workers": 4, "subscription_shards": 8})")};
+    util::TagDecoratorFactory tagDecoratorFactory{cfg};
+    auto backend = std::make_shared<MockBackend>(cfg);
+    auto subManager = SubscriptionManager::make_SubscriptionManager(cfg, backend);
+    std::shared_ptr<Server::ConnectionBase> session = std::make_shared<MockSession>(tagDecoratorFactory);
+
+    for (auto i = 1u; i <= 20u; ++i)
+        subManager->subAccount(ripple::AccountID{i}, session);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(subManager->report()["account"], 20);
+
+    for (auto i = 1u; i <= 10u; ++i)
+        subManager->unsubAccount(ripple::AccountID{i}, session);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(subManager->report()["account"], 10);
+
+    subManager->cleanup(session);
+    std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(subManager->report()["account"], 0);
+}
+
 /*
  * test report function and unsub functions
  */
@@ -425,6 +451,150 @@ TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerTransaction)
     CheckSubscriberMessage(TransactionPublish, session);
 }
 
+/*
+ * test filtered transactions subscribers only receive matching transactions
+ */
+TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerTransactionFiltered)
+{
+    std::shared_ptr<Server::ConnectionBase> sessionPayment = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> sessionOffer = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> sessionLarge = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> sessionFailed = std::make_shared<MockSession>(tagDecoratorFactory);
+    subManagerPtr->subTransactions(
+        sessionPayment,
+        TransactionFilter{.types = {ripple::ttPAYMENT}, .results = {ripple::TERtoInt(ripple::tesSUCCESS)}});
+    subManagerPtr->subTransactions(sessionOffer, TransactionFilter{.types = {ripple::ttOFFER_CREATE}});
+    subManagerPtr->subTransactions(sessionLarge, TransactionFilter{.minXrpDrops = 2});
+    subManagerPtr->subTransactions(sessionFailed, TransactionFilter{.results = {ripple::TERtoInt(ripple::tecNO_DST)}});
+    EXPECT_EQ(subManagerPtr->report()["transactions"], 4);
+
+    auto trans1 = TransactionAndMetadata();
+    ripple::STObject obj = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, 32);
+    trans1.transaction = obj.getSerializer().peekData();
+    trans1.ledgerSequence = 32;
+    ripple::STArray metaArray{0};
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, metaArray);
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+    trans1.metadata = metaObj.getSerializer().peekData();
+    subManagerPtr->pubTransaction(trans1, CreateLedgerInfo(LEDGERHASH2, 33));
+
+    auto const rawPayment = static_cast<MockSession*>(sessionPayment.get());
+    auto retry = 10;
+    while (rawPayment->message.empty() && retry-- != 0)
+        std::this_thread::sleep_for(20ms);
+    ASSERT_FALSE(rawPayment->message.empty());
+    EXPECT_EQ(json::parse(rawPayment->message).at("transaction").at("TransactionType"), "Payment");
+    EXPECT_TRUE(static_cast<MockSession*>(sessionOffer.get())->message.empty());
+    EXPECT_TRUE(static_cast<MockSession*>(sessionLarge.get())->message.empty());
+    EXPECT_TRUE(static_cast<MockSession*>(sessionFailed.get())->message.empty());
+
+    // subscribing again replaces the filter instead of adding a second subscription
+    subManagerPtr->subTransactions(sessionOffer, TransactionFilter{.types = {ripple::ttPAYMENT}});
+    EXPECT_EQ(subManagerPtr->report()["transactions"], 4);
+    subManagerPtr->unsubTransactions(sessionOffer);
+    subManagerPtr->cleanup(sessionLarge);
+    EXPECT_EQ(subManagerPtr->report()["transactions"], 2);
+}
+
+/*
+ * test a session replaying from a ledger gets the missed transactions, then the live ones, each once
+ */
+TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerReplayTransactions)
+{
+    auto const subManager = std::make_shared<SubscriptionManager>(1, mockBackendPtr, 1, 2);
+
+    auto const publish = [&](std::uint32_t seq) {
+        auto trans = TransactionAndMetadata();
+        trans.transaction = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, seq).getSerializer().peekData();
+        trans.ledgerSequence = seq;
+        ripple::STObject metaObj(ripple::sfTransactionMetaData);
+        metaObj.setFieldArray(ripple::sfAffectedNodes, ripple::STArray{0});
+        metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+        metaObj.setFieldU32(ripple::sfTransactionIndex, 0);
+        trans.metadata = metaObj.getSerializer().peekData();
+        subManager->pubTransaction(trans, CreateLedgerInfo(LEDGERHASH2, seq));
+    };
+
+    for (auto seq = 33u; seq < 36u; ++seq)
+        publish(seq);
+
+    auto const& message = static_cast<MockSession*>(session.get())->message;
+    auto const countOf = [&](std::uint32_t seq) {
+        auto const needle = "\"ledger_index\":" + std::to_string(seq);
+        auto count = 0;
+        for (auto pos = message.find(needle); pos != std::string::npos; pos = message.find(needle, pos + 1))
+            ++count;
+        return count;
+    };
+
+    auto const request = ReplayRequest{.transactions = TransactionFilter{}};
+    boost::asio::io_context ctx;
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        // the messages of ledger 33 are no longer kept
+        EXPECT_FALSE(subManager->subReplay(yield, session, 33, request));
+        EXPECT_TRUE(message.empty());
+
+        auto const response = subManager->subReplay(yield, session, 34, request);
+        ASSERT_TRUE(response);
+        EXPECT_TRUE(response->empty());
+    });
+    ctx.run();
+
+    EXPECT_EQ(countOf(33), 0);
+    EXPECT_EQ(countOf(34), 1);
+    EXPECT_EQ(countOf(35), 1);
+    EXPECT_LT(message.find("\"ledger_index\":34"), message.find("\"ledger_index\":35"));
+
+    publish(36);
+    auto retry = 10;
+    while (countOf(36) == 0 && retry-- != 0)
+        std::this_thread::sleep_for(20ms);
+    EXPECT_EQ(countOf(35), 1);
+    EXPECT_EQ(countOf(36), 1);
+    EXPECT_EQ(subManager->report()["transactions"], 1);
+}
+
+/*
+ * test transactions of a ledger rendered in parallel are published in order
+ */
+TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerTransactionsInOrder)
+{
+    auto const subManager = std::make_shared<SubscriptionManager>(4, mockBackendPtr);
+    subManager->subTransactions(session);
+    std::this_thread::sleep_for(20ms);
+
+    auto ledgerinfo = CreateLedgerInfo(LEDGERHASH2, 33);
+
+    std::vector<TransactionAndMetadata> transactions;
+    for (auto seq = 10u; seq < 30u; ++seq)
+    {
+        auto& trans = transactions.emplace_back();
+        trans.transaction = CreatePaymentTransactionObject(ACCOUNT1, ACCOUNT2, 1, 1, seq).getSerializer().peekData();
+        trans.ledgerSequence = 32;
+        ripple::STObject metaObj(ripple::sfTransactionMetaData);
+        metaObj.setFieldArray(ripple::sfAffectedNodes, ripple::STArray{0});
+        metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+        metaObj.setFieldU32(ripple::sfTransactionIndex, seq);
+        trans.metadata = metaObj.getSerializer().peekData();
+    }
+    subManager->pubTransactions(transactions, ledgerinfo);
+
+    auto sessionPtr = static_cast<MockSession*>(session.get());
+    for (auto retry = 10; retry > 0 and sessionPtr->message.find(R"("Sequence":29)") == std::string::npos; --retry)
+        std::this_thread::sleep_for(20ms);
+
+    std::size_t previous = 0;
+    for (auto seq = 10u; seq < 30u; ++seq)
+    {
+        auto const pos = sessionPtr->message.find(R"("Sequence":)" + std::to_string(seq));
+        ASSERT_NE(pos, std::string::npos) << seq;
+        EXPECT_GE(pos, previous) << seq;
+        previous = pos;
+    }
+}
+
 /*
  * test transaction for offer creation
  * check owner_funds
@@ -493,6 +663,53 @@ TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerTransactionOffer
     CheckSubscriberMessage(TransactionForOwnerFund, session);
 }
 
+/*
+ * test owner_funds is fetched once per account and issue for the offers of a ledger
+ */
+TEST_F(SubscriptionManagerSimpleBackendTest, SubscriptionManagerTransactionsOwnerFundsFetchedOnce)
+{
+    subManagerPtr->subTransactions(session);
+
+    auto ledgerinfo = CreateLedgerInfo(LEDGERHASH2, 33);
+    std::vector<TransactionAndMetadata> transactions;
+    for (auto seq : {32u, 33u})
+    {
+        auto& trans = transactions.emplace_back();
+        trans.transaction =
+            CreateCreateOfferTransactionObject(ACCOUNT1, 1, seq, CURRENCY, ISSUER, 1, 3).getSerializer().peekData();
+        trans.ledgerSequence = 32;
+        ripple::STObject metaObj(ripple::sfTransactionMetaData);
+        metaObj.setFieldArray(ripple::sfAffectedNodes, ripple::STArray{0});
+        metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+        metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+        trans.metadata = metaObj.getSerializer().peekData();
+    }
+
+    ripple::STObject line(ripple::sfIndexes);
+    line.setFieldU16(ripple::sfLedgerEntryType, ripple::ltRIPPLE_STATE);
+    line.setFieldAmount(ripple::sfLowLimit, ripple::STAmount(10, false));
+    line.setFieldAmount(ripple::sfHighLimit, ripple::STAmount(100, false));
+    line.setFieldH256(ripple::sfPreviousTxnID, ripple::uint256{TXNID});
+    line.setFieldU32(ripple::sfPreviousTxnLgrSeq, 3);
+    line.setFieldU32(ripple::sfFlags, 0);
+    auto issue2 = GetIssue(CURRENCY, ISSUER);
+    line.setFieldAmount(ripple::sfBalance, ripple::STAmount(issue2, 100));
+    MockBackend* rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
+    // same reads as for a single offer
+    EXPECT_CALL(*rawBackendPtr, doFetchLedgerObject).Times(3);
+    ON_CALL(*rawBackendPtr, doFetchLedgerObject).WillByDefault(Return(line.getSerializer().peekData()));
+
+    subManagerPtr->pubTransactions(transactions, ledgerinfo);
+
+    auto sessionPtr = static_cast<MockSession*>(session.get());
+    for (auto retry = 10; retry > 0 and sessionPtr->message.find(R"("Sequence":33)") == std::string::npos; --retry)
+        std::this_thread::sleep_for(20ms);
+
+    auto const first = sessionPtr->message.find(R"("owner_funds":"100")");
+    ASSERT_NE(first, std::string::npos);
+    EXPECT_NE(sessionPtr->message.find(R"("owner_funds":"100")", first + 1), std::string::npos);
+}
+
 constexpr static auto TransactionForOwnerFundFrozen = R"({
     "transaction":{
         "Account":"rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn",
@@ -206,3 +206,130 @@ TEST_F(SubscriptionMapTest, SubscriptionMapDeadRemoveSubscriber)
     ctx.run();
     EXPECT_EQ(subMap.count(), 1);
 }
+
+TEST_F(SubscriptionMapTest, SubscriptionMapShardsKeepKeysApart)
+{
+    std::shared_ptr<Server::ConnectionBase> session1 = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> session2 = std::make_shared<MockSession>(tagDecoratorFactory);
+    SubscriptionMap<std::string> subMap(ctx, 4);
+    for (auto i = 0; i < 16; ++i)
+        subMap.subscribe(i % 2 == 0 ? session1 : session2, "topic" + std::to_string(i));
+    ctx.run();
+    EXPECT_EQ(subMap.count(), 16);
+    for (auto i = 0; i < 16; ++i)
+        subMap.publish(std::make_shared<std::string>(std::to_string(i % 2)), "topic" + std::to_string(i));
+    subMap.unsubscribe(session1, "topic0");
+    ctx.restart();
+    ctx.run();
+    EXPECT_EQ(((MockSession*)(session1.get()))->message, std::string(8, '0'));
+    EXPECT_EQ(((MockSession*)(session2.get()))->message, std::string(8, '1'));
+    EXPECT_EQ(subMap.count(), 15);
+}
+
+TEST_F(SubscriptionMapTest, SubscriptionMapPublishToSeveralKeys)
+{
+    std::shared_ptr<Server::ConnectionBase> session1 = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> session2 = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> session3(new MockDeadSession(tagDecoratorFactory));
+    std::shared_ptr<Server::ConnectionBase> session4 = std::make_shared<MockSession>(tagDecoratorFactory);
+    session3->send(std::make_shared<std::string>("kill"));
+    SubscriptionMap<std::string> subMap(ctx, 4);
+    subMap.subscribe(session1, "topic1");
+    subMap.subscribe(session1, "topic2");
+    subMap.subscribe(session2, "topic2");
+    subMap.subscribe(session2, "topic3");
+    subMap.subscribe(session3, "topic1");
+    subMap.subscribe(session4, "topic1");
+    EXPECT_EQ(subMap.count(), 6);
+
+    // session4 already got the message from elsewhere
+    std::unordered_set<SessionPtrType> sent{session4};
+    subMap.publish(std::make_shared<std::string>("message"), {"topic1", "topic2", "no exist"}, sent);
+    ctx.run();
+
+    EXPECT_EQ(static_cast<MockSession*>(session1.get())->message, "message");
+    EXPECT_EQ(static_cast<MockSession*>(session2.get())->message, "message");
+    EXPECT_TRUE(static_cast<MockSession*>(session4.get())->message.empty());
+    EXPECT_TRUE(sent.contains(session1));
+    EXPECT_TRUE(sent.contains(session2));
+
+    // the dead session is unsubscribed
+    EXPECT_EQ(subMap.count(), 5);
+}
+
+// replacing the filter takes effect for the next transaction published, without a gap or a duplicate
+TEST_F(SubscriptionTest, TransactionSubscriptionReplaceFilter)
+{
+    std::shared_ptr<Server::ConnectionBase> session1 = std::make_shared<MockSession>(tagDecoratorFactory);
+    std::shared_ptr<Server::ConnectionBase> session2(new MockDeadSession(tagDecoratorFactory));
+    session2->send(std::make_shared<std::string>("kill"));
+    TransactionSubscription sub(ctx);
+    auto const success = ripple::TERtoInt(ripple::tesSUCCESS);
+    sub.subscribe(session1, TransactionFilter{.types = {ripple::ttPAYMENT}});
+    sub.subscribe(session2, TransactionFilter{});
+    EXPECT_EQ(sub.count(), 2);
+
+    sub.publish(std::make_shared<std::string>("payment"), ripple::ttPAYMENT, success, 1);
+    sub.publish(std::make_shared<std::string>("offer"), ripple::ttOFFER_CREATE, success, {});
+    sub.subscribe(session1, TransactionFilter{});
+    EXPECT_EQ(sub.count(), 2);
+    sub.publish(std::make_shared<std::string>("offer"), ripple::ttOFFER_CREATE, success, {});
+    ctx.run();
+
+    EXPECT_EQ(static_cast<MockSession*>(session1.get())->message, "paymentoffer");
+    // the dead session is unsubscribed
+    EXPECT_EQ(sub.count(), 1);
+    sub.unsubscribe(session1);
+    EXPECT_EQ(sub.count(), 0);
+}
+
+TEST(ReplayBufferTest, KeepsMostRecentLedgers)
+{
+    ReplayBuffer<std::string> buffer{2};
+    EXPECT_FALSE(buffer.covers(10));
+
+    for (auto seq = 10u; seq < 13u; ++seq)
+    {
+        buffer.addLedger(seq, std::make_shared<std::string>("ledger" + std::to_string(seq)));
+        buffer.addTransaction(seq, "tx" + std::to_string(seq));
+    }
+
+    EXPECT_EQ(buffer.size(), 2);
+    EXPECT_FALSE(buffer.covers(10));
+    EXPECT_TRUE(buffer.covers(11));
+    EXPECT_TRUE(buffer.covers(13));
+
+    std::string replayed;
+    buffer.forEachSince(11, [&](auto const& ledger) {
+        replayed += *ledger.message;
+        for (auto const& tx : ledger.transactions)
+            replayed += tx;
+    });
+    EXPECT_EQ(replayed, "ledger11tx11ledger12tx12");
+}
+
+TEST(ReplayBufferTest, TransactionsWithoutLedgerMessage)
+{
+    ReplayBuffer<std::string> buffer{4};
+    buffer.addTransaction(10, "a");
+    buffer.addTransaction(10, "b");
+    buffer.addTransaction(11, "c");
+    buffer.addTransaction(9, "too old");
+
+    std::string replayed;
+    buffer.forEachSince(10, [&](auto const& ledger) {
+        EXPECT_FALSE(ledger.message);
+        for (auto const& tx : ledger.transactions)
+            replayed += tx;
+    });
+    EXPECT_EQ(replayed, "abc");
+}
+
+TEST(ReplayBufferTest, Disabled)
+{
+    ReplayBuffer<std::string> buffer{0};
+    buffer.addLedger(10, std::make_shared<std::string>("ledger"));
+    buffer.addTransaction(10, "tx");
+    EXPECT_EQ(buffer.size(), 0);
+    EXPECT_FALSE(buffer.covers(10));
+}
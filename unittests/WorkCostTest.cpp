@@ -0,0 +1,68 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/WorkCost.h>
+
+#include <gtest/gtest.h>
+
+using namespace util;
+
+TEST(WorkCostTest, NothingRecordedWithoutScope)
+{
+    auto const cost = std::make_shared<WorkCost>();
+    WorkCost::recordReads(3);
+    WorkCost::recordCacheMisses(1);
+
+    EXPECT_EQ(cost->reads(), 0);
+    EXPECT_EQ(cost->cacheMisses(), 0);
+}
+
+TEST(WorkCostTest, RecordsIntoBoundCost)
+{
+    auto const cost = std::make_shared<WorkCost>();
+    {
+        WorkCost::Scope const scope{cost};
+        WorkCost::recordReads(3);
+        WorkCost::recordReads(2);
+        WorkCost::recordCacheMisses(1);
+    }
+    WorkCost::recordReads(10);
+
+    EXPECT_EQ(cost->reads(), 5);
+    EXPECT_EQ(cost->cacheMisses(), 1);
+}
+
+TEST(WorkCostTest, SuspensionUnbindsUntilResumed)
+{
+    auto const cost = std::make_shared<WorkCost>();
+    auto const other = std::make_shared<WorkCost>();
+    {
+        WorkCost::Scope const scope{cost};
+        {
+            WorkCost::Suspension const suspension;
+            // another coroutine runs on this thread meanwhile
+            WorkCost::Scope const otherScope{other};
+            WorkCost::recordReads(7);
+        }
+        WorkCost::recordReads(1);
+    }
+
+    EXPECT_EQ(cost->reads(), 1);
+    EXPECT_EQ(other->reads(), 7);
+}
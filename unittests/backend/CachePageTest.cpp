@@ -0,0 +1,169 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <backend/CachePage.h>
+#include <backend/LedgerCache.h>
+
+#include <gtest/gtest.h>
+
+using namespace Backend;
+
+namespace {
+
+constexpr static auto SEQ = 30;
+constexpr static auto KEY1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto KEY2 = "5B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto KEY3 = "9B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+LedgerPage
+makePage()
+{
+    return {{{ripple::uint256{KEY1}, {1, 2, 3}}, {ripple::uint256{KEY2}, {4, 5}}}, ripple::uint256{KEY3}};
+}
+
+}  // namespace
+
+TEST(BackendCachePageTest, RoundTrip)
+{
+    auto const page = makePage();
+    auto const data = CachePage::serialize(page, SEQ);
+
+    auto const parsed = CachePage::deserialize(data, SEQ);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->objects, page.objects);
+    EXPECT_EQ(parsed->cursor, page.cursor);
+}
+
+TEST(BackendCachePageTest, RoundTripLastPage)
+{
+    auto const parsed = CachePage::deserialize(CachePage::serialize(LedgerPage{}, SEQ), SEQ);
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_TRUE(parsed->objects.empty());
+    EXPECT_FALSE(parsed->cursor.has_value());
+}
+
+TEST(BackendCachePageTest, RejectsCorruptedData)
+{
+    auto data = CachePage::serialize(makePage(), SEQ);
+    data[40] ^= 0x01;
+    EXPECT_FALSE(CachePage::deserialize(data, SEQ).has_value());
+}
+
+TEST(BackendCachePageTest, RejectsTruncatedData)
+{
+    auto const data = CachePage::serialize(makePage(), SEQ);
+    EXPECT_FALSE(CachePage::deserialize(std::string_view{data}.substr(0, data.size() - 1), SEQ).has_value());
+    EXPECT_FALSE(CachePage::deserialize(std::string_view{data}.substr(0, 10), SEQ).has_value());
+}
+
+TEST(BackendCachePageTest, RejectsOtherLedger)
+{
+    EXPECT_FALSE(CachePage::deserialize(CachePage::serialize(makePage(), SEQ), SEQ + 1).has_value());
+}
+
+TEST(BackendCachePageTest, RequestTargetRoundTrip)
+{
+    CachePage::Request const request{SEQ, ripple::uint256{KEY1}, ripple::uint256{KEY2}};
+
+    auto const parsed = CachePage::Request::parse(request.target());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_EQ(parsed->ledgerSequence, request.ledgerSequence);
+    EXPECT_EQ(parsed->from, request.from);
+    EXPECT_EQ(parsed->to, request.to);
+}
+
+TEST(BackendCachePageTest, RequestWithoutUpperBound)
+{
+    auto const parsed = CachePage::Request::parse(CachePage::Request{SEQ, ripple::uint256{KEY1}, {}}.target());
+    ASSERT_TRUE(parsed.has_value());
+    EXPECT_FALSE(parsed->to.has_value());
+}
+
+TEST(BackendCachePageTest, MalformedRequests)
+{
+    EXPECT_FALSE(CachePage::Request::parse("/cache").has_value());
+    EXPECT_FALSE(CachePage::Request::parse("/other?ledger=30&from=00").has_value());
+    EXPECT_FALSE(CachePage::Request::parse(std::string{"/cache?from="} + KEY1).has_value());
+    EXPECT_FALSE(CachePage::Request::parse(std::string{"/cache?ledger=abc&from="} + KEY1).has_value());
+    EXPECT_FALSE(CachePage::Request::parse("/cache?ledger=30&from=XYZ").has_value());
+}
+
+TEST(BackendCachePageTest, LedgerCachePages)
+{
+    LedgerCache cache;
+    cache.update(makePage().objects, SEQ);
+    cache.update({{ripple::uint256{KEY3}, {6}}}, SEQ);
+    EXPECT_FALSE(cache.getPage(firstKey, {}, CachePage::MAX_PAGE_BYTES, SEQ).has_value());
+
+    cache.setFull();
+
+    auto const all = cache.getPage(firstKey, {}, CachePage::MAX_PAGE_BYTES, SEQ);
+    ASSERT_TRUE(all.has_value());
+    EXPECT_EQ(all->objects.size(), 3);
+    EXPECT_FALSE(all->cursor.has_value());
+
+    auto const first = cache.getPage(firstKey, {}, 1, SEQ);
+    ASSERT_TRUE(first.has_value());
+    ASSERT_EQ(first->objects.size(), 1);
+    EXPECT_EQ(first->objects.front().key, ripple::uint256{KEY1});
+    EXPECT_EQ(first->cursor, ripple::uint256{KEY2});
+
+    auto const bounded = cache.getPage(ripple::uint256{KEY2}, ripple::uint256{KEY3}, CachePage::MAX_PAGE_BYTES, SEQ);
+    ASSERT_TRUE(bounded.has_value());
+    ASSERT_EQ(bounded->objects.size(), 1);
+    EXPECT_EQ(bounded->objects.front().key, ripple::uint256{KEY2});
+    EXPECT_FALSE(bounded->cursor.has_value());
+}
+
+TEST(BackendCachePageTest, LedgerCachePagesAreCutBeforeGoingOverTheLimit)
+{
+    LedgerCache cache;
+    cache.update(makePage().objects, SEQ);
+    cache.update({{ripple::uint256{KEY3}, {6}}}, SEQ);
+    cache.setFull();
+
+    auto const twoFrames = CachePage::frameSize(3) + CachePage::frameSize(2);
+    auto const two = cache.getPage(firstKey, {}, twoFrames, SEQ);
+    ASSERT_TRUE(two.has_value());
+    EXPECT_EQ(two->objects.size(), 2);
+    EXPECT_EQ(two->cursor, ripple::uint256{KEY3});
+    EXPECT_EQ(CachePage::serialize(*two, SEQ).size(), twoFrames + CachePage::TRAILER_SIZE);
+
+    auto const one = cache.getPage(firstKey, {}, twoFrames - 1, SEQ);
+    ASSERT_TRUE(one.has_value());
+    EXPECT_EQ(one->objects.size(), 1);
+    EXPECT_EQ(one->cursor, ripple::uint256{KEY2});
+}
+
+TEST(BackendCachePageTest, LedgerCachePagesOnlyForLatestLedger)
+{
+    LedgerCache cache;
+    cache.update(makePage().objects, SEQ);
+    cache.setFull();
+
+    EXPECT_FALSE(cache.getPage(firstKey, {}, CachePage::MAX_PAGE_BYTES, SEQ + 1).has_value());
+
+    cache.update({{ripple::uint256{KEY1}, {7}}}, SEQ + 1);
+    EXPECT_FALSE(cache.getPage(firstKey, {}, CachePage::MAX_PAGE_BYTES, SEQ).has_value());
+
+    auto const page = cache.getPage(firstKey, {}, CachePage::MAX_PAGE_BYTES, SEQ + 1);
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 2);
+    EXPECT_EQ(page->objects.front().blob, Blob{7});
+}
@@ -0,0 +1,73 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <backend/LedgerCache.h>
+
+#include <gtest/gtest.h>
+
+using namespace Backend;
+
+namespace {
+
+constexpr static auto SEQ = 30;
+constexpr static auto KEY1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto KEY2 = "5B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto KEY3 = "9B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+}  // namespace
+
+TEST(BackendLedgerCacheTest, UpdateTakesOwnershipOfBlobs)
+{
+    LedgerCache cache;
+    std::vector<LedgerObject> objects{{ripple::uint256{KEY1}, {1, 2, 3}}};
+    cache.update(std::move(objects), SEQ);
+
+    EXPECT_EQ(cache.get(ripple::uint256{KEY1}, SEQ), (Blob{1, 2, 3}));
+}
+
+TEST(BackendLedgerCacheTest, NeighborsOfExistingAndMissingKeys)
+{
+    LedgerCache cache;
+    cache.update({{ripple::uint256{KEY1}, {1}}, {ripple::uint256{KEY3}, {3}}}, SEQ);
+    cache.setFull();
+
+    auto const neighbors =
+        cache.getNeighbors({ripple::uint256{KEY1}, ripple::uint256{KEY2}, ripple::uint256{KEY3}}, SEQ);
+    ASSERT_EQ(neighbors.size(), 3);
+
+    EXPECT_FALSE(neighbors[0].predecessor.has_value());
+    EXPECT_EQ(neighbors[0].successor, ripple::uint256{KEY3});
+
+    EXPECT_EQ(neighbors[1].predecessor, ripple::uint256{KEY1});
+    EXPECT_EQ(neighbors[1].successor, ripple::uint256{KEY3});
+
+    EXPECT_EQ(neighbors[2].predecessor, ripple::uint256{KEY1});
+    EXPECT_FALSE(neighbors[2].successor.has_value());
+}
+
+TEST(BackendLedgerCacheTest, NoNeighborsUnlessFullAndLatest)
+{
+    LedgerCache cache;
+    cache.update({{ripple::uint256{KEY1}, {1}}}, SEQ);
+    EXPECT_TRUE(cache.getNeighbors({ripple::uint256{KEY2}}, SEQ).empty());
+
+    cache.setFull();
+    EXPECT_TRUE(cache.getNeighbors({ripple::uint256{KEY2}}, SEQ - 1).empty());
+    EXPECT_EQ(cache.getNeighbors({ripple::uint256{KEY2}}, SEQ).size(), 1);
+}
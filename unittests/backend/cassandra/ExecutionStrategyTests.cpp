@@ -22,6 +22,9 @@
 
 #include <backend/cassandra/impl/ExecutionStrategy.h>
 
+#include <boost/asio/co_spawn.hpp>
+#include <boost/asio/detached.hpp>
+
 #include <gtest/gtest.h>
 
 using namespace Backend::Cassandra;
@@ -320,6 +323,171 @@ TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInCoroutineThrowsOnFailure
     ASSERT_TRUE(called);
 }
 
+TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInAwaitableSuccessful)
+{
+    auto handle = MockHandle{};
+    auto strat = DefaultExecutionStrategy{Settings{}, handle};
+
+    ON_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const& statement, auto&& cb) {
+            cb({});  // pretend we got data
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .Times(1);
+
+    auto called = std::atomic_bool{false};
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+
+    boost::asio::co_spawn(
+        ctx,
+        [&work, &called, &strat]() -> boost::asio::awaitable<void> {
+            auto statement = FakeStatement{};
+            co_await strat.read(boost::asio::use_awaitable, statement);
+
+            called = true;
+            work.reset();
+        },
+        boost::asio::detached);
+
+    ctx.run();
+    ASSERT_TRUE(called);
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadOneInAwaitableThrowsOnTimeoutFailure)
+{
+    auto handle = MockHandle{};
+    auto strat = DefaultExecutionStrategy{Settings{}, handle};
+
+    ON_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const&, auto&& cb) {
+            cb({});  // notify that item is ready
+            return FakeFutureWithCallback{
+                FakeResultOrError{CassandraError{"timeout", CASS_ERROR_LIB_REQUEST_TIMED_OUT}}};
+        });
+    EXPECT_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .Times(1);
+
+    auto called = std::atomic_bool{false};
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+
+    boost::asio::co_spawn(
+        ctx,
+        [&work, &called, &strat]() -> boost::asio::awaitable<void> {
+            auto statement = FakeStatement{};
+            EXPECT_THROW(co_await strat.read(boost::asio::use_awaitable, statement), DatabaseTimeout);
+
+            called = true;
+            work.reset();
+        },
+        boost::asio::detached);
+
+    ctx.run();
+    ASSERT_TRUE(called);
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadBatchInAwaitableSuccessful)
+{
+    auto handle = MockHandle{};
+    auto strat = DefaultExecutionStrategy{Settings{}, handle};
+
+    ON_CALL(
+        handle, asyncExecute(An<std::vector<FakeStatement> const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const& statements, auto&& cb) {
+            EXPECT_EQ(statements.size(), 3);
+            cb({});  // pretend we got data
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(
+        handle, asyncExecute(An<std::vector<FakeStatement> const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .Times(1);
+
+    auto called = std::atomic_bool{false};
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+
+    boost::asio::co_spawn(
+        ctx,
+        [&work, &called, &strat]() -> boost::asio::awaitable<void> {
+            auto statements = std::vector<FakeStatement>(3);
+            co_await strat.read(boost::asio::use_awaitable, statements);
+
+            called = true;
+            work.reset();
+        },
+        boost::asio::detached);
+
+    ctx.run();
+    ASSERT_TRUE(called);
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInAwaitableSuccessful)
+{
+    auto handle = MockHandle{};
+    auto strat = DefaultExecutionStrategy{Settings{}, handle};
+
+    ON_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([](auto const&, auto&& cb) {
+            cb({});  // pretend we got data
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .Times(3);  // once per statement
+
+    auto called = std::atomic_bool{false};
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+
+    boost::asio::co_spawn(
+        ctx,
+        [&work, &called, &strat]() -> boost::asio::awaitable<void> {
+            auto statements = std::vector<FakeStatement>(3);
+            auto res = co_await strat.readEach(boost::asio::use_awaitable, statements);
+            EXPECT_EQ(res.size(), statements.size());
+
+            called = true;
+            work.reset();
+        },
+        boost::asio::detached);
+
+    ctx.run();
+    ASSERT_TRUE(called);
+}
+
+TEST_F(BackendCassandraExecutionStrategyTest, ReadEachInAwaitableThrowsOnFailure)
+{
+    auto handle = MockHandle{};
+    auto strat = DefaultExecutionStrategy{Settings{}, handle};
+    auto callCount = std::atomic_int{0};
+
+    ON_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .WillByDefault([&callCount](auto const&, auto&& cb) {
+            if (callCount == 1)  // error happens on one of the entries
+                cb({CassandraError{"invalid data", CASS_ERROR_LIB_INVALID_DATA}});
+            else
+                cb({});  // pretend we got data
+            ++callCount;
+            return FakeFutureWithCallback{};
+        });
+    EXPECT_CALL(handle, asyncExecute(An<FakeStatement const&>(), An<std::function<void(FakeResultOrError)>&&>()))
+        .Times(3);  // once per statement
+
+    auto called = std::atomic_bool{false};
+    auto work = std::optional<boost::asio::io_context::work>{ctx};
+
+    boost::asio::co_spawn(
+        ctx,
+        [&work, &called, &strat]() -> boost::asio::awaitable<void> {
+            auto statements = std::vector<FakeStatement>(3);
+            EXPECT_THROW(co_await strat.readEach(boost::asio::use_awaitable, statements), DatabaseTimeout);
+
+            called = true;
+            work.reset();
+        },
+        boost::asio::detached);
+
+    ctx.run();
+    ASSERT_TRUE(called);
+}
+
 TEST_F(BackendCassandraExecutionStrategyTest, WriteSyncFirstTrySuccessful)
 {
     auto handle = MockHandle{};
@@ -167,3 +167,54 @@ TEST_F(ETLExtractorTest, CallsPipeFinishWithInitialSequenceAtExit)
 
     extractor_ = std::make_unique<ExtractorType>(dataPipe_, networkValidatedLedgers_, ledgerFetcher_, 123, 234, state_);
 }
+
+TEST_F(ETLExtractorTest, FetchesValidatedLedgersAsPipelinedBatch)
+{
+    auto const rawNetworkValidatedLedgersPtr =
+        static_cast<MockNetworkValidatedLedgers*>(networkValidatedLedgers_.get());
+
+    ON_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).WillByDefault(Return(true));
+    ON_CALL(*rawNetworkValidatedLedgersPtr, getMostRecent).WillByDefault(Return(100));
+    ON_CALL(dataPipe_, getStride).WillByDefault(Return(1));
+
+    auto requested = std::vector<uint32_t>{};
+    EXPECT_CALL(ledgerFetcher_, fetchDataAndDiffPipelined(_, 4, _))
+        .Times(1)
+        .WillOnce(Invoke([&requested](auto const& sequences, auto, auto onFetched) {
+            requested = sequences;
+            for (auto const seq : sequences)
+                onFetched(seq, FakeFetchResponse{seq});
+            return sequences.size();
+        }));
+    EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).Times(0);
+    EXPECT_CALL(dataPipe_, push).Times(8);
+    EXPECT_CALL(dataPipe_, finish(0)).Times(1);
+
+    // all of 0..7 are validated already so they are requested as one batch with 4 requests in flight
+    extractor_ = std::make_unique<ExtractorType>(dataPipe_, networkValidatedLedgers_, ledgerFetcher_, 0, 7, state_, 4);
+    extractor_->waitTillFinished();
+
+    EXPECT_EQ(requested, (std::vector<uint32_t>{0, 1, 2, 3, 4, 5, 6, 7}));
+}
+
+TEST_F(ETLExtractorTest, FallsBackToSingleFetchIfPipelinedBatchFails)
+{
+    auto const rawNetworkValidatedLedgersPtr =
+        static_cast<MockNetworkValidatedLedgers*>(networkValidatedLedgers_.get());
+
+    ON_CALL(*rawNetworkValidatedLedgersPtr, waitUntilValidatedByNetwork).WillByDefault(Return(true));
+    ON_CALL(*rawNetworkValidatedLedgersPtr, getMostRecent).WillByDefault(Return(100));
+    ON_CALL(dataPipe_, getStride).WillByDefault(Return(1));
+
+    auto response = FakeFetchResponse{};
+    ON_CALL(ledgerFetcher_, fetchDataAndDiff(_)).WillByDefault(Return(response));
+
+    // the batch for 0..1 fails; 0 and 1 are then fetched one by one. the batch for 1 alone is never requested
+    EXPECT_CALL(ledgerFetcher_, fetchDataAndDiffPipelined).Times(1).WillOnce(Return(0));
+    EXPECT_CALL(ledgerFetcher_, fetchDataAndDiff).Times(2);
+    EXPECT_CALL(dataPipe_, push).Times(2);
+    EXPECT_CALL(dataPipe_, finish(0)).Times(1);
+
+    extractor_ = std::make_unique<ExtractorType>(dataPipe_, networkValidatedLedgers_, ledgerFetcher_, 0, 1, state_, 4);
+    extractor_->waitTillFinished();
+}
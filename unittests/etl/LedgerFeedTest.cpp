@@ -0,0 +1,150 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <etl/impl/LedgerFeed.h>
+#include <util/TestObject.h>
+
+#include <boost/asio/spawn.hpp>
+#include <gtest/gtest.h>
+
+#include <thread>
+
+using namespace clio::detail;
+
+namespace {
+
+constexpr static auto SEQ = 30;
+constexpr static auto LEDGERHASH = "4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652";
+constexpr static auto KEY1 = "1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+constexpr static auto KEY2 = "5B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC";
+
+LedgerBundle
+makeBundle(uint32_t seq)
+{
+    LedgerBundle bundle{CreateLedgerInfo(LEDGERHASH, seq)};
+    bundle.objects = std::vector<Backend::LedgerObject>{
+        {ripple::uint256{KEY1}, {1, 2, 3}},
+        {ripple::uint256{KEY2}, {}},
+    };
+    bundle.transactions = std::vector<Backend::TransactionAndMetadata>{};
+    bundle.transactions->emplace_back(ripple::Blob{4, 5}, ripple::Blob{6}, seq, 0);
+    return bundle;
+}
+
+}  // namespace
+
+TEST(ETLLedgerFeedTest, SerializeRoundTrip)
+{
+    auto const bundle = makeBundle(SEQ);
+    auto const result = LedgerFeed::deserialize(LedgerFeed::serialize(bundle));
+
+    ASSERT_TRUE(result);
+    EXPECT_EQ(result->lgrInfo.seq, SEQ);
+    EXPECT_EQ(result->lgrInfo.hash, bundle.lgrInfo.hash);
+    EXPECT_FALSE(result->fees);
+    ASSERT_TRUE(result->objects);
+    ASSERT_EQ(result->objects->size(), 2);
+    EXPECT_EQ((*result->objects)[0].key, ripple::uint256{KEY1});
+    EXPECT_EQ((*result->objects)[0].blob, (Backend::Blob{1, 2, 3}));
+    EXPECT_TRUE((*result->objects)[1].blob.empty());
+    ASSERT_TRUE(result->transactions);
+    ASSERT_EQ(result->transactions->size(), 1);
+    EXPECT_EQ((*result->transactions)[0].transaction, (ripple::Blob{4, 5}));
+    EXPECT_EQ((*result->transactions)[0].metadata, (ripple::Blob{6}));
+    EXPECT_EQ((*result->transactions)[0].ledgerSequence, SEQ);
+}
+
+TEST(ETLLedgerFeedTest, CorruptedDataIsRejected)
+{
+    auto data = LedgerFeed::serialize(makeBundle(SEQ));
+    data[data.size() / 2] ^= 1;
+    EXPECT_FALSE(LedgerFeed::deserialize(data));
+    EXPECT_FALSE(LedgerFeed::deserialize(data.substr(0, data.size() - 1)));
+    EXPECT_FALSE(LedgerFeed::deserialize(""));
+}
+
+TEST(ETLLedgerFeedTest, KeepsLatestLedgers)
+{
+    LedgerFeed feed{2};
+    for (auto seq = SEQ; seq < SEQ + 3; ++seq)
+        feed.add(makeBundle(seq));
+
+    EXPECT_EQ(feed.latestSequence(), SEQ + 2);
+    EXPECT_FALSE(feed.get(SEQ));
+    ASSERT_TRUE(feed.get(SEQ + 1));
+    EXPECT_EQ(LedgerFeed::deserialize(*feed.get(SEQ + 1))->lgrInfo.seq, SEQ + 1);
+    EXPECT_TRUE(feed.get(SEQ + 2));
+    EXPECT_FALSE(feed.get(SEQ + 3));
+}
+
+TEST(ETLLedgerFeedTest, GapClearsFeed)
+{
+    LedgerFeed feed{4};
+    feed.add(makeBundle(SEQ));
+    feed.add(makeBundle(SEQ + 2));
+
+    EXPECT_FALSE(feed.get(SEQ));
+    EXPECT_TRUE(feed.get(SEQ + 2));
+}
+
+TEST(ETLLedgerFeedTest, IncompleteLedgersAndDisabledFeedAreIgnored)
+{
+    LedgerFeed disabled;
+    disabled.add(makeBundle(SEQ));
+    EXPECT_FALSE(disabled.isEnabled());
+    EXPECT_FALSE(disabled.latestSequence());
+
+    LedgerFeed feed{2};
+    feed.add(LedgerBundle{CreateLedgerInfo(LEDGERHASH, SEQ)});
+    EXPECT_FALSE(feed.latestSequence());
+}
+
+TEST(ETLLedgerFeedTest, Target)
+{
+    EXPECT_EQ(LedgerFeed::parseTarget(LedgerFeed::target(SEQ)), SEQ);
+    EXPECT_FALSE(LedgerFeed::parseTarget("/ledger_feed"));
+    EXPECT_FALSE(LedgerFeed::parseTarget("/ledger_feed?ledger="));
+    EXPECT_FALSE(LedgerFeed::parseTarget("/ledger_feed?ledger=12x"));
+}
+
+TEST(ETLLedgerFeedTest, WaitIsWokenByAdd)
+{
+    LedgerFeed feed{2};
+    feed.add(makeBundle(SEQ));
+
+    boost::asio::io_context ctx;
+    auto const deadline = std::chrono::steady_clock::now() + std::chrono::seconds{10};
+    std::optional<std::chrono::steady_clock::time_point> wokenAt;
+    boost::asio::spawn(ctx, [&](boost::asio::yield_context yield) {
+        // the ledger is already in the feed
+        feed.wait(SEQ, deadline, yield);
+        feed.wait(SEQ + 1, deadline, yield);
+        wokenAt = std::chrono::steady_clock::now();
+    });
+
+    std::thread writer{[&] {
+        std::this_thread::sleep_for(std::chrono::milliseconds{50});
+        feed.add(makeBundle(SEQ + 1));
+    }};
+    ctx.run();
+    writer.join();
+
+    ASSERT_TRUE(wokenAt);
+    EXPECT_LT(*wokenAt, deadline - std::chrono::seconds{5});
+}
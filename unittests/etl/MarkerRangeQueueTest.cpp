@@ -0,0 +1,153 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <etl/impl/MarkerRangeQueue.h>
+
+#include <gtest/gtest.h>
+
+using namespace clio::detail;
+
+TEST(ETLMarkerRangeQueueTest, SplitsKeySpaceIntoRanges)
+{
+    MarkerRangeQueue queue{4};
+
+    for (auto i = 0u; i < 4; ++i)
+    {
+        auto const range = queue.tryPop();
+        ASSERT_NE(range, nullptr);
+        EXPECT_EQ(range->begin, i * 64);
+        EXPECT_EQ(range->end, (i + 1) * 64);
+    }
+}
+
+TEST(ETLMarkerRangeQueueTest, LastRangeCoversRestOfKeySpace)
+{
+    MarkerRangeQueue queue{3};
+
+    queue.tryPop();
+    queue.tryPop();
+    auto const last = queue.tryPop();
+    ASSERT_NE(last, nullptr);
+    EXPECT_EQ(last->begin, 170);
+    EXPECT_EQ(last->end, MarkerRange::KEY_SPACE_END);
+}
+
+TEST(ETLMarkerRangeQueueTest, DoneOnceAllRangesFinished)
+{
+    MarkerRangeQueue queue{2};
+
+    auto const first = queue.tryPop();
+    auto const second = queue.tryPop();
+    EXPECT_FALSE(queue.isDone());
+
+    queue.finish(first, "a");
+    EXPECT_FALSE(queue.isDone());
+    queue.finish(second, "");
+    EXPECT_TRUE(queue.isDone());
+
+    EXPECT_EQ(queue.edgeKeys(), std::vector<std::string>{"a"});
+}
+
+TEST(ETLMarkerRangeQueueTest, IdleSourceStealsUpperHalfOfLargestRange)
+{
+    MarkerRangeQueue queue{2};
+
+    auto const first = queue.tryPop();
+    auto const second = queue.tryPop();
+    first->begin = 100;  // first has made good progress; second has not started
+
+    auto const stolen = queue.tryPop();
+    ASSERT_NE(stolen, nullptr);
+    EXPECT_EQ(stolen->begin, 192);
+    EXPECT_EQ(stolen->end, MarkerRange::KEY_SPACE_END);
+    EXPECT_EQ(second->end, 192);
+    EXPECT_EQ(first->end, 128);
+}
+
+TEST(ETLMarkerRangeQueueTest, SinglePrefixRangeCannotBeStolen)
+{
+    MarkerRangeQueue queue{256};
+
+    for (auto i = 0u; i < 256; ++i)
+        ASSERT_NE(queue.tryPop(), nullptr);
+
+    EXPECT_EQ(queue.tryPop(), nullptr);
+}
+
+TEST(ETLMarkerRangeQueueTest, FailedRangeIsRetriedFromItsCurrentPosition)
+{
+    MarkerRangeQueue queue{1};
+
+    auto const range = queue.tryPop();
+    range->begin = 42;
+    queue.retry(range, "partial");
+
+    auto const retried = queue.tryPop();
+    ASSERT_NE(retried, nullptr);
+    EXPECT_EQ(retried->begin, 42);
+    EXPECT_EQ(retried->end, MarkerRange::KEY_SPACE_END);
+    EXPECT_EQ(queue.edgeKeys(), std::vector<std::string>{"partial"});
+
+    queue.finish(retried, "last");
+    EXPECT_TRUE(queue.isDone());
+}
+
+TEST(ETLMarkerRangeQueueTest, FailedRangeIsResumedFromLastMarker)
+{
+    MarkerRangeQueue queue{1};
+    auto const marker = std::string(1, '\x2A') + std::string(31, '\x01');
+
+    auto const range = queue.tryPop();
+    EXPECT_EQ(queue.advance(range, marker), MarkerRange::KEY_SPACE_END);
+    EXPECT_EQ(range->begin, 42);
+    queue.retry(range, "partial");
+
+    auto const retried = queue.tryPop();
+    ASSERT_NE(retried, nullptr);
+    EXPECT_EQ(retried->begin, 42);
+    EXPECT_EQ(retried->marker, marker);
+}
+
+TEST(ETLMarkerRangeQueueTest, AdvancePastEndCompletesRange)
+{
+    MarkerRangeQueue queue{2};
+
+    auto const first = queue.tryPop();
+    auto const second = queue.tryPop();
+    EXPECT_EQ(queue.advance(first, std::string(32, '\x90')), 128);
+    EXPECT_EQ(first->begin, 128);
+    EXPECT_TRUE(first->marker.empty());
+
+    // nothing is left of first to steal
+    auto const stolen = queue.tryPop();
+    ASSERT_NE(stolen, nullptr);
+    EXPECT_EQ(stolen->begin, 192);
+    EXPECT_EQ(second->end, 192);
+    EXPECT_EQ(first->end, 128);
+}
+
+TEST(ETLMarkerRangeQueueTest, AdvanceWithoutMarkerCompletesRange)
+{
+    MarkerRangeQueue queue{1};
+
+    auto const range = queue.tryPop();
+    EXPECT_EQ(queue.advance(range, ""), MarkerRange::KEY_SPACE_END);
+    EXPECT_EQ(range->begin, MarkerRange::KEY_SPACE_END);
+    EXPECT_EQ(queue.tryPop(), nullptr);
+}
@@ -0,0 +1,107 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <etl/impl/SourceStats.h>
+
+#include <gtest/gtest.h>
+
+using namespace clio::detail;
+using namespace std::chrono_literals;
+
+TEST(ETLSourceStatsTest, UnmeasuredSourceHasZeroCost)
+{
+    RequestStats stats;
+    EXPECT_EQ(stats.cost(), 0.0);
+    EXPECT_EQ(stats.latencyMs(), 0.0);
+}
+
+TEST(ETLSourceStatsTest, FirstSampleSetsLatency)
+{
+    RequestStats stats;
+    stats.started();
+    stats.finished(100ms, true);
+
+    EXPECT_DOUBLE_EQ(stats.latencyMs(), 100.0);
+    EXPECT_DOUBLE_EQ(stats.cost(), 100.0);
+}
+
+TEST(ETLSourceStatsTest, LatencyIsSmoothed)
+{
+    RequestStats stats;
+    stats.finished(100ms, true);
+    stats.finished(200ms, true);
+
+    EXPECT_DOUBLE_EQ(stats.latencyMs(), 100.0 + RequestStats::SMOOTHING_FACTOR * 100.0);
+}
+
+TEST(ETLSourceStatsTest, FailuresAndInFlightRequestsIncreaseCost)
+{
+    RequestStats healthy;
+    RequestStats failing;
+    RequestStats busy;
+
+    healthy.finished(100ms, true);
+    failing.finished(100ms, true);
+    failing.finished(100ms, false);
+    busy.finished(100ms, true);
+    busy.started();
+
+    EXPECT_GT(failing.cost(), healthy.cost());
+    EXPECT_GT(busy.cost(), healthy.cost());
+
+    busy.abandoned();
+    EXPECT_DOUBLE_EQ(busy.cost(), healthy.cost());
+}
+
+TEST(ETLSourceStatsTest, UnmeasuredSourceUsesPriorLatency)
+{
+    RequestStats stats;
+    EXPECT_FALSE(stats.isMeasured());
+    EXPECT_DOUBLE_EQ(stats.cost(100.0), 100.0);
+
+    stats.finished(10ms, true);
+    EXPECT_TRUE(stats.isMeasured());
+    EXPECT_DOUBLE_EQ(stats.cost(100.0), 10.0);
+}
+
+TEST(ETLSourceStatsTest, FastFailingSourceIsNotCheaperThanHealthySource)
+{
+    RequestStats healthy;
+    RequestStats failing;
+
+    healthy.finished(100ms, true);
+    failing.finished(1ms, false);
+    failing.finished(1ms, false);
+
+    EXPECT_GT(failing.cost(), healthy.cost());
+}
+
+TEST(ETLSourceStatsTest, ToJson)
+{
+    SourceStats stats;
+    stats.grpc.finished(10ms, true);
+    stats.forward.finished(20ms, false);
+
+    auto const json = stats.toJson();
+    EXPECT_EQ(json.at("grpc").at("successes").as_uint64(), 1);
+    EXPECT_EQ(json.at("grpc").at("failures").as_uint64(), 0);
+    EXPECT_EQ(json.at("forward").at("successes").as_uint64(), 0);
+    EXPECT_EQ(json.at("forward").at("failures").as_uint64(), 1);
+    EXPECT_DOUBLE_EQ(json.at("forward").at("error_rate").as_double(), 1.0);
+}
@@ -149,3 +149,43 @@ TEST_F(ETLTransformerTest, DoesNotPublishIfCanNotBuildNextLedger)
     transformer_ =
         std::make_unique<TransformerType>(dataPipe_, mockBackendPtr, ledgerLoader_, ledgerPublisher_, 0, state_);
 }
+
+TEST_F(ETLTransformerTest, PublishesTransactionsWithoutReadingThemBack)
+{
+    MockBackend* rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
+    mockBackendPtr->cache().setFull();  // to avoid throwing exception in updateCache
+
+    auto const blob = hexStringToBinaryString(RAW_HEADER);
+    auto const response = std::make_optional<FakeFetchResponse>(blob);
+
+    ON_CALL(dataPipe_, popNext).WillByDefault([this, &response](auto) -> std::optional<FakeFetchResponse> {
+        if (state_.isStopping)
+            return std::nullopt;
+        return response;
+    });
+    ON_CALL(*rawBackendPtr, doFinishWrites).WillByDefault(Return(true));
+
+    EXPECT_CALL(dataPipe_, popNext).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, startWrites).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, writeLedger(_, _)).Times(AtLeast(1));
+    EXPECT_CALL(ledgerLoader_, insertTransactions).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, writeAccountTransactions).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, writeNFTs).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, writeNFTTransactions).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, doFinishWrites).Times(AtLeast(1));
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(0);
+
+    auto const expectedSeq = util::deserializeHeader(ripple::makeSlice(blob)).seq;
+    EXPECT_CALL(ledgerPublisher_, publish(_))
+        .Times(AtLeast(1))
+        .WillRepeatedly([expectedSeq](std::shared_ptr<clio::detail::LedgerBundle const> bundle) {
+            EXPECT_EQ(bundle->lgrInfo.seq, expectedSeq);
+            EXPECT_TRUE(bundle->transactions.has_value());
+        });
+
+    transformer_ =
+        std::make_unique<TransformerType>(dataPipe_, mockBackendPtr, ledgerLoader_, ledgerPublisher_, 0, state_);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds{10});
+    state_.isStopping = true;
+}
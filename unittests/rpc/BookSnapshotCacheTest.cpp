@@ -0,0 +1,125 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/BookSnapshotCache.h>
+#include <util/Fixtures.h>
+#include <util/TestObject.h>
+
+#include <gtest/gtest.h>
+
+using namespace RPC;
+
+constexpr static auto ACCOUNT = "rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn";
+constexpr static auto ACCOUNT2 = "rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun";
+constexpr static auto CURRENCY = "0158415500000000C1F76FF6ECB0BAC600000000";
+
+class BookSnapshotCacheTest : public SyncAsioContextTest
+{
+protected:
+    BookSnapshotCache cache;
+    ripple::Book const book{ripple::xrpIssue(), GetIssue(CURRENCY, ACCOUNT)};
+    ripple::AccountID const taker = GetAccountIDWithString(ACCOUNT2);
+    int renders = 0;
+
+    // renders an order book of one offer named after the number of renders, yielding once like a database read
+    auto
+    renderer(boost::asio::yield_context& yield)
+    {
+        return [this, &yield]() {
+            auto const number = ++renders;
+            boost::asio::steady_timer timer{yield.get_executor(), std::chrono::milliseconds{5}};
+            timer.async_wait(yield);
+            return boost::json::array{number};
+        };
+    }
+};
+
+TEST_F(BookSnapshotCacheTest, ConcurrentSubscribersShareOneSnapshot)
+{
+    std::vector<BookSnapshotCache::Snapshot> snapshots;
+    for (auto i = 0; i < 3; ++i)
+    {
+        boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+            snapshots.push_back(cache.get(book, taker, 10, yield, renderer(yield)));
+        });
+    }
+    ctx.run();
+
+    EXPECT_EQ(renders, 1);
+    ASSERT_EQ(snapshots.size(), 3);
+    EXPECT_EQ(snapshots[0], snapshots[1]);
+    EXPECT_EQ(snapshots[0], snapshots[2]);
+    EXPECT_EQ(*snapshots[0], boost::json::array{1});
+}
+
+TEST_F(BookSnapshotCacheTest, KeyedByBookAndTaker)
+{
+    runSpawn([this](boost::asio::yield_context yield) {
+        cache.get(book, taker, 10, yield, renderer(yield));
+        cache.get(ripple::reversed(book), taker, 10, yield, renderer(yield));
+        cache.get(book, GetAccountIDWithString(ACCOUNT), 10, yield, renderer(yield));
+        EXPECT_EQ(*cache.get(book, taker, 10, yield, renderer(yield)), boost::json::array{1});
+    });
+    EXPECT_EQ(renders, 3);
+    EXPECT_EQ(cache.size(), 3);
+}
+
+TEST_F(BookSnapshotCacheTest, NextLedgerDropsSnapshots)
+{
+    runSpawn([this](boost::asio::yield_context yield) {
+        cache.get(book, taker, 10, yield, renderer(yield));
+        cache.get(ripple::reversed(book), taker, 10, yield, renderer(yield));
+        EXPECT_EQ(*cache.get(book, taker, 11, yield, renderer(yield)), boost::json::array{3});
+        EXPECT_EQ(cache.size(), 1);
+
+        // a request still at the previous ledger is rendered but not kept
+        EXPECT_EQ(*cache.get(book, taker, 10, yield, renderer(yield)), boost::json::array{4});
+        EXPECT_EQ(*cache.get(book, taker, 11, yield, renderer(yield)), boost::json::array{3});
+    });
+    EXPECT_EQ(renders, 4);
+    EXPECT_EQ(cache.size(), 1);
+}
+
+TEST_F(BookSnapshotCacheTest, WaitersRenderThemselvesIfRenderingFailed)
+{
+    auto failed = false;
+    BookSnapshotCache::Snapshot snapshot;
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        try
+        {
+            cache.get(book, taker, 10, yield, [&]() -> boost::json::array {
+                renderer(yield)();
+                throw std::runtime_error("database timeout");
+            });
+        }
+        catch (std::runtime_error const&)
+        {
+            failed = true;
+        }
+    });
+    boost::asio::spawn(ctx, [&, this](boost::asio::yield_context yield) {
+        snapshot = cache.get(book, taker, 10, yield, renderer(yield));
+    });
+    ctx.run();
+
+    EXPECT_TRUE(failed);
+    ASSERT_TRUE(snapshot);
+    EXPECT_EQ(*snapshot, boost::json::array{2});
+    EXPECT_EQ(cache.size(), 0);
+}
@@ -49,6 +49,11 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
         counters.onBadSyntax();
         counters.onUnknownCommand();
         counters.onInternalError();
+        counters.onMessagesDropped(2);
+        counters.onSlowConsumerDisconnected();
+        counters.onResponseCacheHit();
+        counters.onResponseCacheMiss();
+        counters.onResponseCacheMiss();
     }
 
     auto const report = counters.report();
@@ -95,6 +100,10 @@ TEST_F(RPCCountersTest, CheckThatCountersAddUp)
     EXPECT_STREQ(report.at("bad_syntax_errors").as_string().c_str(), "512");
     EXPECT_STREQ(report.at("unknown_command_errors").as_string().c_str(), "512");
     EXPECT_STREQ(report.at("internal_errors").as_string().c_str(), "512");
+    EXPECT_STREQ(report.at("dropped_messages").as_string().c_str(), "1024");
+    EXPECT_STREQ(report.at("slow_consumer_disconnects").as_string().c_str(), "512");
+    EXPECT_STREQ(report.at("response_cache_hits").as_string().c_str(), "512");
+    EXPECT_STREQ(report.at("response_cache_misses").as_string().c_str(), "1024");
 
     EXPECT_EQ(report.at("work_queue"), queue.report());  // Counters report includes queue report
 }
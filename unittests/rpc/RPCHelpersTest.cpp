@@ -301,3 +301,66 @@ TEST_F(RPCHelpersTest, TraverseOwnedNodesWithUnexistingIndexMarker)
     });
     ctx.run();
 }
+
+namespace {
+
+// the JSON produced by rippled, as toJson used to convert it
+template <typename T>
+std::string
+rippledJson(T const& obj)
+{
+    return boost::json::serialize(boost::json::parse(obj.getJson(ripple::JsonOptions::none).toStyledString()));
+}
+
+}  // namespace
+
+TEST_F(RPCHelpersTest, TransactionToJsonMatchesRippled)
+{
+    auto const payment = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 1, 2, 100);
+    auto const paymentBlob = payment.getSerializer().peekData();
+    ripple::STTx const paymentTx{ripple::SerialIter{paymentBlob.data(), paymentBlob.size()}};
+    EXPECT_EQ(boost::json::serialize(toJson(paymentTx)), rippledJson(paymentTx));
+
+    auto const offer = CreateCreateOfferTransactionObject(ACCOUNT, 2, 100, "USD", ACCOUNT2, 10, 20);
+    auto const offerBlob = offer.getSerializer().peekData();
+    ripple::STTx const offerTx{ripple::SerialIter{offerBlob.data(), offerBlob.size()}};
+    EXPECT_EQ(boost::json::serialize(toJson(offerTx)), rippledJson(offerTx));
+}
+
+TEST_F(RPCHelpersTest, MetaToJsonMatchesRippled)
+{
+    auto const metaObj = CreateMetaDataForBookChange("USD", ACCOUNT, 22, 3, 1, 1, 3);
+    auto const metaBlob = metaObj.getSerializer().peekData();
+    ripple::TxMeta const meta{ripple::uint256{TXNID}, 30, metaBlob};
+    EXPECT_EQ(boost::json::serialize(toJson(meta)), rippledJson(meta));
+
+    auto const paymentMetaObj = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30);
+    auto const paymentMetaBlob = paymentMetaObj.getSerializer().peekData();
+    ripple::TxMeta const paymentMeta{ripple::uint256{TXNID}, 30, paymentMetaBlob};
+    EXPECT_EQ(boost::json::serialize(toJson(paymentMeta)), rippledJson(paymentMeta));
+}
+
+TEST_F(RPCHelpersTest, LedgerObjectToJsonMatchesRippled)
+{
+    auto const check = [](ripple::STObject const& obj) {
+        ripple::SLE const sle{obj, ripple::uint256{INDEX1}};
+        EXPECT_EQ(boost::json::serialize(toJson(sle)), rippledJson(sle));
+        EXPECT_EQ(boost::json::serialize(toJson(static_cast<ripple::STBase const&>(sle))), rippledJson(sle));
+    };
+
+    check(CreateAccountRootObject(ACCOUNT, 0, 2, 200, 2, INDEX1, 2));
+    check(CreateOfferLedgerObject(
+        ACCOUNT,
+        10,
+        20,
+        ripple::to_string(ripple::to_currency("USD")),
+        ripple::to_string(ripple::xrpCurrency()),
+        ACCOUNT2,
+        toBase58(ripple::xrpAccount()),
+        INDEX2));
+    check(CreateRippleStateLedgerObject(ACCOUNT, "USD", ACCOUNT2, 100, ACCOUNT, 10, ACCOUNT2, 20, TXNID, 123));
+
+    auto ownerDir = CreateOwnerDirLedgerObject({ripple::uint256{INDEX1}, ripple::uint256{INDEX2}}, INDEX1);
+    ownerDir.setFieldU64(ripple::sfIndexNext, 99);
+    check(ownerDir);
+}
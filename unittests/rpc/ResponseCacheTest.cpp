@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <rpc/ResponseCache.h>
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+using namespace RPC;
+namespace json = boost::json;
+
+constexpr static auto API_VERSION = 1u;
+
+class ResponseCacheTest : public ::testing::Test
+{
+protected:
+    Backend::LedgerRange const range{10, 30};
+
+    std::optional<std::string>
+    keyFor(std::string const& method, std::string const& params, bool isAdmin = false) const
+    {
+        return ResponseCache::makeKey(method, json::parse(params).as_object(), API_VERSION, isAdmin, range);
+    }
+};
+
+TEST_F(ResponseCacheTest, OnlySpecificLedgersOfTheRangeAreCached)
+{
+    EXPECT_TRUE(keyFor("ledger", R"({"ledger_index": 20})"));
+    EXPECT_TRUE(keyFor("ledger", R"({"ledger_index": "30"})"));
+    EXPECT_TRUE(keyFor("account_info", R"({"account": "r", "ledger_hash": "ABCD"})"));
+    EXPECT_TRUE(keyFor("tx", R"({"transaction": "ABCD"})"));
+
+    EXPECT_FALSE(keyFor("ledger", R"({})"));
+    EXPECT_FALSE(keyFor("ledger", R"({"ledger_index": "validated"})"));
+    EXPECT_FALSE(keyFor("ledger", R"({"ledger_index": "current"})"));
+    EXPECT_FALSE(keyFor("ledger", R"({"ledger_index": 31})"));
+    EXPECT_FALSE(keyFor("ledger", R"({"ledger_index": 9})"));
+    EXPECT_FALSE(keyFor("ledger", R"({"ledger_index": -1})"));
+    EXPECT_FALSE(keyFor("account_tx", R"({"account": "r", "ledger_index": 20})"));
+}
+
+TEST_F(ResponseCacheTest, KeyIgnoresFieldOrderAndRequestId)
+{
+    auto const key = keyFor("ledger_entry", R"({"index": "AB", "ledger_index": 20, "options": {"a": 1, "b": 2}})");
+    ASSERT_TRUE(key);
+    EXPECT_EQ(
+        key,
+        keyFor(
+            "ledger_entry",
+            R"({"id": 5, "command": "ledger_entry", "options": {"b": 2, "a": 1}, "ledger_index": 20, "index": "AB"})"));
+
+    EXPECT_NE(key, keyFor("ledger_entry", R"({"index": "AB", "ledger_index": 21, "options": {"a": 1, "b": 2}})"));
+    EXPECT_NE(key, keyFor("ledger_entry", R"({"index": "AB", "ledger_index": 20, "options": {"a": 1, "b": 2}})", true));
+    EXPECT_NE(
+        key,
+        ResponseCache::makeKey(
+            "ledger_entry",
+            json::parse(R"({"index": "AB", "ledger_index": 20, "options": {"a": 1, "b": 2}})").as_object(),
+            API_VERSION + 1,
+            false,
+            range));
+}
+
+TEST_F(ResponseCacheTest, GetReturnsWhatWasPut)
+{
+    ResponseCache cache{1024};
+    EXPECT_FALSE(cache.get("key"));
+
+    auto const response = json::parse(R"({"ledger": {"ledger_index": "20"}, "validated": true})").as_object();
+    cache.put("key", response);
+    ASSERT_TRUE(cache.get("key"));
+    EXPECT_EQ(*cache.get("key"), json::serialize(response));
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), 3 + json::serialize(response).size());
+
+    // putting the same key again replaces the response
+    cache.put("key", json::object{{"other", 1}});
+    ASSERT_TRUE(cache.get("key"));
+    EXPECT_EQ(*cache.get("key"), R"({"other":1})");
+    EXPECT_EQ(cache.size(), 1);
+    EXPECT_EQ(cache.bytes(), 3 + json::serialize(json::object{{"other", 1}}).size());
+}
+
+TEST_F(ResponseCacheTest, LeastRecentlyUsedIsEvicted)
+{
+    auto const response = json::object{{"value", "0123456789"}};
+    auto const entryBytes = 1 + json::serialize(response).size();
+    ResponseCache cache{3 * entryBytes};
+
+    cache.put("a", response);
+    cache.put("b", response);
+    cache.put("c", response);
+    EXPECT_TRUE(cache.get("a"));
+
+    cache.put("d", response);
+    EXPECT_EQ(cache.size(), 3);
+    EXPECT_LE(cache.bytes(), 3 * entryBytes);
+    EXPECT_TRUE(cache.get("a"));
+    EXPECT_FALSE(cache.get("b"));
+    EXPECT_TRUE(cache.get("c"));
+    EXPECT_TRUE(cache.get("d"));
+}
+
+TEST_F(ResponseCacheTest, ResponseOverBudgetIsNotCached)
+{
+    ResponseCache cache{16};
+    cache.put("key", json::object{{"value", "more than sixteen bytes"}});
+    EXPECT_FALSE(cache.get("key"));
+    EXPECT_EQ(cache.bytes(), 0);
+}
+
+TEST_F(ResponseCacheTest, GetSharesTheStoredResponse)
+{
+    ResponseCache cache{1024};
+    cache.put("key", json::object{{"value", 1}});
+    EXPECT_EQ(cache.get("key"), cache.get("key"));
+}
+
+TEST_F(ResponseCacheTest, ResponseWithStatusOrErrorIsNotCached)
+{
+    ResponseCache cache{1024};
+    cache.put("status", json::object{{"status", "success"}});
+    cache.put("error", json::object{{"error", "txnNotFound"}});
+    EXPECT_FALSE(cache.get("status"));
+    EXPECT_FALSE(cache.get("error"));
+    EXPECT_EQ(cache.size(), 0);
+}
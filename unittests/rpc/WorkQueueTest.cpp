@@ -0,0 +1,177 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+
+#include <rpc/WorkQueue.h>
+
+#include <gtest/gtest.h>
+
+#include <future>
+
+using namespace std::chrono_literals;
+
+namespace {
+
+// runs the queued jobs on a single thread, in the order the queue hands them out
+class WorkQueueTest : public NoLoggerFixture
+{
+protected:
+    static constexpr auto NUM_WORKERS = 2u;  // the calling thread counts as one
+
+    std::mutex mtx_;
+    std::vector<std::string> order_;
+    std::promise<void> release_;
+    std::promise<void> blocked_;
+
+    // occupy the only worker until release() is called
+    void
+    block(WorkQueue& queue)
+    {
+        queue.postCoro(
+            [this](auto) {
+                blocked_.set_value();
+                release_.get_future().wait();
+            },
+            false);
+        blocked_.get_future().wait();
+    }
+
+    void
+    release()
+    {
+        release_.set_value();
+    }
+
+    bool
+    post(WorkQueue& queue, std::string name, WorkQueue::Priority priority, std::string const& client)
+    {
+        return queue.postCoro(
+            [this, name = std::move(name)](auto) {
+                std::scoped_lock const lck{mtx_};
+                order_.push_back(name);
+            },
+            false,
+            priority,
+            client);
+    }
+
+    void
+    waitFor(std::size_t count)
+    {
+        for (auto i = 0; i < 100; ++i)
+        {
+            {
+                std::scoped_lock const lck{mtx_};
+                if (order_.size() >= count)
+                    return;
+            }
+            std::this_thread::sleep_for(10ms);
+        }
+    }
+};
+
+}  // namespace
+
+TEST_F(WorkQueueTest, ClientsAreServedInTurn)
+{
+    WorkQueue queue{NUM_WORKERS};
+    block(queue);
+
+    post(queue, "A1", WorkQueue::Priority::NORMAL, "A");
+    post(queue, "A2", WorkQueue::Priority::NORMAL, "A");
+    post(queue, "A3", WorkQueue::Priority::NORMAL, "A");
+    post(queue, "B1", WorkQueue::Priority::NORMAL, "B");
+
+    release();
+    waitFor(4);
+    EXPECT_EQ(order_, (std::vector<std::string>{"A1", "B1", "A2", "A3"}));
+}
+
+TEST_F(WorkQueueTest, ClassesAreServedByWeight)
+{
+    WorkQueue queue{NUM_WORKERS, WorkQueue::Settings{.weights = {2, 1, 1}}};
+    block(queue);
+
+    for (auto const* name : {"L1", "L2", "L3"})
+        post(queue, name, WorkQueue::Priority::LOW, "client");
+
+    for (auto const* name : {"H1", "H2", "H3", "H4"})
+        post(queue, name, WorkQueue::Priority::HIGH, "client");
+
+    release();
+    waitFor(7);
+
+    // the blocking job took the turn of the normal class, the low class is next
+    EXPECT_EQ(order_, (std::vector<std::string>{"L1", "H1", "H2", "L2", "H3", "H4", "L3"}));
+
+    auto const report = queue.report();
+    auto const& priorities = report.at("priorities").as_object();
+    EXPECT_EQ(priorities.at("high").at("queued").as_uint64(), 4);
+    EXPECT_EQ(priorities.at("normal").at("queued").as_uint64(), 1);
+    EXPECT_EQ(priorities.at("low").at("queued").as_uint64(), 3);
+    EXPECT_EQ(priorities.at("low").at("current_queue_size").as_uint64(), 0);
+    EXPECT_EQ(priorities.at("high").at("weight").as_uint64(), 2);
+    EXPECT_EQ(report.at("queued").as_uint64(), 8);
+}
+
+TEST_F(WorkQueueTest, RejectsWhenFull)
+{
+    WorkQueue queue{NUM_WORKERS, 2u};
+    block(queue);
+
+    EXPECT_TRUE(post(queue, "A1", WorkQueue::Priority::NORMAL, "A"));
+    EXPECT_FALSE(post(queue, "A2", WorkQueue::Priority::NORMAL, "A"));
+    EXPECT_TRUE(queue.postCoro([](auto) {}, true));
+
+    release();
+}
+
+TEST_F(WorkQueueTest, RejectsWhenWaitIsTooLong)
+{
+    WorkQueue queue{NUM_WORKERS, WorkQueue::Settings{.maxWait = 1ms}};
+    block(queue);
+
+    EXPECT_TRUE(post(queue, "A1", WorkQueue::Priority::NORMAL, "A"));
+    std::this_thread::sleep_for(20ms);
+    release();
+    waitFor(1);
+
+    // A1 waited long enough to make the recent wait of the normal class exceed the limit
+    release_ = std::promise<void>{};
+    blocked_ = std::promise<void>{};
+    block(queue);
+
+    EXPECT_TRUE(post(queue, "A2", WorkQueue::Priority::NORMAL, "A"));
+    EXPECT_FALSE(post(queue, "A3", WorkQueue::Priority::NORMAL, "A"));
+    EXPECT_TRUE(post(queue, "H1", WorkQueue::Priority::HIGH, "A"));
+
+    release();
+    waitFor(3);
+}
+
+TEST_F(WorkQueueTest, PriorityOfMethod)
+{
+    WorkQueue queue{NUM_WORKERS, WorkQueue::Settings{.priorities = {{"account_tx", WorkQueue::Priority::NORMAL}}}};
+
+    EXPECT_EQ(queue.priorityOf("fee"), WorkQueue::Priority::HIGH);
+    EXPECT_EQ(queue.priorityOf("ledger_data"), WorkQueue::Priority::LOW);
+    EXPECT_EQ(queue.priorityOf("account_tx"), WorkQueue::Priority::NORMAL);
+    EXPECT_EQ(queue.priorityOf("account_lines"), WorkQueue::Priority::NORMAL);
+}
@@ -502,6 +502,35 @@ TEST_F(RPCAccountTxHandlerTest, LimitAndMarker)
     });
 }
 
+TEST_F(RPCAccountTxHandlerTest, SerializedOutputMatchesOutput)
+{
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+    MockBackend* rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
+    auto const transactions = genTransactions(MINSEQ + 1, MAXSEQ - 1);
+    auto const transCursor = TransactionsAndCursor{transactions, TransactionsCursor{12, 34}};
+    ON_CALL(*rawBackendPtr, fetchAccountTransactions).WillByDefault(Return(transCursor));
+    EXPECT_CALL(*rawBackendPtr, fetchAccountTransactions).Times(2);
+
+    runSpawn([&, this](auto& yield) {
+        auto const handler = AnyHandler{AccountTxHandler{mockBackendPtr}};
+        auto const static input = boost::json::parse(fmt::format(
+            R"({{
+                "account":"{}",
+                "limit": 2,
+                "marker": {{"ledger":10,"seq":11}}
+            }})",
+            ACCOUNT));
+        EXPECT_TRUE(handler.streamsOutput());
+
+        auto const output = handler.process(input, Context{std::ref(yield)});
+        ASSERT_TRUE(output);
+        auto const serialized = handler.processSerialized(input, Context{std::ref(yield)});
+        ASSERT_TRUE(serialized);
+        EXPECT_EQ(*serialized, json::serialize(*output));
+    });
+}
+
 TEST_F(RPCAccountTxHandlerTest, SpecificLedgerIndex)
 {
     mockBackendPtr->updateRange(MINSEQ);  // min
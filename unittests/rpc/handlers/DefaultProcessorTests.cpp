@@ -83,3 +83,21 @@ TEST_F(RPCDefaultProcessorTest, InvalidInput)
         ASSERT_FALSE(ret);  // returns error
     });
 }
+
+TEST_F(RPCDefaultProcessorTest, SerializedOutputOfHandlerWithoutWriter)
+{
+    runSpawn([](auto& yield) {
+        HandlerMock handler;
+        RPC::detail::DefaultProcessor<HandlerMock> processor;
+
+        auto const input = json::parse(R"({ "something": "works" })");
+        auto const spec = RpcSpec{{"something", Required{}}};
+        auto const data = InOutFake{"works"};
+        EXPECT_CALL(handler, spec(_)).WillOnce(ReturnRef(spec));
+        EXPECT_CALL(handler, process(Eq(data), _)).WillOnce(Return(data));
+
+        auto const ret = processor.serialized(handler, input, Context{std::ref(yield)});
+        ASSERT_TRUE(ret);
+        EXPECT_EQ(*ret, R"({"something":"works"})");
+    });
+}
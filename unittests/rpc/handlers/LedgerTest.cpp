@@ -532,6 +532,103 @@ TEST_F(RPCLedgerHandlerTest, TransactionsExpandNotBinary)
     });
 }
 
+TEST_F(RPCLedgerHandlerTest, TransactionsExpandNotBinarySerialized)
+{
+    static auto constexpr expectedOut =
+        R"({
+            "ledger_hash":"4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+            "ledger_index":30,
+            "validated":true,
+            "ledger":{
+                "accepted":true,
+                "account_hash":"0000000000000000000000000000000000000000000000000000000000000000",
+                "close_flags":0,
+                "close_time":0,
+                "close_time_resolution":0,
+                "closed":true,
+                "hash":"4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+                "ledger_hash":"4BC50C9B0D8515D3EAAE1E74B29A95804346C491EE1A95BF25E4AAB854A6A652",
+                "ledger_index":"30",
+                "parent_close_time":0,
+                "parent_hash":"0000000000000000000000000000000000000000000000000000000000000000",
+                "seqNum":"30",
+                "totalCoins":"0",
+                "total_coins":"0",
+                "transaction_hash":"0000000000000000000000000000000000000000000000000000000000000000",
+                "transactions":[
+                    {
+                        "Account":"rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn",
+                        "Amount":"100",
+                        "Destination":"rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun",
+                        "Fee":"3",
+                        "Sequence":30,
+                        "SigningPubKey":"74657374",
+                        "TransactionType":"Payment",
+                        "hash":"70436A9332F7CD928FAEC1A41269A677739D8B11F108CE23AE23CBF0C9113F8C",
+                        "metaData":{
+                        "AffectedNodes":[
+                            {
+                                "ModifiedNode":{
+                                    "FinalFields":{
+                                    "Account":"rf1BiGeXwwQoi8Z2ueFYTEXSwuJYfV2Jpn",
+                                    "Balance":"110"
+                                    },
+                                    "LedgerEntryType":"AccountRoot"
+                                }
+                            },
+                            {
+                                "ModifiedNode":{
+                                    "FinalFields":{
+                                    "Account":"rLEsXccBGNR3UPuPu2hUXPjziKC3qKSBun",
+                                    "Balance":"30"
+                                    },
+                                    "LedgerEntryType":"AccountRoot"
+                                }
+                            }
+                        ],
+                        "TransactionIndex":0,
+                        "TransactionResult":"tesSUCCESS",
+                        "delivered_amount":"unavailable"
+                        }
+                    }
+                ]
+            }
+        })";
+    auto const rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
+    mockBackendPtr->updateRange(RANGEMIN);
+    mockBackendPtr->updateRange(RANGEMAX);
+
+    auto const ledgerinfo = CreateLedgerInfo(LEDGERHASH, RANGEMAX);
+    EXPECT_CALL(*rawBackendPtr, fetchLedgerBySequence).Times(1);
+    ON_CALL(*rawBackendPtr, fetchLedgerBySequence(RANGEMAX, _)).WillByDefault(Return(ledgerinfo));
+
+    TransactionAndMetadata t1;
+    t1.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 100, 3, RANGEMAX).getSerializer().peekData();
+    t1.metadata = CreatePaymentTransactionMetaObject(ACCOUNT, ACCOUNT2, 110, 30).getSerializer().peekData();
+    t1.ledgerSequence = RANGEMAX;
+
+    EXPECT_CALL(*rawBackendPtr, fetchAllTransactionsInLedger).Times(1);
+    ON_CALL(*rawBackendPtr, fetchAllTransactionsInLedger(RANGEMAX, _)).WillByDefault(Return(std::vector{t1}));
+
+    runSpawn([&, this](auto& yield) {
+        auto const handler = AnyHandler{LedgerHandler{mockBackendPtr}};
+        auto const req = json::parse(
+            R"({
+                "binary": false,
+                "expand": true,
+                "transactions": true
+            })");
+        EXPECT_TRUE(handler.streamsOutput());
+
+        auto const serialized = handler.processSerialized(req, Context{std::ref(yield)});
+        ASSERT_TRUE(serialized);
+        auto output = json::parse(*serialized);
+        // remove human readable time, it is sightly different cross the platform
+        EXPECT_EQ(output.as_object().at("ledger").as_object().erase("close_time_human"), 1);
+        EXPECT_EQ(output, json::parse(expectedOut));
+    });
+}
+
 TEST_F(RPCLedgerHandlerTest, TransactionsNotExpand)
 {
     auto const rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
@@ -525,6 +525,41 @@ generateTestValuesForParametersTest()
             })",
             "actMalformed",
             "takerMalformed"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterNotObject",
+            R"({"streams": ["transactions"], "transactions_filter": []})",
+            "invalidParams",
+            "transactions_filterNotObject"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterTypesNotArray",
+            R"({"streams": ["transactions"], "transactions_filter": {"transaction_types": "Payment"}})",
+            "invalidParams",
+            "transaction_typesNotArray"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterTypeUnknown",
+            R"({"streams": ["transactions"], "transactions_filter": {"transaction_types": ["Pay"]}})",
+            "invalidParams",
+            "transaction_typesMalformed"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterResultUnknown",
+            R"({"streams": ["transactions"], "transactions_filter": {"engine_results": ["tesFAILURE"]}})",
+            "invalidParams",
+            "engine_resultsMalformed"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterMinXrpNotString",
+            R"({"streams": ["transactions"], "transactions_filter": {"min_xrp_amount": 100}})",
+            "invalidParams",
+            "min_xrp_amountMalformed"},
+        SubscribeParamTestCaseBundle{
+            "TransactionsFilterMinXrpNegative",
+            R"({"streams": ["transactions"], "transactions_filter": {"min_xrp_amount": "-1"}})",
+            "invalidParams",
+            "min_xrp_amountMalformed"},
+        SubscribeParamTestCaseBundle{
+            "FromLedgerNotInt",
+            R"({"streams": ["transactions"], "from_ledger": "33"})",
+            "invalidParams",
+            "Invalid parameters."},
     };
 }
 
@@ -580,6 +615,66 @@ TEST_F(RPCSubscribeHandlerTest, StreamsWithoutLedger)
     });
 }
 
+TEST_F(RPCSubscribeHandlerTest, StreamsTransactionsFiltered)
+{
+    auto const input = json::parse(
+        R"({
+            "streams": ["transactions"],
+            "transactions_filter": {
+                "transaction_types": ["Payment", "OfferCreate"],
+                "engine_results": ["tesSUCCESS"],
+                "min_xrp_amount": "1000000"
+            }
+        })");
+    runSpawn([&, this](auto& yield) {
+        auto const handler = AnyHandler{SubscribeHandler{mockBackendPtr, subManager_}};
+        auto const output = handler.process(input, Context{std::ref(yield), session_});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output->as_object().empty());
+        EXPECT_EQ(subManager_->report().at("transactions").as_uint64(), 1);
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, FromLedgerNotReplayable)
+{
+    runSpawn([&, this](auto& yield) {
+        auto const handler = AnyHandler{SubscribeHandler{mockBackendPtr, subManager_}};
+        auto const output = handler.process(
+            json::parse(R"({"streams": ["transactions"], "from_ledger": 33})"), Context{std::ref(yield), session_});
+        ASSERT_FALSE(output);
+        auto const err = RPC::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "lgrNotFound");
+        EXPECT_EQ(err.at("error_message").as_string(), "fromLedgerNotReplayable");
+        EXPECT_EQ(subManager_->report().at("transactions").as_uint64(), 0);
+    });
+}
+
+TEST_F(RPCSubscribeHandlerTest, FromLedgerReplaysTransactions)
+{
+    auto trans = Backend::TransactionAndMetadata();
+    trans.transaction = CreatePaymentTransactionObject(ACCOUNT, ACCOUNT2, 1, 1, 32).getSerializer().peekData();
+    ripple::STObject metaObj(ripple::sfTransactionMetaData);
+    metaObj.setFieldArray(ripple::sfAffectedNodes, ripple::STArray{0});
+    metaObj.setFieldU8(ripple::sfTransactionResult, ripple::tesSUCCESS);
+    metaObj.setFieldU32(ripple::sfTransactionIndex, 22);
+    trans.metadata = metaObj.getSerializer().peekData();
+    trans.ledgerSequence = 32;
+    subManager_->pubTransaction(trans, CreateLedgerInfo(LEDGERHASH, 33));
+
+    runSpawn([&, this](auto& yield) {
+        auto const handler = AnyHandler{SubscribeHandler{mockBackendPtr, subManager_}};
+        auto const output = handler.process(
+            json::parse(R"({"streams": ["transactions"], "from_ledger": 33})"), Context{std::ref(yield), session_});
+        ASSERT_TRUE(output);
+        EXPECT_TRUE(output->as_object().empty());
+        EXPECT_EQ(subManager_->report().at("transactions").as_uint64(), 1);
+
+        auto const replayed = json::parse(static_cast<MockSession*>(session_.get())->message);
+        EXPECT_EQ(replayed.at("ledger_index"), 33);
+        EXPECT_EQ(replayed.at("transaction").at("TransactionType"), "Payment");
+    });
+}
+
 TEST_F(RPCSubscribeHandlerTest, StreamsLedger)
 {
     static auto constexpr expectedOutput =
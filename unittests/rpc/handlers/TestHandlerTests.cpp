@@ -101,3 +101,86 @@ TEST_F(RPCTestHandlerTest, HandlerInnerErrorHandling)
         EXPECT_EQ(err.at("error").as_string(), "Very custom error");
     });
 }
+
+TEST_F(RPCTestHandlerTest, CoroutineHandlerSuccess)
+{
+    runSpawn([](auto& yield) {
+        auto const handler = AnyHandler{CoroutineHandlerFake{}};
+        auto const input = json::parse(R"({ 
+            "hello": "world", 
+            "limit": 10
+        })");
+
+        auto const output = handler.process(input, Context{std::ref(yield)});
+        ASSERT_TRUE(output);
+
+        auto const val = output.value();
+        EXPECT_EQ(val.as_object().at("computed").as_string(), "world_10");
+    });
+}
+
+TEST_F(RPCTestHandlerTest, CoroutineHandlerErrorHandling)
+{
+    runSpawn([](auto& yield) {
+        auto const handler = AnyHandler{CoroutineHandlerFake{}};
+        auto const input = json::parse(R"({ 
+            "hello": "not world", 
+            "limit": 10
+        })");
+
+        auto const output = handler.process(input, Context{std::ref(yield)});
+        ASSERT_FALSE(output);
+
+        auto const err = RPC::makeError(output.error());
+        EXPECT_EQ(err.at("error").as_string(), "invalidParams");
+    });
+}
+
+TEST_F(RPCTestHandlerTest, CoroutineHandlerSuccessFromCoroutine)
+{
+    runCoroutine([]() -> boost::asio::awaitable<void> {
+        auto const handler = AnyHandler{CoroutineHandlerFake{}};
+        auto const input = json::parse(R"({ 
+            "hello": "world", 
+            "limit": 10
+        })");
+
+        auto const output = co_await handler.processAsync(input, AsyncContext{});
+        EXPECT_TRUE(output);
+        if (output)
+            EXPECT_EQ(output.value().as_object().at("computed").as_string(), "world_10");
+    });
+}
+
+TEST_F(RPCTestHandlerTest, HandlerSuccessFromCoroutine)
+{
+    runCoroutine([]() -> boost::asio::awaitable<void> {
+        auto const handler = AnyHandler{HandlerFake{}};
+        auto const input = json::parse(R"({ 
+            "hello": "world", 
+            "limit": 10
+        })");
+
+        // runs on a stackful coroutine as HandlerFake takes a Context
+        auto const output = co_await handler.processAsync(input, AsyncContext{});
+        EXPECT_TRUE(output);
+        if (output)
+            EXPECT_EQ(output.value().as_object().at("computed").as_string(), "world_10");
+    });
+}
+
+TEST_F(RPCTestHandlerTest, HandlerInnerErrorHandlingFromCoroutine)
+{
+    runCoroutine([]() -> boost::asio::awaitable<void> {
+        auto const handler = AnyHandler{FailingHandlerFake{}};
+        auto const input = json::parse(R"({ 
+            "hello": "world", 
+            "limit": 10
+        })");
+
+        auto const output = co_await handler.processAsync(input, AsyncContext{});
+        EXPECT_FALSE(output);
+        if (not output)
+            EXPECT_EQ(RPC::makeError(output.error()).at("error").as_string(), "Very custom error");
+    });
+}
@@ -23,6 +23,10 @@
 #include <rpc/common/Specs.h>
 #include <rpc/common/Validators.h>
 
+#include <boost/asio/awaitable.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/this_coro.hpp>
+#include <boost/asio/use_awaitable.hpp>
 #include <boost/json/value.hpp>
 #include <boost/json/value_from.hpp>
 #include <boost/json/value_to.hpp>
@@ -92,6 +96,36 @@ public:
     }
 };
 
+// example handler that is a C++20 coroutine
+class CoroutineHandlerFake
+{
+public:
+    using Input = TestInput;
+    using Output = TestOutput;
+    using Result = RPC::HandlerReturnType<Output>;
+
+    RPC::RpcSpecConstRef
+    spec([[maybe_unused]] uint32_t apiVersion) const
+    {
+        using namespace RPC::validation;
+
+        static const auto rpcSpec = RPC::RpcSpec{
+            {"hello", Required{}, Type<std::string>{}, EqualTo{"world"}},
+            {"limit", Type<uint32_t>{}, Between<uint32_t>{0, 100}},  // optional field
+        };
+
+        return rpcSpec;
+    }
+
+    boost::asio::awaitable<Result>
+    process(Input input, [[maybe_unused]] RPC::AsyncContext const& ctx) const
+    {
+        // suspend once like a real handler awaiting the backend would
+        co_await boost::asio::post(co_await boost::asio::this_coro::executor, boost::asio::use_awaitable);
+        co_return Output{input.hello + '_' + std::to_string(input.limit.value_or(0))};
+    }
+};
+
 class NoInputHandlerFake
 {
 public:
@@ -134,15 +134,40 @@ public:
     }
 };
 
+class FakeTransaction
+{
+    std::string transaction_;
+    std::string metadata_;
+
+public:
+    std::string const&
+    transaction_blob() const
+    {
+        return transaction_;
+    }
+
+    std::string const&
+    metadata_blob() const
+    {
+        return metadata_;
+    }
+};
+
 class FakeTransactionsList
 {
-    std::size_t size_ = 0;
+    std::vector<FakeTransaction> transactions_;
 
 public:
     std::size_t
-    transactions_size()
+    transactions_size() const
     {
-        return size_;
+        return transactions_.size();
+    }
+
+    std::vector<FakeTransaction> const&
+    transactions() const
+    {
+        return transactions_;
     }
 };
 
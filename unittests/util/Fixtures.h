@@ -179,6 +179,25 @@ struct SyncAsioContextTest : virtual public NoLoggerFixture
         ctx.reset();
     }
 
+    template <typename F>
+    void
+    runCoroutine(F&& f)
+    {
+        auto called = false;
+        auto work = std::optional<boost::asio::io_context::work>{ctx};
+        boost::asio::co_spawn(
+            ctx,
+            [&]() -> boost::asio::awaitable<void> {
+                co_await f();
+                called = true;
+                work.reset();
+            },
+            boost::asio::detached);
+        ctx.run();
+        ASSERT_TRUE(called);
+        ctx.reset();
+    }
+
 protected:
     boost::asio::io_context ctx;
 };
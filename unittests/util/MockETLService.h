@@ -19,10 +19,14 @@
 
 #pragma once
 
+#include <boost/asio/spawn.hpp>
 #include <boost/json.hpp>
 #include <gmock/gmock.h>
 
 #include <chrono>
+#include <memory>
+#include <optional>
+#include <string>
 
 struct MockETLService
 {
@@ -31,4 +35,11 @@ struct MockETLService
     MOCK_METHOD(std::uint32_t, lastPublishAgeSeconds, (), (const));
     MOCK_METHOD(std::uint32_t, lastCloseAgeSeconds, (), (const));
     MOCK_METHOD(bool, isAmendmentBlocked, (), (const));
+    MOCK_METHOD(std::shared_ptr<std::string const>, getCommittedLedger, (std::uint32_t), (const));
+    MOCK_METHOD(std::optional<std::uint32_t>, getLatestCommittedLedger, (), (const));
+    MOCK_METHOD(
+        void,
+        waitForCommittedLedger,
+        (std::uint32_t, std::chrono::steady_clock::time_point, boost::asio::yield_context),
+        (const));
 };
@@ -23,10 +23,17 @@
 
 #include <gmock/gmock.h>
 
+#include <functional>
 #include <optional>
+#include <vector>
 
 struct MockLedgerFetcher
 {
     MOCK_METHOD(std::optional<FakeFetchResponse>, fetchData, (uint32_t), ());
     MOCK_METHOD(std::optional<FakeFetchResponse>, fetchDataAndDiff, (uint32_t), ());
+    MOCK_METHOD(
+        std::size_t,
+        fetchDataAndDiffPipelined,
+        (std::vector<uint32_t> const&, std::uint32_t, std::function<bool(uint32_t, FakeFetchResponse&&)>),
+        ());
 };
@@ -45,7 +45,7 @@ public:
 
     template <typename Fn>
     bool
-    post(Fn&& func, std::string const& ip)
+    post(Fn&& func, std::string const& ip, std::string_view method)
     {
         boost::asio::spawn(ioc_, [handler = std::move(func)](auto yield) mutable { handler(yield); });
         return true;
@@ -61,6 +61,8 @@ public:
     MOCK_METHOD(void, notifyTooBusy, (), ());
     MOCK_METHOD(void, notifyUnknownCommand, (), ());
     MOCK_METHOD(void, notifyInternalError, (), ());
+    MOCK_METHOD(void, notifyMessagesDropped, (std::uint64_t), ());
+    MOCK_METHOD(void, notifySlowConsumerDisconnected, (), ());
     MOCK_METHOD(RPC::Result, buildResponse, (Web::Context const&), ());
 
 private:
@@ -72,7 +74,11 @@ private:
 struct MockRPCEngine
 {
 public:
-    MOCK_METHOD(bool, post, (std::function<void(boost::asio::yield_context)>&&, std::string const&), ());
+    MOCK_METHOD(
+        bool,
+        post,
+        (std::function<void(boost::asio::yield_context)>&&, std::string const&, std::string_view),
+        ());
     MOCK_METHOD(void, notifyComplete, (std::string const&, std::chrono::microseconds const&), ());
     MOCK_METHOD(void, notifyErrored, (std::string const&), ());
     MOCK_METHOD(void, notifyForwarded, (std::string const&), ());
@@ -82,5 +88,7 @@ public:
     MOCK_METHOD(void, notifyTooBusy, (), ());
     MOCK_METHOD(void, notifyUnknownCommand, (), ());
     MOCK_METHOD(void, notifyInternalError, (), ());
+    MOCK_METHOD(void, notifyMessagesDropped, (std::uint64_t), ());
+    MOCK_METHOD(void, notifySlowConsumerDisconnected, (), ());
     MOCK_METHOD(RPC::Result, buildResponse, (Web::Context const&), ());
 };
@@ -20,6 +20,8 @@
 #pragma once
 
 #include <ripple/ledger/ReadView.h>
+#include <subscriptions/ReplayBuffer.h>
+#include <subscriptions/TransactionFilter.h>
 #include <webserver/interface/ConnectionBase.h>
 
 #include <boost/asio/spawn.hpp>
@@ -50,12 +52,24 @@ public:
 
     MOCK_METHOD(void, unsubLedger, (session_ptr), ());
 
-    MOCK_METHOD(void, subTransactions, (session_ptr), ());
+    MOCK_METHOD(
+        std::optional<boost::json::object>,
+        subReplay,
+        (boost::asio::yield_context&, session_ptr, std::uint32_t, ReplayRequest const&),
+        ());
+
+    MOCK_METHOD(void, subTransactions, (session_ptr, TransactionFilter const&), ());
 
     MOCK_METHOD(void, unsubTransactions, (session_ptr), ());
 
     MOCK_METHOD(void, pubTransaction, (Backend::TransactionAndMetadata const&, ripple::LedgerInfo const&), ());
 
+    MOCK_METHOD(
+        void,
+        pubTransactions,
+        (std::vector<Backend::TransactionAndMetadata> const&, ripple::LedgerInfo const&),
+        ());
+
     MOCK_METHOD(void, subAccount, (ripple::AccountID const&, session_ptr&), ());
 
     MOCK_METHOD(void, unsubAccount, (ripple::AccountID const&, session_ptr const&), ());
@@ -81,6 +81,14 @@ class WebSocketSyncClient
     boost::beast::websocket::stream<tcp::socket> ws_{ioc_};
 
 public:
+    void
+    enableCompression()
+    {
+        boost::beast::websocket::permessage_deflate pmd;
+        pmd.client_enable = true;
+        ws_.set_option(pmd);
+    }
+
     void
     connect(std::string const& host, std::string const& port)
     {
@@ -124,6 +132,15 @@ public:
 
         return boost::beast::buffers_to_string(buffer.data());
     }
+
+    std::string
+    syncRead()
+    {
+        boost::beast::flat_buffer buffer;
+        ws_.read(buffer);
+
+        return boost::beast::buffers_to_string(buffer.data());
+    }
 };
 
 struct HttpsSyncClient
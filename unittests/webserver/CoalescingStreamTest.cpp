@@ -0,0 +1,143 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <webserver/details/CoalescingStream.h>
+
+#include <gtest/gtest.h>
+
+#include <string>
+#include <vector>
+
+using namespace Server::detail;
+
+namespace {
+
+// records every write it is asked to do
+struct RecordingStream
+{
+    using executor_type = boost::asio::io_context::executor_type;
+
+    boost::asio::io_context& ctx;
+    std::vector<std::string> writes;
+
+    executor_type
+    get_executor() noexcept
+    {
+        return ctx.get_executor();
+    }
+
+    template <class MutableBufferSequence, class ReadHandler>
+    void
+    async_read_some(MutableBufferSequence const&, ReadHandler&& handler)
+    {
+        boost::asio::post(ctx, boost::beast::bind_front_handler(std::move(handler), boost::system::error_code{}, 0));
+    }
+
+    template <class ConstBufferSequence, class WriteHandler>
+    void
+    async_write_some(ConstBufferSequence const& buffers, WriteHandler&& handler)
+    {
+        writes.push_back(boost::beast::buffers_to_string(buffers));
+        auto const size = boost::asio::buffer_size(buffers);
+        boost::asio::post(ctx, boost::beast::bind_front_handler(std::move(handler), boost::system::error_code{}, size));
+    }
+};
+
+}  // namespace
+
+class CoalescingStreamTest : public SyncAsioContextTest
+{
+protected:
+    CoalescingStream<RecordingStream> stream{ctx};
+
+    void
+    write(std::string const& data, boost::asio::yield_context yield)
+    {
+        auto const written = boost::asio::async_write(stream, boost::asio::buffer(data), yield);
+        EXPECT_EQ(written, data.size());
+    }
+};
+
+TEST_F(CoalescingStreamTest, WritesThroughWhenNotCorked)
+{
+    runSpawn([this](auto yield) {
+        write("first", yield);
+        write("second", yield);
+    });
+
+    EXPECT_EQ(stream.next_layer().writes, (std::vector<std::string>{"first", "second"}));
+    EXPECT_EQ(stream.pendingBytes(), 0);
+}
+
+TEST_F(CoalescingStreamTest, CorkedWritesGoOutWithNextWrite)
+{
+    runSpawn([this](auto yield) {
+        stream.cork();
+        write("first", yield);
+        stream.cork();
+        write("second", yield);
+
+        EXPECT_TRUE(stream.next_layer().writes.empty());
+        EXPECT_EQ(stream.pendingBytes(), 11);
+
+        write("third", yield);
+    });
+
+    EXPECT_EQ(stream.next_layer().writes, (std::vector<std::string>{"firstsecondthird"}));
+    EXPECT_EQ(stream.pendingBytes(), 0);
+}
+
+TEST_F(CoalescingStreamTest, CorkAppliesToOneWriteOnly)
+{
+    runSpawn([this](auto yield) {
+        stream.cork();
+        write("first", yield);
+        write("second", yield);
+        write("third", yield);
+    });
+
+    EXPECT_EQ(stream.next_layer().writes, (std::vector<std::string>{"firstsecond", "third"}));
+}
+
+TEST_F(CoalescingStreamTest, SubstituteReplacesEmptyMessage)
+{
+    runSpawn([this](auto yield) {
+        stream.substitute(std::make_shared<std::string const>("frame"));
+        // a control frame written meanwhile is not replaced
+        write(std::string{"\x8a\x00", 2}, yield);
+        write(std::string{"\x81\x00", 2}, yield);
+        write("next", yield);
+    });
+
+    EXPECT_EQ(stream.next_layer().writes, (std::vector<std::string>{std::string{"\x8a\x00", 2}, "frame", "next"}));
+}
+
+TEST_F(CoalescingStreamTest, SubstituteCorked)
+{
+    runSpawn([this](auto yield) {
+        stream.substitute(std::make_shared<std::string const>("frame"));
+        stream.cork();
+        // an empty message compressed by the websocket stream
+        write(std::string{"\xc1\x02\x02\x00", 4}, yield);
+        write("next", yield);
+    });
+
+    EXPECT_EQ(stream.next_layer().writes, (std::vector<std::string>{"framenext"}));
+}
@@ -28,10 +28,13 @@ using namespace std::chrono_literals;
 
 constexpr static auto MINSEQ = 10;
 constexpr static auto MAXSEQ = 30;
+constexpr static auto CACHE_PEER_CONFIG = R"({"cache": {"allowed_peers": ["localhost.fake.ip"]}})";
+constexpr static auto LEDGER_FEED_PEER_CONFIG = R"({"ledger_feed": {"allowed_peers": ["localhost.fake.ip"]}})";
 
 struct MockWsBase : public Server::ConnectionBase
 {
     std::string message;
+    std::shared_ptr<std::string const> sharedData;
     boost::beast::http::status lastStatus = boost::beast::http::status::unknown;
 
     void
@@ -48,6 +51,23 @@ struct MockWsBase : public Server::ConnectionBase
         lastStatus = status;
     }
 
+    void
+    sendBinary(std::string&& data, boost::beast::http::status status = boost::beast::http::status::ok) override
+    {
+        message += data;
+        lastStatus = status;
+    }
+
+    void
+    sendBinary(
+        std::shared_ptr<std::string const> data,
+        boost::beast::http::status status = boost::beast::http::status::ok) override
+    {
+        message += *data;
+        lastStatus = status;
+        sharedData = std::move(data);
+    }
+
     MockWsBase(util::TagDecoratorFactory const& factory) : Server::ConnectionBase(factory, "localhost.fake.ip")
     {
     }
@@ -76,6 +96,13 @@ protected:
         MockBackendTest::TearDown();
     }
 
+    std::shared_ptr<RPCServerHandler<MockAsyncRPCEngine, MockETLService>>
+    makeHandler(char const* config) const
+    {
+        return std::make_shared<RPCServerHandler<MockAsyncRPCEngine, MockETLService>>(
+            clio::Config{boost::json::parse(config)}, mockBackendPtr, rpcEngine, etl, subManager);
+    }
+
     std::shared_ptr<MockAsyncRPCEngine> rpcEngine;
     std::shared_ptr<MockETLService> etl;
     std::shared_ptr<SubscriptionManager> subManager;
@@ -118,6 +145,29 @@ TEST_F(WebRPCServerHandlerTest, HTTPDefaultPath)
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
 
+TEST_F(WebRPCServerHandlerTest, RequestIsParsedIntoItsOwnArena)
+{
+    static auto constexpr request = R"({
+                                        "method": "server_info",
+                                        "params": [{"ledger_index": 30}]
+                                    })";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_)).WillOnce([](Web::Context const& ctx) {
+        EXPECT_NE(ctx.params.storage().get(), boost::json::storage_ptr{}.get());
+        EXPECT_EQ(ctx.params.at("ledger_index").as_int64(), 30);
+        return RPC::Result{boost::json::object{}};
+    });
+    EXPECT_CALL(*rpcEngine, notifyComplete("server_info", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(std::move(request), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(boost::json::parse(session->message).as_object().contains("result"));
+}
+
 TEST_F(WebRPCServerHandlerTest, WsNormalPath)
 {
     session->upgraded = true;
@@ -153,6 +203,51 @@ TEST_F(WebRPCServerHandlerTest, WsNormalPath)
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
 
+TEST_F(WebRPCServerHandlerTest, HTTPCachedResultIsWrittenAsIs)
+{
+    static auto constexpr request = R"({
+                                        "method": "ledger",
+                                        "params": [{"ledger_index": 30}]
+                                    })";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(
+            RPC::SerializedResult{std::make_shared<std::string const>(R"({"ledger_index":30,"validated":true})")}));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(std::move(request), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(session->message.starts_with(
+        R"({"result":{"ledger_index":30,"validated":true,"status":"success"},"warnings":[)"));
+    EXPECT_TRUE(boost::json::parse(session->message).as_object().contains("warnings"));
+}
+
+TEST_F(WebRPCServerHandlerTest, WsCachedResultIsWrittenAsIs)
+{
+    session->upgraded = true;
+    static auto constexpr request = R"({
+                                        "command": "ledger",
+                                        "ledger_index": 30,
+                                        "id": 99
+                                    })";
+
+    mockBackendPtr->updateRange(MINSEQ);  // min
+    mockBackendPtr->updateRange(MAXSEQ);  // max
+
+    EXPECT_CALL(*rpcEngine, buildResponse(testing::_))
+        .WillOnce(testing::Return(RPC::SerializedResult{std::make_shared<std::string const>("{}")}));
+    EXPECT_CALL(*rpcEngine, notifyComplete("ledger", testing::_)).Times(1);
+    EXPECT_CALL(*etl, lastCloseAgeSeconds()).WillOnce(testing::Return(45));
+
+    (*handler)(std::move(request), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_TRUE(session->message.starts_with(R"({"result":{},"id":99,"status":"success","type":"response",)"));
+}
+
 TEST_F(WebRPCServerHandlerTest, HTTPForwardedPath)
 {
     static auto constexpr request = R"({
@@ -815,3 +910,153 @@ TEST_F(WebRPCServerHandlerTest, WsRequestNotJson)
     (*handler)(std::move(request), session);
     EXPECT_EQ(boost::json::parse(session->message), boost::json::parse(response));
 }
+
+TEST_F(WebRPCServerHandlerTest, LedgerFeedServesCommittedLedger)
+{
+    auto const ledger = std::make_shared<std::string const>(std::string{"\0\1ledger", 8});
+
+    auto const peerHandler = makeHandler(LEDGER_FEED_PEER_CONFIG);
+
+    EXPECT_TRUE(peerHandler->isBinaryTarget(clio::detail::LedgerFeed::target(MAXSEQ)));
+    EXPECT_CALL(*etl, getCommittedLedger(MAXSEQ)).WillOnce(testing::Return(ledger));
+
+    peerHandler->serveBinary(clio::detail::LedgerFeed::target(MAXSEQ), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->message, *ledger);
+    EXPECT_EQ(session->sharedData, ledger);  // sent as is, not copied
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+}
+
+TEST_F(WebRPCServerHandlerTest, LedgerFeedWaitsForLedger)
+{
+    auto const ledger = std::make_shared<std::string const>("ledger");
+    auto const peerHandler = makeHandler(LEDGER_FEED_PEER_CONFIG);
+
+    EXPECT_CALL(*etl, getCommittedLedger(MAXSEQ))
+        .WillOnce(testing::Return(nullptr))
+        .WillOnce(testing::Return(nullptr))
+        .WillOnce(testing::Return(ledger));
+    EXPECT_CALL(*etl, getLatestCommittedLedger()).Times(2).WillRepeatedly(testing::Return(MAXSEQ - 1));
+    // woken by the feed instead of polling it
+    EXPECT_CALL(*etl, waitForCommittedLedger(MAXSEQ, testing::_, testing::_)).Times(2);
+
+    peerHandler->serveBinary(clio::detail::LedgerFeed::target(MAXSEQ), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->message, *ledger);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+}
+
+TEST_F(WebRPCServerHandlerTest, LedgerFeedLedgerTooOld)
+{
+    EXPECT_CALL(*etl, getCommittedLedger(MINSEQ)).WillOnce(testing::Return(nullptr));
+    EXPECT_CALL(*etl, getLatestCommittedLedger()).WillOnce(testing::Return(MAXSEQ));
+
+    makeHandler(LEDGER_FEED_PEER_CONFIG)->serveBinary(clio::detail::LedgerFeed::target(MINSEQ), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::not_found);
+}
+
+TEST_F(WebRPCServerHandlerTest, LedgerFeedMalformedRequest)
+{
+    makeHandler(LEDGER_FEED_PEER_CONFIG)->serveBinary("/ledger_feed?ledger=abc", session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::bad_request);
+    EXPECT_FALSE(handler->isBinaryTarget("/ledger"));
+}
+
+TEST_F(WebRPCServerHandlerTest, LedgerFeedForbiddenForUnknownPeer)
+{
+    handler->serveBinary(clio::detail::LedgerFeed::target(MAXSEQ), session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::forbidden);
+}
+
+TEST_F(WebRPCServerHandlerTest, CacheServesPageOfRequestedLedger)
+{
+    auto const key = ripple::uint256{"1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+    mockBackendPtr->cache().update({{key, {1, 2, 3}}}, MAXSEQ);
+    mockBackendPtr->cache().setFull();
+    auto const peerHandler = makeHandler(CACHE_PEER_CONFIG);
+
+    auto const request = Backend::CachePage::Request{MAXSEQ, Backend::firstKey, {}};
+    EXPECT_TRUE(handler->isBinaryTarget(request.target()));
+
+    peerHandler->serveBinary(request.target(), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::ok);
+
+    auto const page = Backend::CachePage::deserialize(session->message, MAXSEQ);
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 1);
+    EXPECT_EQ(page->objects.front().key, key);
+}
+
+TEST_F(WebRPCServerHandlerTest, CacheServesRequestedLedgerAfterMovingAhead)
+{
+    auto const key = ripple::uint256{"1B8590C01B0006EDFA9ED60296DD052DC5E90F99659B25014D08E1BC983515BC"};
+    mockBackendPtr->updateRange(MINSEQ);
+    mockBackendPtr->updateRange(MAXSEQ);
+    mockBackendPtr->cache().update({{key, {1, 2, 3}}}, MAXSEQ);
+    mockBackendPtr->cache().setFull();
+    auto const peerHandler = makeHandler(CACHE_PEER_CONFIG);
+    auto const request = Backend::CachePage::Request{MAXSEQ, Backend::firstKey, {}};
+
+    peerHandler->serveBinary(request.target(), session);
+    std::this_thread::sleep_for(200ms);
+    ASSERT_EQ(session->lastStatus, boost::beast::http::status::ok);
+    auto page = Backend::CachePage::deserialize(session->message, MAXSEQ);
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 1);
+
+    // the next ledger changes the object while the peer is still downloading the previous one
+    mockBackendPtr->updateRange(MAXSEQ + 1);
+    mockBackendPtr->cache().update({{key, {4, 5}}}, MAXSEQ + 1);
+    auto const rawBackendPtr = static_cast<MockBackend*>(mockBackendPtr.get());
+    EXPECT_CALL(*rawBackendPtr, doFetchSuccessorKey(testing::_, MAXSEQ, testing::_))
+        .WillOnce(testing::Return(key))
+        .WillOnce(testing::Return(std::nullopt));
+    EXPECT_CALL(*rawBackendPtr, doFetchLedgerObjects(std::vector<ripple::uint256>{key}, MAXSEQ, testing::_))
+        .WillOnce(testing::Return(std::vector<Backend::Blob>{{1, 2, 3}}));
+
+    session->message.clear();
+    peerHandler->serveBinary(request.target(), session);
+    std::this_thread::sleep_for(200ms);
+    ASSERT_EQ(session->lastStatus, boost::beast::http::status::ok);
+    page = Backend::CachePage::deserialize(session->message, MAXSEQ);
+    ASSERT_TRUE(page.has_value());
+    ASSERT_EQ(page->objects.size(), 1);
+    EXPECT_EQ(page->objects.front().blob, (Backend::Blob{1, 2, 3}));
+}
+
+TEST_F(WebRPCServerHandlerTest, CacheDoesNotServeLedgerNoLongerStored)
+{
+    mockBackendPtr->updateRange(MINSEQ);
+    mockBackendPtr->updateRange(MAXSEQ);
+    mockBackendPtr->cache().update({{Backend::firstKey, {1}}}, MAXSEQ);
+    mockBackendPtr->cache().setFull();
+    auto const peerHandler = makeHandler(CACHE_PEER_CONFIG);
+
+    peerHandler->serveBinary(Backend::CachePage::Request{MINSEQ - 1, Backend::firstKey, {}}.target(), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::conflict);
+}
+
+TEST_F(WebRPCServerHandlerTest, CacheNotAtRequestedLedgerYet)
+{
+    mockBackendPtr->updateRange(MINSEQ);
+    mockBackendPtr->updateRange(MAXSEQ);
+    mockBackendPtr->cache().update({{Backend::firstKey, {1}}}, MAXSEQ);
+    mockBackendPtr->cache().setFull();
+    auto const peerHandler = makeHandler(CACHE_PEER_CONFIG);
+
+    peerHandler->serveBinary(Backend::CachePage::Request{MAXSEQ + 1, Backend::firstKey, {}}.target(), session);
+    std::this_thread::sleep_for(200ms);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::service_unavailable);
+}
+
+TEST_F(WebRPCServerHandlerTest, CacheForbiddenForUnknownPeer)
+{
+    mockBackendPtr->cache().update({{Backend::firstKey, {1}}}, MAXSEQ);
+    mockBackendPtr->cache().setFull();
+
+    handler->serveBinary(Backend::CachePage::Request{MAXSEQ, Backend::firstKey, {}}.target(), session);
+    EXPECT_EQ(session->lastStatus, boost::beast::http::status::forbidden);
+}
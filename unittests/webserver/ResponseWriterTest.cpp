@@ -0,0 +1,126 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <webserver/details/ResponseWriter.h>
+
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+using namespace Server::detail;
+
+namespace json = boost::json;
+
+class ResponseWriterTest : public NoLoggerFixture
+{
+};
+
+TEST_F(ResponseWriterTest, Empty)
+{
+    EXPECT_EQ(ResponseWriter{}.finish(), "{}");
+}
+
+TEST_F(ResponseWriterTest, MatchesSerializedObject)
+{
+    auto const result = json::parse(R"({"ledger_index":1,"hash":"AB\"CD","nested":{"list":[1,2,{"a":null}]}})");
+
+    ResponseWriter writer;
+    writer.field("result", result.as_object());
+    writer.field("status", "success");
+    writer.field("warnings", json::array{json::object{{"id", 2001}}});
+
+    auto expected = json::object{};
+    expected["result"] = result;
+    expected["status"] = "success";
+    expected["warnings"] = json::array{json::object{{"id", 2001}}};
+
+    EXPECT_EQ(std::move(writer).finish(), json::serialize(expected));
+}
+
+TEST_F(ResponseWriterTest, LargeValueIsWrittenInChunks)
+{
+    json::array large;
+    for (auto i = 0; i < 10000; ++i)
+        large.push_back(json::object{{"index", i}, {"data", std::string(16, 'A')}});
+
+    ResponseWriter writer;
+    writer.field("result", large);
+
+    EXPECT_EQ(std::move(writer).finish(), json::serialize(json::object{{"result", large}}));
+}
+
+TEST_F(ResponseWriterTest, FieldsOfObject)
+{
+    auto const forwarded = json::parse(R"({"result":{"index":1},"forwarded":true,"weird\"key":"x"})").as_object();
+
+    ResponseWriter writer;
+    writer.fields(forwarded);
+    writer.field("type", "response");
+
+    auto expected = forwarded;
+    expected["type"] = "response";
+
+    EXPECT_EQ(json::parse(std::move(writer).finish()), expected);
+}
+
+TEST_F(ResponseWriterTest, AddLoadWarningAppendsToWarnings)
+{
+    ResponseWriter writer;
+    writer.field("result", json::object{{"text", "with ] and \"warnings\":[ inside"}});
+    writer.field("warnings", json::array{RPC::makeWarning(RPC::warnRPC_CLIO)});
+    auto msg = std::move(writer).finish();
+
+    auto expected = json::parse(msg).as_object();
+    expected["warnings"].as_array().push_back(RPC::makeWarning(RPC::warnRPC_RATE_LIMIT));
+    expected["warning"] = "load";
+
+    addLoadWarning(msg);
+    EXPECT_EQ(msg, json::serialize(expected));
+}
+
+TEST_F(ResponseWriterTest, AddLoadWarningToEmptyWarnings)
+{
+    std::string msg = R"({"result":{},"warnings":[]})";
+    addLoadWarning(msg);
+
+    auto const expected = json::object{
+        {"result", json::object{}},
+        {"warnings", json::array{RPC::makeWarning(RPC::warnRPC_RATE_LIMIT)}},
+        {"warning", "load"}};
+
+    EXPECT_EQ(msg, json::serialize(expected));
+}
+
+TEST_F(ResponseWriterTest, AddLoadWarningFallsBackToParsing)
+{
+    // warnings are not the last field
+    std::string msg = R"({"warnings":[{"id":2001}],"result":{"values":[1]}})";
+    addLoadWarning(msg);
+
+    auto const response = json::parse(msg).as_object();
+    EXPECT_EQ(response.at("warning").as_string(), "load");
+    ASSERT_EQ(response.at("warnings").as_array().size(), 2);
+    EXPECT_EQ(response.at("warnings").as_array().at(1), RPC::makeWarning(RPC::warnRPC_RATE_LIMIT));
+    EXPECT_EQ(response.at("result"), json::parse(R"({"values":[1]})"));
+
+    // no warnings at all
+    msg = R"({"result":{}})";
+    addLoadWarning(msg);
+    EXPECT_EQ(json::parse(msg).at("warnings").as_array().size(), 1);
+}
@@ -25,6 +25,7 @@
 #include <fmt/core.h>
 #include <gtest/gtest.h>
 
+#include <atomic>
 #include <optional>
 
 constexpr static auto JSONData = R"JSON(
@@ -58,6 +59,43 @@ constexpr static auto JSONDataOverload = R"JSON(
     }
 )JSON";
 
+// the slow consumer policy is substituted by fmt
+constexpr static auto JSONDataSlowConsumer = R"JSON(
+    {{
+        "server":{{
+            "ip":"0.0.0.0",
+            "port":8888
+        }},
+        "dos_guard": {{
+            "max_queued_messages": 2,
+            "slow_consumer_policy": "{}"
+        }}
+    }}
+)JSON";
+
+constexpr static auto JSONDataQueuedBytes = R"JSON(
+    {
+        "server":{
+            "ip":"0.0.0.0",
+            "port":8888
+        },
+        "dos_guard": {
+            "max_queued_bytes": 10,
+            "slow_consumer_policy": "drop_oldest"
+        }
+    }
+)JSON";
+
+constexpr static auto JSONDataCompression = R"JSON(
+    {
+        "server":{
+            "ip":"0.0.0.0",
+            "port":8888,
+            "ws_compression": true
+        }
+    }
+)JSON";
+
 // for testing, we use a self-signed certificate
 std::optional<ssl::context>
 parseCertsForTest()
@@ -141,15 +179,11 @@ protected:
         NoLoggerFixture::SetUp();
     }
 
-    // this ctx is for dos timer
-    boost::asio::io_context ctxSync;
     clio::Config cfg{boost::json::parse(JSONData)};
-    clio::IntervalSweepHandler sweepHandler = clio::IntervalSweepHandler{cfg, ctxSync};
-    clio::DOSGuard dosGuard = clio::DOSGuard{cfg, sweepHandler};
+    clio::DOSGuard dosGuard = clio::DOSGuard{cfg};
 
     clio::Config cfgOverload{boost::json::parse(JSONDataOverload)};
-    clio::IntervalSweepHandler sweepHandlerOverload = clio::IntervalSweepHandler{cfgOverload, ctxSync};
-    clio::DOSGuard dosGuardOverload = clio::DOSGuard{cfgOverload, sweepHandlerOverload};
+    clio::DOSGuard dosGuardOverload = clio::DOSGuard{cfgOverload};
     // this ctx is for http server
     boost::asio::io_context ctx;
 
@@ -188,6 +222,69 @@ public:
     }
 };
 
+// publishes 5 stream messages before answering each request; the client reads them only afterwards
+class StreamingExecutor
+{
+public:
+    std::atomic_uint64_t dropped = 0;
+    std::atomic_bool disconnected = false;
+
+    void
+    operator()(std::string const& reqStr, std::shared_ptr<Server::ConnectionBase> const& ws)
+    {
+        for (auto i = 1; i <= 5; ++i)
+            ws->send(std::make_shared<std::string>(std::to_string(i)));
+        ws->send(std::string(reqStr), http::status::ok);
+    }
+
+    void
+    operator()(boost::beast::error_code ec, std::shared_ptr<Server::ConnectionBase> const& ws)
+    {
+    }
+
+    void
+    onMessagesDropped(std::size_t count)
+    {
+        dropped += count;
+    }
+
+    void
+    onSlowConsumerDisconnected()
+    {
+        disconnected = true;
+    }
+};
+
+// publishes two small stream messages at once, then one that is over the byte limit of the queue
+class BurstExecutor
+{
+public:
+    std::atomic_uint64_t dropped = 0;
+
+    void
+    operator()(std::string const& reqStr, std::shared_ptr<Server::ConnectionBase> const& ws)
+    {
+        ws->sendMessages({std::make_shared<std::string>("1"), std::make_shared<std::string>("2")});
+        ws->send(std::make_shared<std::string>(std::string(100, 'x')));
+    }
+
+    void
+    operator()(boost::beast::error_code ec, std::shared_ptr<Server::ConnectionBase> const& ws)
+    {
+    }
+
+    void
+    onMessagesDropped(std::size_t count)
+    {
+        dropped += count;
+    }
+
+    void
+    onSlowConsumerDisconnected()
+    {
+    }
+};
+
 TEST_F(WebServerTest, Http)
 {
     auto e = std::make_shared<EchoExecutor>();
@@ -322,3 +419,101 @@ TEST_F(WebServerTest, WsPayloadOverload)
         res,
         R"({"payload":"aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa","warning":"load","warnings":[{"id":2003,"message":"You are about to be rate limited"}]})");
 }
+
+TEST_F(WebServerTest, WsMessagesInOrder)
+{
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(cfg, ctx, std::nullopt, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    for (auto const* expected : {"2", "3", "4", "5", "{}"})
+        EXPECT_EQ(wsClient.syncRead(), expected);
+    wsClient.disconnect();
+    EXPECT_EQ(e->dropped, 0);
+}
+
+TEST_F(WebServerTest, WsSlowConsumerDropStream)
+{
+    clio::Config const config{boost::json::parse(fmt::format(JSONDataSlowConsumer, "drop_stream"))};
+    clio::DOSGuard guard{config};
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, guard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    // the first message is already being written; the response is kept over the newer stream messages
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    EXPECT_EQ(wsClient.syncRead(), "{}");
+    wsClient.disconnect();
+    EXPECT_EQ(e->dropped, 4);
+    EXPECT_FALSE(e->disconnected);
+}
+
+TEST_F(WebServerTest, WsSlowConsumerDropOldest)
+{
+    clio::Config const config{boost::json::parse(fmt::format(JSONDataSlowConsumer, "drop_oldest"))};
+    clio::DOSGuard guard{config};
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, guard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    EXPECT_EQ(wsClient.syncRead(), "{}");
+    wsClient.disconnect();
+    EXPECT_EQ(e->dropped, 4);
+}
+
+TEST_F(WebServerTest, WsSlowConsumerKeepsMessageOfCorkedWrite)
+{
+    clio::Config const config{boost::json::parse(JSONDataQueuedBytes)};
+    clio::DOSGuard guard{config};
+    auto e = std::make_shared<BurstExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, guard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    // the first message is held back until the second is written, so only the large one can be dropped
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    EXPECT_EQ(wsClient.syncRead(), "2");
+    wsClient.disconnect();
+    EXPECT_EQ(e->dropped, 1);
+}
+
+TEST_F(WebServerTest, WsSlowConsumerDisconnect)
+{
+    clio::Config const config{boost::json::parse(fmt::format(JSONDataSlowConsumer, "disconnect"))};
+    clio::DOSGuard guard{config};
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, guard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    EXPECT_THROW(wsClient.syncRead(), boost::system::system_error);
+    EXPECT_TRUE(e->disconnected);
+}
+
+TEST_F(WebServerTest, WsCompressedMessagesInOrder)
+{
+    clio::Config const config{boost::json::parse(JSONDataCompression)};
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.enableCompression();
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    for (auto const* expected : {"2", "3", "4", "5", "{}"})
+        EXPECT_EQ(wsClient.syncRead(), expected);
+    wsClient.disconnect();
+}
+
+TEST_F(WebServerTest, WsCompressionEnabledClientWithoutDeflate)
+{
+    clio::Config const config{boost::json::parse(JSONDataCompression)};
+    auto e = std::make_shared<StreamingExecutor>();
+    auto const server = Server::make_HttpServer(config, ctx, std::nullopt, dosGuard, e);
+    WebSocketSyncClient wsClient;
+    wsClient.connect("localhost", "8888");
+    EXPECT_EQ(wsClient.syncPost(R"({})"), "1");
+    for (auto const* expected : {"2", "3", "4", "5", "{}"})
+        EXPECT_EQ(wsClient.syncRead(), expected);
+    wsClient.disconnect();
+}
@@ -0,0 +1,116 @@
+//------------------------------------------------------------------------------
+/*
+    This file is part of clio: https://github.com/XRPLF/clio
+    Copyright (c) 2023, the clio developers.
+
+    Permission to use, copy, modify, and distribute this software for any
+    purpose with or without fee is hereby granted, provided that the above
+    copyright notice and this permission notice appear in all copies.
+
+    THE  SOFTWARE IS PROVIDED "AS IS" AND THE AUTHOR DISCLAIMS ALL WARRANTIES
+    WITH  REGARD  TO  THIS  SOFTWARE  INCLUDING  ALL  IMPLIED  WARRANTIES  OF
+    MERCHANTABILITY  AND  FITNESS. IN NO EVENT SHALL THE AUTHOR BE LIABLE FOR
+    ANY  SPECIAL,  DIRECT,  INDIRECT, OR CONSEQUENTIAL DAMAGES OR ANY DAMAGES
+    WHATSOEVER  RESULTING  FROM  LOSS  OF USE, DATA OR PROFITS, WHETHER IN AN
+    ACTION  OF  CONTRACT, NEGLIGENCE OR OTHER TORTIOUS ACTION, ARISING OUT OF
+    OR IN CONNECTION WITH THE USE OR PERFORMANCE OF THIS SOFTWARE.
+*/
+//==============================================================================
+
+#include <util/Fixtures.h>
+#include <webserver/details/WsCompression.h>
+
+#include <boost/beast/zlib/inflate_stream.hpp>
+#include <boost/json/parse.hpp>
+#include <gtest/gtest.h>
+
+using namespace Server;
+
+namespace {
+
+// inflate the payload of a frame built by makeFrame, as a client would
+std::string
+inflatePayload(std::string const& frame)
+{
+    namespace zlib = boost::beast::zlib;
+
+    auto const length = static_cast<unsigned char>(frame[1]);
+    auto const headerSize = length < 126 ? 2 : (length == 126 ? 4 : 10);
+    auto payload = frame.substr(headerSize) + std::string{"\x00\x00\xff\xff", 4};
+
+    zlib::inflate_stream inflater;
+    inflater.reset(15);
+
+    std::string out(1024 * 1024, '\0');
+    zlib::z_params zs;
+    zs.next_in = payload.data();
+    zs.avail_in = payload.size();
+    zs.next_out = out.data();
+    zs.avail_out = out.size();
+
+    boost::beast::error_code ec;
+    inflater.write(zs, zlib::Flush::sync, ec);
+    EXPECT_FALSE(ec) << ec.message();
+    out.resize(zs.total_out);
+    return out;
+}
+
+}  // namespace
+
+class WsCompressionTest : public NoLoggerFixture
+{
+};
+
+TEST_F(WsCompressionTest, DisabledByDefault)
+{
+    EXPECT_FALSE(WsCompression{}.isEnabled());
+    EXPECT_FALSE(WsCompression{clio::Config{boost::json::parse("{}")}}.isEnabled());
+    EXPECT_TRUE(WsCompression{clio::Config{boost::json::parse(R"({"ws_compression": true})")}}.isEnabled());
+}
+
+TEST_F(WsCompressionTest, CanShareFrames)
+{
+    EXPECT_TRUE(WsCompression::canShareFrames("permessage-deflate; server_no_context_takeover"));
+    EXPECT_TRUE(WsCompression::canShareFrames(
+        "permessage-deflate; server_no_context_takeover; server_max_window_bits=15; client_max_window_bits=15"));
+    EXPECT_FALSE(
+        WsCompression::canShareFrames("permessage-deflate; server_no_context_takeover; server_max_window_bits=9"));
+    EXPECT_FALSE(WsCompression::canShareFrames("permessage-deflate"));
+    EXPECT_FALSE(WsCompression::canShareFrames(""));
+}
+
+TEST_F(WsCompressionTest, MakeFrameSmall)
+{
+    std::string const message = R"({"type":"transaction","validated":true})";
+    auto const frame = WsCompression::makeFrame(message);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(static_cast<unsigned char>((*frame)[0]), 0xc1);
+    EXPECT_EQ(static_cast<std::size_t>((*frame)[1]), frame->size() - 2);
+    EXPECT_EQ(inflatePayload(*frame), message);
+}
+
+TEST_F(WsCompressionTest, MakeFrameLarge)
+{
+    std::string message;
+    for (auto i = 0; i < 20000; ++i)
+        message += std::to_string(i * 7919 % 10007) + ",";
+
+    auto const frame = WsCompression::makeFrame(message);
+    ASSERT_NE(frame, nullptr);
+    auto const length = static_cast<unsigned char>((*frame)[1]);
+    ASSERT_TRUE(length == 126 || length == 127);
+    EXPECT_EQ(inflatePayload(*frame), message);
+}
+
+TEST_F(WsCompressionTest, FrameBuiltOncePerMessage)
+{
+    WsCompression compression;
+    auto const message = std::make_shared<std::string>(R"({"type":"ledgerClosed"})");
+    auto const other = std::make_shared<std::string>(R"({"type":"ledgerClosed"})");
+
+    auto const frame = compression.frameFor(message);
+    ASSERT_NE(frame, nullptr);
+    EXPECT_EQ(compression.frameFor(message), frame);
+    EXPECT_NE(compression.frameFor(other), frame);
+    EXPECT_EQ(*compression.frameFor(other), *frame);
+}